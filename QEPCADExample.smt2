@@ -0,0 +1,5 @@
+(set-logic QF_NRA)
+(declare-fun y () Real)
+(declare-fun x () Real)
+(assert (and (< (+ (* x x) (* y y) (- 4)) 0) (< (+ (* (- 1) (*  y x)) 1) 0) (<= (+ (* x x) y (- 3)) 0)))
+(check-sat)
@@ -1,21 +1,48 @@
-ExternalProject_Add(
-	google-benchmark-EP
-	GIT_REPOSITORY https://github.com/google/benchmark.git
-	GIT_TAG "v${GBENCHMARK_VERSION}"
-	CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR> -DCMAKE_BUILD_TYPE=RELEASE -DBENCHMARK_DOWNLOAD_DEPENDENCIES=ON
-	UPDATE_COMMAND ""
-)
-set_target_properties(google-benchmark-EP PROPERTIES EXCLUDE_FROM_ALL TRUE)
+if(NOT FORCE_SHIPPED_RESOURCES)
+	find_path(GBENCHMARK_INCLUDE_DIR NAMES benchmark/benchmark.h)
+	find_library(GBENCHMARK_LIB NAMES benchmark)
+	find_library(GBENCHMARK_MAIN_LIB NAMES benchmark_main)
+endif()
 
-ExternalProject_Get_Property(google-benchmark-EP install_dir)
+set(GBenchmark_FOUND_SYSTEM FALSE)
+if(GBENCHMARK_INCLUDE_DIR AND GBENCHMARK_LIB AND GBENCHMARK_MAIN_LIB)
+	set(GBenchmark_FOUND_SYSTEM TRUE)
+endif()
 
-add_imported_library(GBCORE STATIC "${install_dir}/lib/${CMAKE_FIND_LIBRARY_PREFIXES}benchmark${STATIC_EXT}" "${install_dir}/include")
-add_imported_library(GBMAIN STATIC "${install_dir}/lib/${CMAKE_FIND_LIBRARY_PREFIXES}benchmark_main${STATIC_EXT}" "${install_dir}/include")
+if(GBenchmark_FOUND_SYSTEM)
+	add_library(GBCORE_STATIC STATIC IMPORTED GLOBAL)
+	set_target_properties(GBCORE_STATIC PROPERTIES
+		IMPORTED_LOCATION "${GBENCHMARK_LIB}"
+		INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}"
+	)
+	add_library(GBMAIN_STATIC STATIC IMPORTED GLOBAL)
+	set_target_properties(GBMAIN_STATIC PROPERTIES
+		IMPORTED_LOCATION "${GBENCHMARK_MAIN_LIB}"
+		INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}"
+	)
+	find_package(Threads QUIET)
+	if(TARGET Threads::Threads)
+		set_target_properties(GBCORE_STATIC PROPERTIES INTERFACE_LINK_LIBRARIES Threads::Threads)
+	endif()
+else()
+	ExternalProject_Add(
+		google-benchmark-EP
+		GIT_REPOSITORY https://github.com/google/benchmark.git
+		GIT_TAG "v${GBENCHMARK_VERSION}"
+		CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR> -DCMAKE_BUILD_TYPE=RELEASE -DBENCHMARK_DOWNLOAD_DEPENDENCIES=ON
+		UPDATE_COMMAND ""
+	)
+	set_target_properties(google-benchmark-EP PROPERTIES EXCLUDE_FROM_ALL TRUE)
 
+	ExternalProject_Get_Property(google-benchmark-EP install_dir)
 
-add_dependencies(GBCORE_STATIC google-benchmark-EP)
-add_dependencies(GBMAIN_STATIC google-benchmark-EP)
+	add_imported_library(GBCORE STATIC "${install_dir}/lib/${CMAKE_FIND_LIBRARY_PREFIXES}benchmark${STATIC_EXT}" "${install_dir}/include")
+	add_imported_library(GBMAIN STATIC "${install_dir}/lib/${CMAKE_FIND_LIBRARY_PREFIXES}benchmark_main${STATIC_EXT}" "${install_dir}/include")
+
+	add_dependencies(GBCORE_STATIC google-benchmark-EP)
+	add_dependencies(GBMAIN_STATIC google-benchmark-EP)
+endif()
 
 set(GBENCHMARK_FOUND TRUE)
 
-mark_as_advanced(GBENCHMARK_FOUND GBCORE_STATIC GBMAIN_STATIC)
\ No newline at end of file
+mark_as_advanced(GBENCHMARK_FOUND GBENCHMARK_INCLUDE_DIR GBENCHMARK_LIB GBENCHMARK_MAIN_LIB GBCORE_STATIC GBMAIN_STATIC)
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Common.h"
+#include "Variable.h"
+
+#include <atomic>
+#include <cassert>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace carl {
+
+/**
+ * An assignment from variables to values that is stored as a vector indexed by the variable id.
+ *
+ * As the VariablePool hands out consecutive ids for every variable type, lookups are a single index computation instead of a tree traversal as for carl::Assignment.
+ * Every modification increases the version of the assignment and every entry remembers the version it was modified at.
+ * This allows consumers that mirror an assignment (like the libpoly backend) to only process the variables that changed since they last synchronized.
+ * To tell different assignments apart, every object carries a unique identifier that is renewed whenever the whole assignment is replaced.
+ */
+template<typename T>
+class DenseAssignment {
+public:
+	/// An entry of the assignment. An unassigned entry keeps its variable to report its removal.
+	struct Entry {
+		Variable var;
+		std::optional<T> value;
+		std::size_t version = 0;
+	};
+private:
+	std::vector<Entry> mEntries;
+	std::size_t mSize = 0;
+	std::size_t mVersion = 0;
+	std::size_t mUID;
+
+	static std::size_t next_uid() {
+		static std::atomic<std::size_t> uid = 1;
+		return uid++;
+	}
+	static std::size_t index(Variable v) {
+		return v.dense_index();
+	}
+	const Entry* entry(Variable v) const {
+		std::size_t i = index(v);
+		if (i >= mEntries.size() || !mEntries[i].value) return nullptr;
+		return &mEntries[i];
+	}
+public:
+	DenseAssignment(): mUID(next_uid()) {}
+	explicit DenseAssignment(const Assignment<T>& a): mUID(next_uid()) {
+		for (const auto& [var, value]: a) {
+			assign(var, value);
+		}
+	}
+	DenseAssignment(const DenseAssignment& a): mEntries(a.mEntries), mSize(a.mSize), mVersion(a.mVersion), mUID(next_uid()) {}
+	DenseAssignment(DenseAssignment&& a) noexcept: mEntries(std::move(a.mEntries)), mSize(a.mSize), mVersion(a.mVersion), mUID(next_uid()) {
+		a.clear();
+	}
+	DenseAssignment& operator=(const DenseAssignment& a) {
+		mEntries = a.mEntries;
+		mSize = a.mSize;
+		mVersion = a.mVersion;
+		mUID = next_uid();
+		return *this;
+	}
+	DenseAssignment& operator=(DenseAssignment&& a) noexcept {
+		mEntries = std::move(a.mEntries);
+		mSize = a.mSize;
+		mVersion = a.mVersion;
+		mUID = next_uid();
+		a.clear();
+		return *this;
+	}
+
+	/// Unique identifier of this assignment. Changes whenever the assignment is replaced as a whole.
+	std::size_t uid() const {
+		return mUID;
+	}
+	/// Current version, increased by every modification.
+	std::size_t version() const {
+		return mVersion;
+	}
+	std::size_t size() const {
+		return mSize;
+	}
+	bool empty() const {
+		return mSize == 0;
+	}
+
+	bool contains(Variable v) const {
+		return entry(v) != nullptr;
+	}
+	/**
+	 * Returns a pointer to the value of the given variable or nullptr if the variable is unassigned.
+	 */
+	const T* get(Variable v) const {
+		const Entry* e = entry(v);
+		return e == nullptr ? nullptr : &*e->value;
+	}
+	const T& at(Variable v) const {
+		const T* res = get(v);
+		if (res == nullptr) throw std::out_of_range("DenseAssignment::at");
+		return *res;
+	}
+
+	/**
+	 * Assigns the given value to the given variable.
+	 */
+	void assign(Variable v, const T& value) {
+		std::size_t i = index(v);
+		if (i >= mEntries.size()) mEntries.resize(i + 1);
+		Entry& e = mEntries[i];
+		if (!e.value) ++mSize;
+		e.var = v;
+		e.value = value;
+		e.version = ++mVersion;
+	}
+	/**
+	 * Removes the assignment of the given variable.
+	 * @return true if the variable was assigned.
+	 */
+	bool erase(Variable v) {
+		std::size_t i = index(v);
+		if (i >= mEntries.size() || !mEntries[i].value) return false;
+		mEntries[i].value = std::nullopt;
+		mEntries[i].version = ++mVersion;
+		--mSize;
+		return true;
+	}
+	/**
+	 * Removes all assignments.
+	 * As this replaces the assignment as a whole, it also renews the identifier.
+	 */
+	void clear() {
+		mEntries.clear();
+		mSize = 0;
+		mVersion = 0;
+		mUID = next_uid();
+	}
+
+	/**
+	 * Calls f(var, value) for every assigned variable in the order of the variable ids.
+	 */
+	template<typename F>
+	void for_each(F&& f) const {
+		for (const auto& e: mEntries) {
+			if (e.value) f(e.var, *e.value);
+		}
+	}
+	/**
+	 * Calls f(var, value) for every variable that was modified after the given version.
+	 * value is a pointer to the new value or nullptr if the variable was unassigned.
+	 */
+	template<typename F>
+	void for_each_changed_since(std::size_t version, F&& f) const {
+		if (version >= mVersion) return;
+		for (const auto& e: mEntries) {
+			if (e.version > version) f(e.var, e.value ? &*e.value : nullptr);
+		}
+	}
+
+	/**
+	 * Converts to an ordinary Assignment.
+	 */
+	Assignment<T> to_map() const {
+		Assignment<T> res;
+		for_each([&res](Variable v, const T& value) { res.emplace_hint(res.end(), v, value); });
+		return res;
+	}
+};
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const DenseAssignment<T>& a) {
+	os << "{";
+	bool first = true;
+	a.for_each([&](Variable v, const T& value) {
+		if (!first) os << ", ";
+		first = false;
+		os << v << " : " << value;
+	});
+	return os << "}";
+}
+
+}
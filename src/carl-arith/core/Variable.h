@@ -132,6 +132,15 @@ public:
 		return static_cast<VariableType>(mContent % (static_cast<std::size_t>(1) << RESERVED_FOR_TYPE));
 	}
 
+	/**
+	 * Retrieves an index of the variable that is unique among all variable types, of the form `id * TYPE_SIZE + type`.
+	 * Unlike the content, it does not depend on the rank. As the ids are consecutive for every type, the index is suitable to index vectors.
+	 * @return Variable index.
+	 */
+	constexpr std::size_t dense_index() const noexcept {
+		return id() * static_cast<std::size_t>(VariableType::TYPE_SIZE) + static_cast<std::size_t>(type());
+	}
+
 	/**
 	 * Retrieves the name of the variable.
 	 * @return Variable name.
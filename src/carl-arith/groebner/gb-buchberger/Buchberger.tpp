@@ -9,6 +9,7 @@
 #include "Buchberger.h"
 
 #include <carl-arith/poly/umvpoly/functions/SPolynomial.h>
+#include <carl-statistics/carl-profiling.h>
 //
 //
 namespace carl
@@ -21,6 +22,7 @@ template<class Polynomial, template<typename> class AddingPolicy>
 void Buchberger<Polynomial, AddingPolicy>::calculate(const std::list<Polynomial>& scheduledForAdding)
 {
 	CARL_LOG_INFO("carl.gb.buchberger", "Calculate gb");
+	CARL_PROFILE_ZONE("groebner.buchberger");
 	for(unsigned i = 0; i < pGb->getGenerators().size(); ++i)
 	{
 		mGbElementsIndices.push_back(i);
@@ -54,10 +56,14 @@ void Buchberger<Polynomial, AddingPolicy>::calculate(const std::list<Polynomial>
 			Polynomial spol = carl::SPolynomial(pGb->getGenerators()[critPair.mP1], pGb->getGenerators()[critPair.mP2]);
 			spol.setReasons(pGb->getGenerators()[critPair.mP1].getReasons() | pGb->getGenerators()[critPair.mP2].getReasons());
 			CARL_LOG_DEBUG("carl.gb.buchberger", "SPol: " << spol);
-			// Schedules the S-polynomial for reduction
-			Reductor<Polynomial, Polynomial> reductor(*pGb, spol);
-			// Does a full reduction on this
-			Polynomial remainder = reductor.fullReduce();
+			Polynomial remainder;
+			{
+				CARL_PROFILE_ZONE("groebner.reduce");
+				// Schedules the S-polynomial for reduction
+				Reductor<Polynomial, Polynomial> reductor(*pGb, spol);
+				// Does a full reduction on this
+				remainder = reductor.fullReduce();
+			}
 			CARL_LOG_DEBUG("carl.gb.buchberger", "Remainder of SPol: " << remainder);
 			// If it is not zero, we should add this one to our GB
 			if(!is_zero(remainder))
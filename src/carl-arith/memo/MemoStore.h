@@ -0,0 +1,243 @@
+/**
+ * @file
+ *
+ * A persistent store for the results of expensive operations, see MemoStore.
+ *
+ * The store is an append-only file that starts with the seven magic bytes `CARLMEM` followed by a byte holding the format version.
+ * Afterwards, it consists of a sequence of records: the operation (byte), the length of the key (varint), the key,
+ * the length of the value (varint) and the value. Keys and values are opaque to the store, see Memoization.h.
+ */
+
+#pragma once
+
+#include <carl-common/memory/Singleton.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace carl::memo {
+
+constexpr char header[] = "CARLMEM";
+constexpr std::uint8_t version = 1;
+
+/**
+ * The operations whose results are stored.
+ */
+enum class Operation : std::uint8_t {
+	Factorization = 1, ///< The factorization of a multivariate polynomial.
+	IrreducibleFactors = 2, ///< The irreducible factors of a multivariate polynomial.
+	GCD = 3, ///< The gcd of two multivariate polynomials.
+};
+
+/**
+ * Stores the results of expensive operations in a file, such that later runs can reuse them.
+ *
+ * The store is inactive until open() is called. Afterwards, carl::factorization(), carl::irreducible_factors() and
+ * carl::gcd() consult the store before computing and append their results to it.
+ * All records are indexed in memory by the hash of their key, the keys and values stay in the file.
+ * Only a single process should append to a file at a time.
+ */
+class MemoStore : public carl::Singleton<MemoStore> {
+	friend carl::Singleton<MemoStore>;
+
+	std::mutex mMutex;
+	std::fstream mFile;
+	std::atomic<bool> mActive = false;
+	/// Maps the hash of operation and key to the offsets of the records.
+	std::unordered_multimap<std::uint64_t, std::uint64_t> mIndex;
+	/// The end of the valid records in the file.
+	std::uint64_t mEnd = 0;
+	std::atomic<std::size_t> mHits = 0;
+	std::atomic<std::size_t> mMisses = 0;
+
+	MemoStore() = default;
+
+	static std::uint64_t hash(Operation op, const std::string& key) {
+		// FNV-1a
+		std::uint64_t res = 0xcbf29ce484222325ull;
+		auto add = [&res](unsigned char c) {
+			res ^= c;
+			res *= 0x100000001b3ull;
+		};
+		add(static_cast<unsigned char>(op));
+		for (char c: key) add(static_cast<unsigned char>(c));
+		return res;
+	}
+	static void varint(std::string& buffer, std::uint64_t n) {
+		while (n >= 0x80) {
+			buffer.push_back(static_cast<char>((n & 0x7f) | 0x80));
+			n >>= 7;
+		}
+		buffer.push_back(static_cast<char>(n));
+	}
+	/// Reads a varint from the file, returns std::nullopt at the end of the file.
+	std::optional<std::uint64_t> varint() {
+		std::uint64_t res = 0;
+		for (std::size_t shift = 0; shift < 64; shift += 7) {
+			int b = mFile.get();
+			if (b == std::char_traits<char>::eof()) return std::nullopt;
+			res |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+			if ((b & 0x80) == 0) return res;
+		}
+		return std::nullopt;
+	}
+	/// Reads a length prefixed string from the file that ends before limit, returns std::nullopt otherwise.
+	std::optional<std::string> bytes(std::uint64_t limit) {
+		auto size = varint();
+		if (!size) return std::nullopt;
+		// A corrupt size must not be allocated.
+		auto pos = mFile.tellg();
+		if (pos < 0 || static_cast<std::uint64_t>(pos) > limit || *size > limit - static_cast<std::uint64_t>(pos)) return std::nullopt;
+		std::string res(*size, '\0');
+		if (!mFile.read(res.data(), static_cast<std::streamsize>(*size))) return std::nullopt;
+		return res;
+	}
+	/// Reads the record at the current position that ends before limit, returns std::nullopt if it is incomplete.
+	std::optional<std::tuple<Operation, std::string, std::string>> record(std::uint64_t limit) {
+		int op = mFile.get();
+		if (op == std::char_traits<char>::eof()) return std::nullopt;
+		auto key = bytes(limit);
+		if (!key) return std::nullopt;
+		auto value = bytes(limit);
+		if (!value) return std::nullopt;
+		return std::make_tuple(static_cast<Operation>(op), std::move(*key), std::move(*value));
+	}
+public:
+	~MemoStore() override {
+		close();
+	}
+
+	/**
+	 * Opens the given file, creating it if it does not exist, and indexes all records.
+	 * An incomplete record at the end of the file, e.g. from a process that was killed, is discarded.
+	 * A store that is currently open is closed.
+	 * @return false if the file can not be opened or is not a store. Such a file is left untouched.
+	 */
+	bool open(const std::string& filename) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mActive = false;
+		if (mFile.is_open()) mFile.close();
+		mIndex.clear();
+		std::error_code ec;
+		if (!std::filesystem::exists(filename, ec)) {
+			mFile.open(filename, std::ios::out | std::ios::binary);
+			mFile.close();
+		}
+		mFile.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+		if (!mFile.is_open()) return false;
+		std::uint64_t fileSize = std::filesystem::file_size(filename, ec);
+		if (ec) {
+			mFile.close();
+			return false;
+		}
+		std::string head(sizeof(header), '\0');
+		if (!mFile.read(head.data(), static_cast<std::streamsize>(head.size()))) {
+			// An empty file, or one with an incomplete header, is initialized. Any other file is not a store.
+			head.resize(static_cast<std::size_t>(mFile.gcount()));
+			std::string expected(header, sizeof(header) - 1);
+			expected.push_back(static_cast<char>(version));
+			if (expected.compare(0, head.size(), head) != 0) {
+				mFile.close();
+				return false;
+			}
+			mFile.clear();
+			mFile.seekp(0);
+			mFile.write(header, sizeof(header) - 1);
+			mFile.put(static_cast<char>(version));
+			mFile.flush();
+			mEnd = sizeof(header);
+		} else {
+			if (head.compare(0, sizeof(header) - 1, header) != 0 || static_cast<std::uint8_t>(head.back()) != version) {
+				mFile.close();
+				return false;
+			}
+			mEnd = sizeof(header);
+			while (auto r = record(fileSize)) {
+				mIndex.emplace(hash(std::get<0>(*r), std::get<1>(*r)), mEnd);
+				mEnd = static_cast<std::uint64_t>(mFile.tellg());
+			}
+			mFile.clear();
+			if (mEnd < fileSize) {
+				mFile.close();
+				std::filesystem::resize_file(filename, mEnd);
+				mFile.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+				if (!mFile.is_open()) return false;
+			}
+		}
+		mActive = true;
+		return true;
+	}
+	/// Closes the file, the store is inactive afterwards.
+	void close() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mActive = false;
+		if (mFile.is_open()) mFile.close();
+		mIndex.clear();
+	}
+	bool active() const {
+		return mActive.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Looks up the value stored for the given key.
+	 */
+	std::optional<std::string> lookup(Operation op, const std::string& key) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mActive) return std::nullopt;
+		auto range = mIndex.equal_range(hash(op, key));
+		for (auto it = range.first; it != range.second; ++it) {
+			mFile.clear();
+			mFile.seekg(static_cast<std::streamoff>(it->second));
+			auto r = record(mEnd);
+			if (r && std::get<0>(*r) == op && std::get<1>(*r) == key) {
+				++mHits;
+				return std::move(std::get<2>(*r));
+			}
+		}
+		++mMisses;
+		return std::nullopt;
+	}
+	/**
+	 * Appends a value for the given key. The record is written with a single write and flushed.
+	 */
+	void store(Operation op, const std::string& key, const std::string& value) {
+		std::string buffer;
+		buffer.reserve(key.size() + value.size() + 20);
+		buffer.push_back(static_cast<char>(op));
+		varint(buffer, key.size());
+		buffer.append(key);
+		varint(buffer, value.size());
+		buffer.append(value);
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mActive) return;
+		mFile.clear();
+		mFile.seekp(static_cast<std::streamoff>(mEnd));
+		mFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		mFile.flush();
+		if (!mFile) return;
+		mIndex.emplace(hash(op, key), mEnd);
+		mEnd += buffer.size();
+	}
+
+	/// Number of records in the store.
+	std::size_t size() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mIndex.size();
+	}
+	/// Number of successful lookups.
+	std::size_t hits() const {
+		return mHits;
+	}
+	/// Number of failed lookups.
+	std::size_t misses() const {
+		return mMisses;
+	}
+};
+
+}
@@ -0,0 +1,224 @@
+/**
+ * @file
+ *
+ * Canonical encoding of polynomial operations for the MemoStore.
+ *
+ * Variables are identified by their name and type, as their ids differ between runs.
+ * A key starts with the variables of all operands, sorted by name, and their rank in the variable ordering of the current run,
+ * as results are normalized with respect to this ordering. It is followed by a flag byte and the operands.
+ * Polynomials are encoded by their terms in a canonical order, variables are referenced by their position in the key.
+ * Numbers and varints are written by the trace::Encoder.
+ */
+
+#pragma once
+
+#include "MemoStore.h"
+
+#include <carl-arith/core/Common.h>
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/poly/umvpoly/MonomialPool.h>
+#include <carl-arith/trace/Trace.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace carl::memo {
+
+/**
+ * Encodes operands and results of operations on polynomials of type Pol relative to the variables of the operands.
+ */
+template<typename Pol>
+class Codec {
+	using C = typename Pol::CoeffType;
+
+	/// The variables of the operands, sorted by name.
+	std::vector<Variable> mVariables;
+	bool mValid = true;
+
+	std::size_t index(Variable v) const {
+		auto it = std::lower_bound(mVariables.begin(), mVariables.end(), v, [](Variable a, Variable b) { return a.name() < b.name(); });
+		if (it == mVariables.end() || *it != v) return mVariables.size();
+		return static_cast<std::size_t>(it - mVariables.begin());
+	}
+public:
+	template<typename... Polys>
+	explicit Codec(const Polys&... polys) {
+		carlVariables vars;
+		(variables(polys, vars), ...);
+		mVariables = vars.as_vector();
+		std::sort(mVariables.begin(), mVariables.end(), [](Variable a, Variable b) { return a.name() < b.name(); });
+		for (std::size_t i = 1; i < mVariables.size(); ++i) {
+			// Variables with equal names can not be told apart in another run.
+			if (mVariables[i - 1].name() == mVariables[i].name()) mValid = false;
+		}
+	}
+
+	/// Whether the operands can be encoded.
+	bool valid() const {
+		return mValid;
+	}
+
+	/**
+	 * Encodes the given polynomial. Its terms are sorted by their encoding.
+	 * @return false if the polynomial contains a variable that does not occur in the operands.
+	 */
+	bool write(std::string& buffer, const Pol& p) const {
+		std::vector<std::string> terms;
+		terms.reserve(p.nr_terms());
+		std::vector<Variable> unused;
+		for (const auto& term: p) {
+			std::string t;
+			trace::Encoder e(t, unused);
+			std::vector<std::pair<std::size_t, exponent>> monomial;
+			if (term.monomial() != nullptr) {
+				for (const auto& [var, exp]: *term.monomial()) {
+					std::size_t id = index(var);
+					if (id == mVariables.size()) return false;
+					monomial.emplace_back(id, exp);
+				}
+			}
+			std::sort(monomial.begin(), monomial.end());
+			e.varint(monomial.size());
+			for (const auto& [id, exp]: monomial) {
+				e.varint(id);
+				e.varint(exp);
+			}
+			e.write(mpq_class(term.coeff()));
+			terms.emplace_back(std::move(t));
+		}
+		std::sort(terms.begin(), terms.end());
+		trace::Encoder e(buffer, unused);
+		e.varint(terms.size());
+		for (const auto& t: terms) buffer.append(t);
+		return true;
+	}
+	bool write(std::string& buffer, const std::vector<Pol>& polys) const {
+		std::vector<Variable> unused;
+		trace::Encoder(buffer, unused).varint(polys.size());
+		return std::all_of(polys.begin(), polys.end(), [&](const Pol& p) { return write(buffer, p); });
+	}
+	bool write(std::string& buffer, const Factors<Pol>& factors) const {
+		std::vector<Variable> unused;
+		trace::Encoder e(buffer, unused);
+		e.varint(factors.size());
+		for (const auto& [p, exp]: factors) {
+			if (!write(buffer, p)) return false;
+			e.varint(exp);
+		}
+		return true;
+	}
+
+	/**
+	 * The key of an operation on the given operands.
+	 */
+	template<typename... Polys>
+	std::string key(std::uint8_t flags, const Polys&... polys) const {
+		std::string res;
+		std::vector<Variable> unused;
+		trace::Encoder e(res, unused);
+		e.varint(mVariables.size());
+		for (Variable v: mVariables) {
+			e.bytes(v.name());
+			res.push_back(static_cast<char>(v.type()));
+		}
+		for (Variable v: mVariables) {
+			e.varint(static_cast<std::size_t>(std::count_if(mVariables.begin(), mVariables.end(), [v](Variable w) { return w < v; })));
+		}
+		res.push_back(static_cast<char>(flags));
+		(write(res, polys), ...);
+		return res;
+	}
+
+	/// Reads a polynomial as written by write().
+	void read(trace::Decoder& d, Pol& res) const {
+		typename Pol::TermsType terms;
+		std::size_t count = d.varint();
+		for (std::size_t i = 0; i < count; ++i) {
+			std::vector<std::pair<Variable, exponent>> monomial;
+			std::size_t size = d.varint();
+			for (std::size_t j = 0; j < size; ++j) {
+				std::size_t id = d.varint();
+				if (id >= mVariables.size()) throw std::runtime_error("Invalid variable in memo store");
+				monomial.emplace_back(mVariables[id], static_cast<exponent>(d.varint()));
+			}
+			std::sort(monomial.begin(), monomial.end());
+			mpq_class coeff = d.rational();
+			C c;
+			if constexpr (std::is_same_v<C, mpz_class>) c = coeff.get_num();
+			else c = coeff;
+			if (monomial.empty()) terms.emplace_back(c);
+			else terms.emplace_back(c, createMonomial(std::move(monomial)));
+		}
+		res = Pol(std::move(terms));
+	}
+	void read(trace::Decoder& d, std::vector<Pol>& res) const {
+		res.resize(d.varint());
+		for (auto& p: res) read(d, p);
+	}
+	void read(trace::Decoder& d, Factors<Pol>& res) const {
+		std::size_t count = d.varint();
+		for (std::size_t i = 0; i < count; ++i) {
+			Pol p;
+			read(d, p);
+			res.emplace(std::move(p), static_cast<uint>(d.varint()));
+		}
+	}
+};
+
+namespace detail {
+	/// Counts the memoized operations that are currently running on this thread.
+	class Nesting {
+		static std::size_t& depth() {
+			thread_local std::size_t d = 0;
+			return d;
+		}
+	public:
+		Nesting() { ++depth(); }
+		~Nesting() { --depth(); }
+		Nesting(const Nesting&) = delete;
+		Nesting& operator=(const Nesting&) = delete;
+		/// Whether this is the outermost memoized operation.
+		bool outermost() const { return depth() == 1; }
+	};
+}
+
+/**
+ * Returns the result of the given operation from the MemoStore or computes and stores it.
+ * The store is only consulted if it is active and the coefficients of the operands are GMP numbers.
+ * Operations that are called from within another memoized operation are part of the outer one and not stored.
+ * @param op The operation.
+ * @param flags Additional parameters of the operation that are part of the key.
+ * @param compute Computes the result.
+ * @param polys The operands.
+ */
+template<typename Result, typename Compute, typename Pol, typename... Polys>
+Result memoized(Operation op, std::uint8_t flags, Compute&& compute, const Pol& p, const Polys&... polys) {
+	if constexpr (trace::is_traceable<Pol>::value) {
+		detail::Nesting nesting;
+		MemoStore& store = MemoStore::getInstance();
+		if (!nesting.outermost() || !store.active()) return compute();
+		Codec<Pol> codec(p, polys...);
+		if (!codec.valid()) return compute();
+		std::string key = codec.key(flags, p, polys...);
+		if (auto value = store.lookup(op, key)) {
+			try {
+				std::map<std::size_t, Variable> noVariables;
+				trace::Decoder d(value->data(), value->data() + value->size(), noVariables);
+				Result res;
+				codec.read(d, res);
+				if (d.empty()) return res;
+			} catch (const std::runtime_error&) {
+			}
+		}
+		Result res = compute();
+		std::string value;
+		if (codec.write(value, res)) store.store(op, key, value);
+		return res;
+	} else {
+		return compute();
+	}
+}
+
+}
@@ -18,6 +18,11 @@
 
 namespace carl {
 
+/**
+ * Wraps a libpoly polynomial context with a variable ordering.
+ * The libpoly context keeps reference counts and temporary variables that are modified by the polynomials using it,
+ * hence concurrent computations should use separate contexts.
+ */
 class LPContext {
     struct Data {
         std::vector<Variable> variable_order;
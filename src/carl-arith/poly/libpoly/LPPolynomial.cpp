@@ -1,9 +1,9 @@
+#include <carl-common/config.h>
+#ifdef USE_LIBPOLY
 #include "LPPolynomial.h"
 #include "helper.h"
 #include <poly/variable_list.h>
 
-#include <carl-common/config.h>
-#ifdef USE_LIBPOLY
 
 namespace carl {
 
@@ -563,7 +563,7 @@ bool LPPolynomial::is_normal() const {
 }
 
 std::ostream& operator<<(std::ostream& os, const LPPolynomial& p) {
-    os << lp_polynomial_to_string(p.get_internal());
+    os << LPVariables::getInstance().to_string(p.get_internal());
     return os;
 }
 
@@ -22,6 +22,7 @@ LPVariables::~LPVariables() {
 
 
 std::optional<carl::Variable> LPVariables::carl_variable(lp_variable_t var) const {
+    LPVARIABLES_READ_LOCK
     auto it = vars_libpoly_carl.find(var);
     if(it == vars_libpoly_carl.end()) return std::nullopt;
     CARL_LOG_TRACE("carl.poly", "Mapping libpoly variable " << lp_variable_db_get_name(lp_var_db, var) << " (" << var << ") -> " << it->second << " (" << it->second.id() << ")");
@@ -29,6 +30,7 @@ std::optional<carl::Variable> LPVariables::carl_variable(lp_variable_t var) cons
 }
 
 std::optional<lp_variable_t> LPVariables::lp_variable_opt(carl::Variable var) const {    
+    LPVARIABLES_READ_LOCK
     auto it = vars_carl_libpoly.find(var);
     if(it == vars_carl_libpoly.end()) return std::nullopt;
     CARL_LOG_TRACE("carl.poly", "Mapping carl variable " << var << " (" << var.id() << ") -> " << lp_variable_db_get_name(lp_var_db, it->second) << " (" << it->second << ")");
@@ -36,11 +38,13 @@ std::optional<lp_variable_t> LPVariables::lp_variable_opt(carl::Variable var) co
 }
 
 lp_variable_t LPVariables::lp_variable(carl::Variable var) {
-    auto it = vars_carl_libpoly.find(var);
-    if(it != vars_carl_libpoly.end()) {
-        CARL_LOG_TRACE("carl.poly", "Mapping carl variable " << var << " (" << var.id() << ") -> " << lp_variable_db_get_name(lp_var_db, it->second) << " (" << it->second << ")");
-        return it->second;
+    if (auto res = lp_variable_opt(var); res) {
+        return *res;
     } else {
+        LPVARIABLES_WRITE_LOCK
+        // another thread may have created the variable in the meantime
+        auto it = vars_carl_libpoly.find(var);
+        if (it != vars_carl_libpoly.end()) return it->second;
         std::string var_name = var.name();
         lp_variable_t poly_var = lp_variable_db_new_variable(lp_var_db, &var_name[0]);
         vars_carl_libpoly.emplace(var, poly_var);
@@ -49,6 +53,48 @@ lp_variable_t LPVariables::lp_variable(carl::Variable var) {
         return poly_var;
     }
 }
+
+void LPVariables::construct_assignment(lp_assignment_t* assignment) {
+    LPVARIABLES_WRITE_LOCK
+    lp_assignment_construct(assignment, lp_var_db);
+}
+
+void LPVariables::destruct_assignment(lp_assignment_t* assignment) {
+    LPVARIABLES_WRITE_LOCK
+    lp_assignment_destruct(assignment);
+}
+
+lp_polynomial_context_t* LPVariables::new_context(lp_variable_order_t* var_order) {
+    LPVARIABLES_WRITE_LOCK
+    // lp_context = lp_polynomial_context_new(0, lp_var_db, var_order);
+    lp_polynomial_context_t* lp_context = (lp_polynomial_context_t*) malloc(sizeof(lp_polynomial_context_t));
+    //lp_polynomial_context_construct(lp_context, 0, lp_var_db, var_order);
+    lp_context->ref_count = 0;
+    lp_context->var_db = lp_var_db;
+    lp_context->K = 0;
+    lp_context->var_order = var_order;
+    lp_context->var_tmp = (lp_variable_t*)malloc(sizeof(lp_variable_t)*TEMP_VARIABLE_SIZE);
+    for (size_t i = 0; i < TEMP_VARIABLE_SIZE; ++ i) {
+        lp_context->var_tmp[i] = lp_var_tmp[i];
+    }
+    lp_context->var_tmp_size = 0;
+    lp_polynomial_context_attach(lp_context);
+    return lp_context;
+}
+
+void LPVariables::release_context(lp_polynomial_context_t* context, lp_variable_order_t* var_order) {
+    LPVARIABLES_WRITE_LOCK
+    lp_variable_order_detach(var_order);
+    lp_polynomial_context_detach(context);
+}
+
+std::string LPVariables::to_string(const lp_polynomial_t* p) const {
+    LPVARIABLES_READ_LOCK
+    char* str = lp_polynomial_to_string(p);
+    std::string res(str);
+    free(str);
+    return res;
+}
     
 } // namespace carl
 
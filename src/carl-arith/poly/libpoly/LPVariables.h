@@ -6,13 +6,26 @@
 #include <carl-common/memory/Singleton.h>
 #include <map>
 #include <optional>
+#include <string>
+#ifdef THREAD_SAFE
+#include <mutex>
+#include <shared_mutex>
+#endif
 #include "../../core/Variable.h"
 #include <poly/poly.h>
 #include <poly/variable_db.h>
 #include <poly/polynomial_context.h>
+#include <poly/assignment.h>
 
 namespace carl {
 
+/**
+ * Maps carl variables to libpoly variables and owns the libpoly variable database.
+ * If THREAD_SAFE is set, the mapping may be used from several threads: lookups and everything that reads
+ * variable names from the variable database (like printing polynomials) take a shared lock,
+ * creating a new libpoly variable and everything that attaches to or detaches from the variable database
+ * (assignments and polynomial contexts) take an exclusive lock.
+ */
 class LPVariables : public Singleton<LPVariables> {
     friend Singleton<LPVariables>;
 
@@ -21,6 +34,15 @@ class LPVariables : public Singleton<LPVariables> {
     // mapping from libpoly variables to carl variables
     std::map<lp_variable_t, carl::Variable> vars_libpoly_carl;
 
+#ifdef THREAD_SAFE
+    mutable std::shared_mutex mMutex;
+    #define LPVARIABLES_READ_LOCK std::shared_lock<std::shared_mutex> lock(mMutex);
+    #define LPVARIABLES_WRITE_LOCK std::unique_lock<std::shared_mutex> lock(mMutex);
+#else
+    #define LPVARIABLES_READ_LOCK
+    #define LPVARIABLES_WRITE_LOCK
+#endif
+
 public:
     lp_variable_db_t* lp_var_db;
 
@@ -33,6 +55,32 @@ public:
     std::optional<carl::Variable> carl_variable(lp_variable_t var) const;
     std::optional<lp_variable_t> lp_variable_opt(carl::Variable var) const;
     lp_variable_t lp_variable(carl::Variable var);
+
+    /**
+     * Constructs the given libpoly assignment on the variable database.
+     * This attaches to the variable database and hence needs to be synchronized.
+     */
+    void construct_assignment(lp_assignment_t* assignment);
+    /**
+     * Destructs the given libpoly assignment, detaching from the variable database.
+     */
+    void destruct_assignment(lp_assignment_t* assignment);
+
+    /**
+     * Creates a libpoly polynomial context on the variable database with the given variable order.
+     * The context uses the temporary variables of the variable database.
+     */
+    lp_polynomial_context_t* new_context(lp_variable_order_t* var_order);
+    /**
+     * Releases the given libpoly polynomial context and variable order, detaching from the variable database.
+     */
+    void release_context(lp_polynomial_context_t* context, lp_variable_order_t* var_order);
+
+    /**
+     * Converts the given libpoly polynomial to a string.
+     * This reads the variable names from the variable database, which may be reallocated when a new variable is created.
+     */
+    std::string to_string(const lp_polynomial_t* p) const;
 };
     
 } // namespace carl
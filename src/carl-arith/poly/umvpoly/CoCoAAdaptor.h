@@ -16,7 +16,10 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iterator>
+#include <list>
 #include <map>
+#include <memory>
+#include <utility>
 
 //#include "CoCoA/library.H"
 #include <CoCoA/BigInt.H>
@@ -48,7 +51,8 @@ namespace cocoawrapper {
 template<typename Poly>
 class CoCoAAdaptor {
 private:
-	std::map<Variable, CoCoA::RingElem> mSymbolThere;
+	/// The variables with their indeterminates, sorted by Variable::dense_index().
+	std::vector<std::pair<Variable, long>> mSymbolThere;
 	std::vector<Variable> mSymbolBack;
 	CoCoA::ring mQ = CoCoA::RingQQ();
 	CoCoA::SparsePolyRing mRing;
@@ -102,38 +106,55 @@ public:
 		return vars;
 	}
 
+	/// The index of the indeterminate of the given variable.
+	std::size_t indet(Variable v) const {
+		auto it = std::lower_bound(mSymbolThere.begin(), mSymbolThere.end(), v.dense_index(),
+			[](const auto& s, std::size_t index){ return s.first.dense_index() < index; }
+		);
+		assert(it != mSymbolThere.end() && it->first.dense_index() == v.dense_index());
+		return static_cast<std::size_t>(it->second);
+	}
+
+	/**
+	 * Converts the terms separately and sums them up pairwise.
+	 * Adding the terms one by one would merge them into a growing polynomial, which is quadratic in the number of terms.
+	 */
 	CoCoA::RingElem convert(const Poly& p) const {
-		CoCoA::RingElem res(mRing);
+		if (carl::is_zero(p)) return CoCoA::RingElem(mRing);
+		std::vector<CoCoA::RingElem> terms;
+		terms.reserve(p.nr_terms());
+		std::vector<long> exponents(mSymbolBack.size());
 		for (const auto& t: p) {
 			if (!t.monomial()) {
-				res += convert(t.coeff());
+				terms.emplace_back(mRing, convert(t.coeff()));
 				continue;
 			}
-			std::vector<long> exponents(mSymbolBack.size());
-			for (const auto& p: *t.monomial()) {
-				auto it = mSymbolThere.find(p.first);
-				assert(it != mSymbolThere.end());
-				long indetIndex;
-				if (CoCoA::IsIndet(indetIndex, it->second)) {
-					exponents[std::size_t(indetIndex)] = long(p.second);
-				} else {
-					assert(false && "The symbol is not an inderminant.");
-				}
+			std::fill(exponents.begin(), exponents.end(), 0);
+			for (const auto& [var, exp]: *t.monomial()) {
+				exponents[indet(var)] = long(exp);
 			}
-			res += CoCoA::monomial(mRing, convert(t.coeff()), exponents);
+			terms.emplace_back(CoCoA::monomial(mRing, convert(t.coeff()), exponents));
 		}
-		return res;
+		for (std::size_t step = 1; step < terms.size(); step *= 2) {
+			for (std::size_t i = 0; i + step < terms.size(); i += 2 * step) {
+				terms[i] += terms[i + step];
+			}
+		}
+		return terms.front();
 	}
 
+	/**
+	 * Collects all terms and constructs the polynomial at once.
+	 */
 	Poly convert(const CoCoA::RingElem& p) const {
-		Poly res;
+		typename Poly::TermsType terms;
+		std::vector<long> exponents;
 		for (CoCoA::SparsePolyIter i = CoCoA::BeginIter(p); !CoCoA::IsEnded(i); ++i) {
 			typename Poly::CoeffType coeff;
 			convert(coeff, CoCoA::coeff(i));
 			if (CoCoA::IsOne(CoCoA::PP(i))) {
-				res += coeff;
+				terms.emplace_back(std::move(coeff));
 			} else {
-				std::vector<long> exponents;
 				CoCoA::exponents(exponents, CoCoA::PP(i));
 				Monomial::Content monContent;
 				std::size_t tdeg = 0;
@@ -143,10 +164,10 @@ public:
 					tdeg += std::size_t(exponents[i]);
 				}
 				std::sort(monContent.begin(), monContent.end(), [](const std::pair<Variable, exponent>& p1, const std::pair<Variable, exponent>& p2){ return p1.first < p2.first; });
-				res += typename Poly::TermType(std::move(coeff), createMonomial(std::move(monContent), tdeg));
+				terms.emplace_back(std::move(coeff), createMonomial(std::move(monContent), tdeg));
 			}
 		}
-		return res;
+		return Poly(std::move(terms), false);
 	}
 
 	std::vector<CoCoA::RingElem> convert(const std::vector<Poly>& p) const {
@@ -187,10 +208,7 @@ public:
 	explicit CoCoAAdaptor(const std::vector<Variable>& vars, bool lex_order = false):
 		mSymbolBack(construct_symbol_back(vars)), mRing(construct_ring(mSymbolBack, lex_order))
 	{
-		auto indets = CoCoA::indets(mRing);
-		for (std::size_t i = 0; i < mSymbolBack.size(); ++i) {
-			mSymbolThere.emplace(mSymbolBack[i], indets[i]);
-		}
+		resetVariableOrdering(mSymbolBack);
 	}
 	CoCoAAdaptor(const std::vector<Poly>& polys):
 		CoCoAAdaptor(variables(polys).as_vector())
@@ -201,14 +219,17 @@ public:
 
 	void resetVariableOrdering(const std::vector<Variable>& ordering) {
 		assert(ordering.size() == mSymbolBack.size());
-		assert(ordering.size() == mSymbolThere.size());
 		mSymbolBack = ordering;
 		std::sort(mSymbolBack.begin(), mSymbolBack.end());
 
-		auto indets = CoCoA::indets(mRing);
+		mSymbolThere.clear();
+		mSymbolThere.reserve(mSymbolBack.size());
 		for (std::size_t i = 0; i < mSymbolBack.size(); ++i) {
-			mSymbolThere[mSymbolBack[i]] = indets[i];
+			mSymbolThere.emplace_back(mSymbolBack[i], long(i));
 		}
+		std::sort(mSymbolThere.begin(), mSymbolThere.end(),
+			[](const auto& a, const auto& b){ return a.first.dense_index() < b.first.dense_index(); }
+		);
 	}
 	
 	Poly gcd(const Poly& p1, const Poly& p2) const {
@@ -282,6 +303,62 @@ public:
 	}
 };
 
+/**
+ * Keeps adaptors, and thereby CoCoA rings, alive between calls.
+ * The adaptors are cached by their variables, the least recently used adaptor is dropped if there are more than max_adaptors.
+ * As CoCoALib is not thread-safe, every thread has its own context.
+ */
+template<typename Poly>
+class CoCoAAdaptorContext {
+	static constexpr std::size_t max_adaptors = 64;
+
+	using Key = std::vector<Variable>;
+	using AdaptorPtr = std::shared_ptr<const CoCoAAdaptor<Poly>>;
+	/// The adaptors, the most recently used one comes first.
+	std::list<std::pair<Key, AdaptorPtr>> mAdaptors;
+	std::map<Key, typename std::list<std::pair<Key, AdaptorPtr>>::iterator> mIndex;
+
+	CoCoAAdaptorContext() = default;
+public:
+	CoCoAAdaptorContext(const CoCoAAdaptorContext&) = delete;
+	CoCoAAdaptorContext& operator=(const CoCoAAdaptorContext&) = delete;
+
+	/// The context of the current thread.
+	static CoCoAAdaptorContext& get() {
+		thread_local CoCoAAdaptorContext context;
+		return context;
+	}
+
+	/**
+	 * Returns an adaptor for the variables of the given polynomials.
+	 * The adaptor stays alive as long as the returned pointer, even if it is dropped from the context by nested calls.
+	 */
+	template<typename... Polys>
+	AdaptorPtr adaptor(const Polys&... polys) {
+		carlVariables vars;
+		(carl::variables(polys, vars), ...);
+		Key key = vars.as_vector();
+		std::sort(key.begin(), key.end());
+		auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			mAdaptors.splice(mAdaptors.begin(), mAdaptors, it->second);
+			return it->second->second;
+		}
+		if (mAdaptors.size() >= max_adaptors) {
+			mIndex.erase(mAdaptors.back().first);
+			mAdaptors.pop_back();
+		}
+		mAdaptors.emplace_front(key, std::make_shared<const CoCoAAdaptor<Poly>>(key));
+		mIndex.emplace(std::move(key), mAdaptors.begin());
+		return mAdaptors.front().second;
+	}
+
+	/// Number of cached adaptors.
+	std::size_t size() const {
+		return mAdaptors.size();
+	}
+};
+
 } // namespace carl
 
 #endif
@@ -24,10 +24,49 @@ Monomial::Arg MonomialPool::add(Monomial::Content&& c, exponent totalDegree) {
 		shared.get()->mWeakPtr = shared;
 		mPool.insert_commit(*shared.get(), insert_data);
 		check_rehash();
+		mMemory.allocated(object_bytes(*shared), overhead_bytes());
+		if (mEpochs.depth() > 0) mEpochs.record(shared);
 		return shared;
 	}
 }
 
+IDRemapping MonomialPool::compact() {
+	MONOMIAL_POOL_LOCK_GUARD
+	std::vector<Monomial*> monomials;
+	monomials.reserve(mPool.size());
+	for (auto& m: mPool) monomials.push_back(&m);
+	std::sort(monomials.begin(), monomials.end(), [](const Monomial* lhs, const Monomial* rhs) { return lhs->mId < rhs->mId; });
+
+	IDRemapping remapping(mIDs.largestID() + 1);
+	remapping.set(0, 0);
+	std::size_t next = 1;
+	for (auto* m: monomials) {
+		remapping.set(m->mId, next);
+		m->mId = next++;
+	}
+	CARL_LOG_DEBUG("carl.pool", "Compacted monomial ids from " << remapping.old_range() << " to " << next);
+	mIDs.compact(next);
+	mCompactionListeners.notify(remapping);
+	return remapping;
+}
+
+std::size_t MonomialPool::pop_epoch() {
+	MONOMIAL_POOL_LOCK_GUARD
+	auto monomials = mEpochs.pop([](const Monomial::Arg& m) { return m.use_count() > 1; });
+	std::size_t released = 0;
+	for (const auto& m: monomials) {
+		if (m.use_count() > 1) continue;
+		// Remove the monomial here such that the destructor does not need to look it up in the pool.
+		mPool.erase(mPool.iterator_to(*m));
+		mIDs.free(m->mId);
+		mMemory.released(object_bytes(*m));
+		m->mId = 0;
+		++released;
+	}
+	CARL_LOG_DEBUG("carl.pool", "Released " << released << " of " << monomials.size() << " monomials of the epoch");
+	return released;
+}
+
 Monomial::Arg MonomialPool::create(Variable _var, exponent _exp) {
 	CARL_LOG_TRACE("carl.core.monomial", _var << ", " << _exp);
 	return add(Monomial::Content(1, std::make_pair(_var, _exp)), _exp);
@@ -6,7 +6,10 @@
 #pragma once
 
 #include <carl-common/config.h>
+#include <carl-common/memory/Epochs.h>
+#include <carl-common/memory/IDCompaction.h>
 #include <carl-common/memory/IDPool.h>
+#include <carl-common/memory/MemoryUsage.h>
 #include <carl-common/memory/PoolHelper.h>
 #include <carl-common/memory/Singleton.h>
 #include "Monomial.h"
@@ -52,6 +55,12 @@ private:
 	underlying_set mPool;
 	/// Mutex to avoid multiple access to the pool
 	mutable std::recursive_mutex mMutex;
+	/// Memory used by the monomials in the pool.
+	MemoryTracker mMemory;
+	/// Callbacks for data structures indexed by monomial ids.
+	CompactionListeners mCompactionListeners;
+	/// Monomials created in the active epochs.
+	EpochStack<Monomial::Arg> mEpochs;
 
 	#ifdef THREAD_SAFE
 	#define MONOMIAL_POOL_LOCK_GUARD std::lock_guard<std::recursive_mutex> lock(mMutex);
@@ -90,9 +99,19 @@ protected:
 			auto new_buckets = new underlying_set::bucket_type[rehash.second];
 			mPool.rehash(underlying_set::bucket_traits(new_buckets, rehash.second));
 			mPoolBuckets.reset(new_buckets);
+			mMemory.resized(overhead_bytes());
 		}
 	}
 
+	/// Bytes used by a monomial, including its exponent vector and the control block of its shared pointer.
+	static std::size_t object_bytes(const Monomial& m) {
+		return sizeof(Monomial) + m.mExponents.capacity() * sizeof(Monomial::Content::value_type) + memory::shared_ptr_control_block;
+	}
+	/// Bytes used by the pool itself.
+	std::size_t overhead_bytes() const {
+		return mPool.bucket_count() * sizeof(underlying_set::bucket_type) + mIDs.memory_usage();
+	}
+
 public:
 	/**
 	 * Creates a monomial from a variable and an exponent.
@@ -143,6 +162,7 @@ public:
 			CARL_LOG_TRACE("carl.core.monomial", "Found " << m->id());
 			mIDs.free(m->id());
 			mPool.erase(it);
+			mMemory.released(object_bytes(*m));
 		} else {
 			CARL_LOG_TRACE("carl.core.monomial", "Not found in pool.");
 		}
@@ -154,6 +174,46 @@ public:
 	std::size_t largestID() const {
 		return mIDs.largestID();
 	}
+	/// Callbacks that are run when compact() renumbers the monomials.
+	CompactionListeners& compaction_listeners() {
+		return mCompactionListeners;
+	}
+	/**
+	 * Renumbers the monomials in the pool such that their ids range from one to size() again.
+	 * The relative order of the ids is kept and largestID() is reduced accordingly.
+	 * Afterwards, the compaction listeners are notified.
+	 *
+	 * Otherwise, largestID() never decreases, hence this allows to shrink data structures indexed by monomial ids after a large computation.
+	 * It must only be called at a quiescent point, i.e. while no other thread uses monomials and no polynomial operation is running.
+	 * @return The mapping from the old to the new ids.
+	 */
+	IDRemapping compact();
+
+	/**
+	 * Starts a new epoch: all monomials created from now on are kept alive until the epoch is popped.
+	 * This avoids freeing short-lived monomials one by one, e.g. within a step of a backtracking search.
+	 */
+	void push_epoch() {
+		MONOMIAL_POOL_LOCK_GUARD
+		mEpochs.push();
+	}
+	/**
+	 * Ends the innermost epoch and removes all monomials created within it that are not referenced anymore.
+	 * Monomials that are still referenced are moved to the enclosing epoch, if there is one.
+	 * @return The number of monomials removed from the pool.
+	 */
+	std::size_t pop_epoch();
+	std::size_t epoch_depth() const {
+		MONOMIAL_POOL_LOCK_GUARD
+		return mEpochs.depth();
+	}
+	/**
+	 * Returns the memory used by the pool and the monomials it contains.
+	 */
+	MemoryUsage memory_usage() const {
+		MONOMIAL_POOL_LOCK_GUARD;
+		return mMemory.usage(mPool.bucket_count() * sizeof(underlying_set::bucket_type), mIDs.memory_usage(), mIDs.largestID() + 1);
+	}
 };
 
 inline std::ostream& operator<<(std::ostream& os, const MonomialPool& mp) {
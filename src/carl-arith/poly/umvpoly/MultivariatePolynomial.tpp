@@ -11,6 +11,8 @@
 #include "Term.h"
 #include "UnivariatePolynomial.h"
 #include <carl-logging/carl-logging.h>
+#include <carl-arith/trace/carl-recording.h>
+#include <carl-statistics/carl-profiling.h>
 #include <carl-arith/numbers/numbers.h>
 
 #include <algorithm>
@@ -1003,6 +1005,8 @@ MultivariatePolynomial<Coeff,Ordering,Policies>& MultivariatePolynomial<Coeff,Or
 		*this = rhs;
 		return *this *= c;
 	}
+	CARL_PROFILE_ZONE("poly.multiply");
+	CARL_RECORD(Multiply, *this, rhs);
 	auto id = mTermAdditionManager.getId(mTerms.size() * rhs.mTerms.size());
 	TermType newlterm;
 	bool first = true;
@@ -42,6 +42,8 @@ private:
 	std::list<Tuple> mData;
 	TAMId mNextId;
 	mutable std::mutex mMutex;
+	/// Handle of the callback that shrinks the id maps when the monomial pool is compacted.
+	std::size_t mCompactionListener;
     
     #ifdef THREAD_SAFE
     #define TAM_LOCK_GUARD std::lock_guard<std::mutex> lock( mMutex );
@@ -67,9 +69,29 @@ private:
 	}
 public:
 	TermAdditionManager() {
-        MonomialPool::getInstance();
+		mCompactionListener = MonomialPool::getInstance().compaction_listeners().add([this](const IDRemapping& remapping){ shrink(remapping.new_range()); });
 		mNextId = createNewEntry();
 	}
+	~TermAdditionManager() {
+		MonomialPool::getInstance().compaction_listeners().remove(mCompactionListener);
+	}
+	TermAdditionManager(const TermAdditionManager&) = delete;
+	TermAdditionManager& operator=(const TermAdditionManager&) = delete;
+
+	/**
+	 * Shrinks the maps from monomial ids to local ids to the given size.
+	 * The maps only contain zeros while they are not in use, hence they do not need to be renumbered.
+	 */
+	void shrink(std::size_t size) {
+		TAM_LOCK_GUARD
+		for (auto& data: mData) {
+			assert(!std::get<2>(data));
+			TermIDs& termIDs = std::get<0>(data);
+			if (termIDs.size() <= size) continue;
+			termIDs.resize(size);
+			termIDs.shrink_to_fit();
+		}
+	}
 	
     #define SWAP_TERMS
 	
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Factorization_multivariate.h"
 #include "Power.h"
 
 #include <carl-logging/carl-logging.h>
 #include "../CoCoAAdaptor.h"
 #include <carl-arith/converter/OldGinacConverter.h>
 #include <carl-arith/core/Common.h>
+#include <carl-arith/memo/Memoization.h>
+#include <carl-arith/trace/carl-recording.h>
 
 namespace carl {
 
@@ -21,11 +24,22 @@ namespace helper {
 		return { std::make_pair(p, 1) };
 	}
 
+	/**
+	 * Returns the factors of a factorization without their multiplicities.
+	 */
+	template<typename C, typename O, typename P>
+	std::vector<MultivariatePolynomial<C,O,P>> irreducible_factors(const Factors<MultivariatePolynomial<C,O,P>>& factors) {
+		std::vector<MultivariatePolynomial<C,O,P>> res;
+		for (const auto& f: factors) res.push_back(f.first);
+		return res;
+	}
+
 } // namespace helper
 
 /**
  * Try to factorize a multivariate polynomial..
  * Uses CoCoALib and GiNaC, if available, depending on the coefficient type of the polynomial.
+ * Without CoCoALib, polynomials with GMP coefficients are factored by eez::factorization().
  */
 template<typename C, typename O, typename P>
 Factors<MultivariatePolynomial<C,O,P>> factorization(const MultivariatePolynomial<C,O,P>& p, bool includeConstants = true) {
@@ -38,14 +52,15 @@ Factors<MultivariatePolynomial<C,O,P>> factorization(const MultivariatePolynomia
 	} else if (p.total_degree() == 1) {
 		return helper::trivialFactorization(p);
 	}
+	CARL_RECORD(Factorization, p);
 
 	auto s = overloaded {
 	#if defined USE_COCOA
-		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ CoCoAAdaptor<MultivariatePolynomial<mpq_class,O,P>> c({p}); return c.factorize(p, includeConstants); },
-		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ CoCoAAdaptor<MultivariatePolynomial<mpz_class,O,P>> c({p}); return c.factorize(p, includeConstants); }
+		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ return CoCoAAdaptorContext<MultivariatePolynomial<mpq_class,O,P>>::get().adaptor(p)->factorize(p, includeConstants); },
+		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ return CoCoAAdaptorContext<MultivariatePolynomial<mpz_class,O,P>>::get().adaptor(p)->factorize(p, includeConstants); }
 	#else
-		[](const MultivariatePolynomial<mpq_class,O,P>& p){ return helper::trivialFactorization(p); },
-		[](const MultivariatePolynomial<mpz_class,O,P>& p){ return helper::trivialFactorization(p); }
+		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ return eez::factorization(p, includeConstants); },
+		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ return eez::factorization(p, includeConstants); }
 	#endif
 	#if defined USE_GINAC
 		,
@@ -54,7 +69,7 @@ Factors<MultivariatePolynomial<C,O,P>> factorization(const MultivariatePolynomia
 	#endif
 	};
 
-	auto factors = s(p);
+	auto factors = memo::memoized<Factors<MultivariatePolynomial<C,O,P>>>(memo::Operation::Factorization, includeConstants, [&s, &p]() { return s(p); }, p);
 	return factors;
 }
 
@@ -67,6 +82,7 @@ bool is_trivial(const Factors<MultivariatePolynomial<C,O,P>>& f) {
 /**
  * Try to factorize a multivariate polynomial and return the irreducible factors (without multiplicities).
  * Uses CoCoALib and GiNaC, if available, depending on the coefficient type of the polynomial.
+ * Without CoCoALib, polynomials with GMP coefficients are factored by eez::factorization().
  */
 template<typename C, typename O, typename P>
 std::vector<MultivariatePolynomial<C,O,P>> irreducible_factors(const MultivariatePolynomial<C,O,P>& p, bool includeConstants = true) {
@@ -82,11 +98,11 @@ std::vector<MultivariatePolynomial<C,O,P>> irreducible_factors(const Multivariat
 
 	auto s = overloaded {
 	#if defined USE_COCOA
-		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ CoCoAAdaptor<MultivariatePolynomial<mpq_class,O,P>> c({p}); return c.irreducible_factors(p, includeConstants); },
-		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ CoCoAAdaptor<MultivariatePolynomial<mpz_class,O,P>> c({p}); return c.irreducible_factors(p, includeConstants); }
+		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ return CoCoAAdaptorContext<MultivariatePolynomial<mpq_class,O,P>>::get().adaptor(p)->irreducible_factors(p, includeConstants); },
+		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ return CoCoAAdaptorContext<MultivariatePolynomial<mpz_class,O,P>>::get().adaptor(p)->irreducible_factors(p, includeConstants); }
 	#else
-		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ return std::vector<MultivariatePolynomial<mpq_class,O,P>>({p}); },
-		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ return std::vector<MultivariatePolynomial<mpz_class,O,P>>({p}); }
+		[includeConstants](const MultivariatePolynomial<mpq_class,O,P>& p){ return helper::irreducible_factors(eez::factorization(p, includeConstants)); },
+		[includeConstants](const MultivariatePolynomial<mpz_class,O,P>& p){ return helper::irreducible_factors(eez::factorization(p, includeConstants)); }
 	#endif
 	#if defined USE_GINAC
 		,
@@ -94,7 +110,7 @@ std::vector<MultivariatePolynomial<C,O,P>> irreducible_factors(const Multivariat
 		[](const MultivariatePolynomial<cln::cl_I,O,P>& p){ return std::vector<MultivariatePolynomial<cln::cl_I,O,P>>({p}); }
 	#endif
 	};
-	return s(p);
+	return memo::memoized<std::vector<MultivariatePolynomial<C,O,P>>>(memo::Operation::IrreducibleFactors, includeConstants, [&s, &p]() { return s(p); }, p);
 }
 
 }
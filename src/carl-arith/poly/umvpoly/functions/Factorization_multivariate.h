@@ -0,0 +1,510 @@
+/**
+ * @file
+ *
+ * Native factorization of multivariate polynomials with rational coefficients.
+ *
+ * After removing contents and computing a square-free decomposition, every square-free factor is factored by the
+ * extended Zassenhaus approach of Wang: the polynomial is evaluated at an integer point in all but one variable, the
+ * univariate image is factored by zassenhaus::factor_squarefree() and the univariate factors are lifted by
+ * multivariate Hensel lifting, following Algorithms 6.2 and 6.4 from the book
+ * Algorithms for Computer Algebra by Geddes, Czapor, Labahn.
+ * The evaluation point is moved to the origin, hence truncations modulo powers of the evaluation ideal only drop terms.
+ * The leading coefficient problem is solved by imposing the leading coefficient of the polynomial on every factor.
+ * If the image has more factors than the polynomial, combinations of image factors are lifted instead.
+ */
+
+#pragma once
+
+#include "Factorization_zassenhaus.h"
+
+#include "Degree.h"
+#include "Derivative.h"
+#include "Division.h"
+#include "GCD.h"
+#include "Power.h"
+#include "Remainder.h"
+#include "Substitution.h"
+#include "to_univariate_polynomial.h"
+
+#include <carl-arith/core/Common.h>
+#include <carl-arith/core/Variables.h>
+#include <carl-logging/carl-logging.h>
+
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace carl::eez {
+
+/// Maximal number of evaluation points that are tried.
+constexpr std::size_t max_attempts = 100;
+/// Number of suitable evaluation points whose images are compared before lifting.
+constexpr std::size_t image_candidates = 3;
+/// Number of evaluation points that are tried to show that a polynomial is square-free.
+constexpr std::size_t squarefree_attempts = 5;
+
+namespace detail {
+
+template<typename Poly>
+using UPoly = UnivariatePolynomial<typename Poly::CoeffType>;
+
+template<typename Poly>
+Poly from_dense(const zassenhaus::Dense& d, Variable x) {
+	typename Poly::TermsType terms;
+	for (std::size_t i = 0; i < d.size(); ++i) {
+		if (carl::is_zero(d[i])) continue;
+		if (i == 0) terms.emplace_back(typename Poly::CoeffType(d[i]));
+		else terms.emplace_back(typename Poly::CoeffType(d[i]), x, static_cast<uint>(i));
+	}
+	return Poly(std::move(terms));
+}
+
+/// Converts a polynomial in (at most) the variable x, scaled by the common denominator of its coefficients.
+template<typename Poly>
+zassenhaus::Dense to_dense(const Poly& p, Variable x) {
+	zassenhaus::Integer denominator = 1;
+	for (const auto& t: p) {
+		if (!carl::is_integer(t.coeff())) denominator = carl::lcm(denominator, zassenhaus::Integer(carl::get_denom(t.coeff())));
+	}
+	zassenhaus::Dense res(p.degree(x) + 1);
+	for (const auto& t: p) {
+		res[t.monomial() == nullptr ? 0 : t.monomial()->exponent_of_variable(x)] = carl::get_num(typename Poly::CoeffType(t.coeff() * denominator));
+	}
+	return res;
+}
+
+/// Converts a polynomial in (at most) the variable x.
+template<typename Poly>
+UPoly<Poly> to_univariate(const Poly& p, Variable x) {
+	std::vector<typename Poly::CoeffType> coeffs(p.degree(x) + 1);
+	for (const auto& t: p) {
+		coeffs[t.monomial() == nullptr ? 0 : t.monomial()->exponent_of_variable(x)] = t.coeff();
+	}
+	return UPoly<Poly>(x, std::move(coeffs));
+}
+
+template<typename Poly>
+Poly from_univariate(const UPoly<Poly>& p) {
+	typename Poly::TermsType terms;
+	for (std::size_t i = 0; i < p.coefficients().size(); ++i) {
+		const auto& c = p.coefficients()[i];
+		if (carl::is_zero(c)) continue;
+		if (i == 0) terms.emplace_back(c);
+		else terms.emplace_back(c, p.main_var(), static_cast<uint>(i));
+	}
+	return Poly(std::move(terms));
+}
+
+/// The total degree of the term in the first n of the given variables.
+template<typename Term>
+std::size_t degree_in(const Term& t, const std::vector<Variable>& vars, std::size_t n) {
+	if (t.monomial() == nullptr) return 0;
+	std::size_t res = 0;
+	for (std::size_t i = 0; i < n; ++i) res += t.monomial()->exponent_of_variable(vars[i]);
+	return res;
+}
+
+/// Drops all terms whose total degree in the first n of the given variables exceeds the given degree.
+template<typename Poly>
+Poly truncate(const Poly& p, const std::vector<Variable>& vars, std::size_t n, std::size_t degree) {
+	typename Poly::TermsType terms;
+	for (const auto& t: p) {
+		if (degree_in(t, vars, n) <= degree) terms.push_back(t);
+	}
+	return Poly(std::move(terms), false, true);
+}
+
+/// Sets all but the first n of the given variables to zero.
+template<typename Poly>
+Poly restrict(const Poly& p, const std::vector<Variable>& vars, std::size_t n) {
+	typename Poly::TermsType terms;
+	for (const auto& t: p) {
+		if (degree_in(t, vars, vars.size()) == degree_in(t, vars, n)) terms.push_back(t);
+	}
+	return Poly(std::move(terms), false, true);
+}
+
+template<typename Poly>
+Poly product(const std::vector<Poly>& polys) {
+	Poly res(1);
+	for (const auto& p: polys) res *= p;
+	return res;
+}
+
+template<typename Poly>
+Poly exact_quotient(const Poly& dividend, const Poly& divisor) {
+	Poly res;
+	[[maybe_unused]] bool divides = carl::try_divide(dividend, divisor, res);
+	assert(divides);
+	return res;
+}
+
+/// The gcd of the coefficients of p with respect to x.
+template<typename Poly>
+Poly content(const Poly& p, Variable x) {
+	Poly res;
+	auto u = carl::to_univariate_polynomial(p, x);
+	for (const auto& c: u.coefficients()) {
+		if (carl::is_zero(c)) continue;
+		res = carl::is_zero(res) ? c : carl::gcd(res, c);
+		if (res.is_constant()) return Poly(1);
+	}
+	return res;
+}
+
+/// The primitive part with respect to x, with coprime integer coefficients and positive leading coefficient.
+template<typename Poly>
+Poly primitive_part(const Poly& p, Variable x) {
+	Poly c = content(p, x);
+	Poly res = c.is_constant() ? p : exact_quotient(p, c);
+	return res.coprime_coefficients();
+}
+
+/// Evaluates p at the given point, the result is a primitive dense polynomial in x with positive leading coefficient.
+template<typename Poly>
+zassenhaus::Dense image(const Poly& p, Variable x, const std::map<Variable, typename Poly::CoeffType>& point) {
+	zassenhaus::Dense res = to_dense(carl::substitute(p, point), x);
+	zassenhaus::Integer c = zassenhaus::content(res);
+	for (auto& coeff: res) coeff /= c;
+	return res;
+}
+
+template<typename Poly>
+bool is_squarefree(const zassenhaus::Dense& image, Variable x) {
+	UPoly<Poly> u = to_univariate(from_dense<Poly>(image, x), x);
+	return carl::is_constant(carl::gcd(u, carl::derivative(u)));
+}
+
+/**
+ * Checks whether p is square-free with respect to x by looking for a square-free univariate image of the same degree.
+ * A square factor of p would remain a square factor of every such image, hence this avoids a multivariate gcd
+ * computation in the common case. A negative answer is inconclusive.
+ */
+template<typename Poly>
+bool has_squarefree_image(const Poly& p, Variable x) {
+	using Coeff = typename Poly::CoeffType;
+	Poly L = p.lcoeff(x);
+	std::mt19937 rng(static_cast<unsigned>(p.nr_terms()));
+	for (std::size_t attempt = 0; attempt < squarefree_attempts; ++attempt) {
+		std::uniform_int_distribution<int> value(-static_cast<int>(attempt) - 2, static_cast<int>(attempt) + 2);
+		std::map<Variable, Coeff> point;
+		for (Variable v: carl::variables(p)) {
+			if (v != x) point.emplace(v, value(rng));
+		}
+		if (carl::is_zero(carl::substitute(L, point))) continue;
+		if (is_squarefree<Poly>(image(p, x, point), x)) return true;
+	}
+	return false;
+}
+
+/**
+ * Solves multivariate diophantine equations sum_i s_i * prod_{j != i} a_j = c, following Algorithm 6.2.
+ * The a_i are given up to the evaluation at the origin, where they are the univariate base polynomials.
+ * Solutions are computed modulo the terms of total degree greater than the degree bound in the variables.
+ */
+template<typename Poly>
+class Diophant {
+	Variable mX;
+	const std::vector<Variable>& mVars;
+	std::size_t mDegree;
+	std::vector<UPoly<Poly>> mBase;
+	/// s_i such that sum_i s_i * prod_{j != i} base_j = 1.
+	std::vector<UPoly<Poly>> mInverses;
+public:
+	Diophant(Variable x, const std::vector<Variable>& vars, std::size_t degree, const std::vector<UPoly<Poly>>& base):
+		mX(x), mVars(vars), mDegree(degree), mBase(base)
+	{
+		for (std::size_t i = 0; i < mBase.size(); ++i) {
+			UPoly<Poly> b = UPoly<Poly>(x, typename Poly::CoeffType(1));
+			for (std::size_t j = 0; j < mBase.size(); ++j) {
+				if (j != i) b = carl::remainder(b * mBase[j], mBase[i]);
+			}
+			UPoly<Poly> s(x);
+			UPoly<Poly> t(x);
+			[[maybe_unused]] auto g = carl::extended_gcd(mBase[i], b, s, t);
+			assert(carl::is_constant(g) && carl::is_one(g.lcoeff()));
+			mInverses.push_back(carl::remainder(t, mBase[i]));
+		}
+	}
+
+	/**
+	 * Solves the equation for the a_i and c in the first v variables and x.
+	 */
+	std::vector<Poly> solve(const std::vector<Poly>& a, const Poly& c, std::size_t v) const {
+		std::vector<Poly> res;
+		if (v == 0) {
+			UPoly<Poly> cu = to_univariate(c, mX);
+			for (std::size_t i = 0; i < mBase.size(); ++i) {
+				res.push_back(from_univariate<Poly>(carl::remainder(cu * mInverses[i], mBase[i])));
+			}
+			return res;
+		}
+		Variable z = mVars[v - 1];
+		std::vector<Poly> b;
+		std::vector<Poly> lower;
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			Poly bi(1);
+			for (std::size_t j = 0; j < a.size(); ++j) {
+				if (j != i) bi = truncate(bi * a[j], mVars, v, mDegree);
+			}
+			b.push_back(std::move(bi));
+			lower.push_back(a[i].coeff(z, 0));
+		}
+		auto error = [&](const Poly& e, const std::vector<Poly>& s) {
+			Poly res = e;
+			for (std::size_t i = 0; i < s.size(); ++i) res -= s[i] * b[i];
+			return truncate(res, mVars, v, mDegree);
+		};
+		res = solve(lower, c.coeff(z, 0), v - 1);
+		Poly e = error(c, res);
+		Poly monomial(1);
+		for (std::size_t m = 1; m <= mDegree && !carl::is_zero(e); ++m) {
+			monomial *= z;
+			Poly cm = e.coeff(z, m);
+			if (carl::is_zero(cm)) continue;
+			std::vector<Poly> ds = solve(lower, cm, v - 1);
+			for (std::size_t i = 0; i < ds.size(); ++i) {
+				ds[i] *= monomial;
+				res[i] += ds[i];
+			}
+			e = error(e, ds);
+		}
+		for (auto& r: res) r = truncate(r, mVars, v, mDegree);
+		return res;
+	}
+};
+
+/**
+ * Lifts the factorization of G(x, 0) into the given univariate images to a factorization of L^(r-1) * G, where L is
+ * the leading coefficient of G with respect to x and every factor has leading coefficient L (Algorithm 6.4).
+ * @return The lifted factors or std::nullopt if the images do not correspond to a factorization of G.
+ */
+template<typename Poly>
+std::optional<std::vector<Poly>> lift(const Poly& G, Variable x, const std::vector<Variable>& vars, const std::vector<zassenhaus::Dense>& images) {
+	using Coeff = typename Poly::CoeffType;
+	Poly L = G.lcoeff(x);
+	Poly F = G * carl::pow(L, images.size() - 1);
+	Coeff L0 = restrict(L, vars, 0).constant_part();
+	std::vector<UPoly<Poly>> base;
+	std::vector<Poly> factors;
+	std::vector<std::size_t> degrees;
+	for (const auto& image: images) {
+		base.push_back(to_univariate(from_dense<Poly>(image, x), x) * Coeff(L0 / Coeff(image.back())));
+		factors.push_back(from_univariate<Poly>(base.back()));
+		degrees.push_back(zassenhaus::degree(image));
+	}
+	std::size_t degree = 0;
+	for (const auto& t: F) degree = std::max(degree, degree_in(t, vars, vars.size()));
+	Diophant<Poly> diophant(x, vars, degree, base);
+
+	for (std::size_t j = 1; j <= vars.size(); ++j) {
+		Variable z = vars[j - 1];
+		Poly Fj = restrict(F, vars, j);
+		Poly Lj = restrict(L, vars, j);
+		std::vector<Poly> lower;
+		for (std::size_t i = 0; i < factors.size(); ++i) {
+			lower.push_back(factors[i]);
+			Poly xd = carl::pow(Poly(x), degrees[i]);
+			factors[i] += (Lj - factors[i].coeff(x, degrees[i])) * xd;
+		}
+		Poly e = Fj - product(factors);
+		Poly monomial(1);
+		for (std::size_t m = 1; m <= Fj.degree(z) && !carl::is_zero(e); ++m) {
+			monomial *= z;
+			Poly c = e.coeff(z, m);
+			if (carl::is_zero(c)) continue;
+			std::vector<Poly> ds = diophant.solve(lower, c, j - 1);
+			for (std::size_t i = 0; i < factors.size(); ++i) {
+				factors[i] += ds[i] * monomial;
+			}
+			e = Fj - product(factors);
+		}
+		if (!carl::is_zero(e)) {
+			CARL_LOG_DEBUG("carl.core.factorization", "Lifting in " << z << " failed");
+			return std::nullopt;
+		}
+	}
+	return factors;
+}
+
+/**
+ * Factors a square-free polynomial with coprime integer coefficients that is primitive with respect to x and contains
+ * other variables than x.
+ */
+template<typename Poly>
+std::vector<Poly> factor_squarefree(const Poly& g, Variable x) {
+	using Coeff = typename Poly::CoeffType;
+	std::vector<Variable> vars;
+	for (Variable v: carl::variables(g)) {
+		if (v != x) vars.push_back(v);
+	}
+	Poly L = g.lcoeff(x);
+	std::mt19937 rng(static_cast<unsigned>(g.nr_terms()));
+	std::optional<std::pair<std::map<Variable, Coeff>, std::vector<zassenhaus::Dense>>> best;
+	std::size_t found = 0;
+	for (std::size_t attempt = 0; attempt < max_attempts && found < image_candidates; ++attempt) {
+		std::uniform_int_distribution<int> value(-static_cast<int>(attempt) - 1, static_cast<int>(attempt) + 1);
+		std::map<Variable, Coeff> point;
+		for (Variable v: vars) point.emplace(v, attempt == 0 ? 0 : value(rng));
+		if (carl::is_zero(carl::substitute(L, point))) continue;
+		zassenhaus::Dense u = image(g, x, point);
+		if (!is_squarefree<Poly>(u, x)) continue;
+		auto factors = zassenhaus::factor_squarefree(u);
+		if (factors.size() == 1) return { g };
+		++found;
+		if (!best || factors.size() < best->second.size()) {
+			best = std::make_pair(std::move(point), std::move(factors));
+		}
+	}
+	if (!best) {
+		CARL_LOG_WARN("carl.core.factorization", "Found no suitable evaluation point for " << g);
+		return { g };
+	}
+	CARL_LOG_DEBUG("carl.core.factorization", "Lifting " << best->second.size() << " factors of the image of " << g);
+
+	std::map<Variable, Poly> shift;
+	std::map<Variable, Poly> unshift;
+	for (const auto& [v, val]: best->first) {
+		if (carl::is_zero(val)) continue;
+		shift.emplace(v, Poly(v) + val);
+		unshift.emplace(v, Poly(v) - val);
+	}
+	auto restore = [&unshift](const Poly& p) {
+		return unshift.empty() ? p : carl::substitute(p, unshift).coprime_coefficients();
+	};
+	Poly G = shift.empty() ? g : carl::substitute(g, shift);
+	std::vector<Poly> res;
+	if (auto lifted = lift(G, x, vars, best->second)) {
+		for (const auto& f: *lifted) res.push_back(restore(primitive_part(f, x)));
+		return res;
+	}
+
+	// The image has spurious factors: lift the smallest combinations of image factors first.
+	std::vector<zassenhaus::Dense> images = std::move(best->second);
+	for (std::size_t s = 1; 2 * s <= images.size();) {
+		std::vector<std::size_t> combination(s);
+		std::iota(combination.begin(), combination.end(), 0);
+		bool success = false;
+		do {
+			if (2 * s == images.size() && combination.front() != 0) break;
+			std::vector<zassenhaus::Dense> pair = { {1}, {1} };
+			for (std::size_t i = 0, k = 0; i < images.size(); ++i) {
+				bool selected = k < s && combination[k] == i;
+				if (selected) ++k;
+				pair[selected ? 0 : 1] = zassenhaus::mul(pair[selected ? 0 : 1], images[i]);
+			}
+			if (auto lifted = lift(G, x, vars, pair)) {
+				Poly h = primitive_part(lifted->front(), x);
+				G = exact_quotient(G, h);
+				res.push_back(restore(h));
+				for (std::size_t i = s; i-- > 0;) {
+					images.erase(images.begin() + static_cast<std::ptrdiff_t>(combination[i]));
+				}
+				success = true;
+				break;
+			}
+		} while (zassenhaus::detail::next_combination(combination, images.size()));
+		if (!success) ++s;
+	}
+	res.push_back(restore(G.coprime_coefficients()));
+	return res;
+}
+
+/**
+ * Adds the irreducible factors of p with the given multiplicity to the result.
+ */
+template<typename Poly>
+void factor(Poly p, Factors<Poly>& res, uint multiplicity) {
+	p = p.coprime_coefficients();
+	for (Variable v: carl::variables(p)) {
+		std::size_t k = std::numeric_limits<std::size_t>::max();
+		for (const auto& t: p) {
+			k = std::min(k, t.monomial() == nullptr ? 0 : t.monomial()->exponent_of_variable(v));
+		}
+		if (k > 0) {
+			res[Poly(v)] += static_cast<uint>(k) * multiplicity;
+			p = exact_quotient(p, carl::pow(Poly(v), k));
+		}
+	}
+	if (p.is_constant()) return;
+	// The main variable is the one of smallest degree.
+	Variable x = Variable::NO_VARIABLE;
+	for (Variable v: carl::variables(p)) {
+		if (x == Variable::NO_VARIABLE || p.degree(v) < p.degree(x)) x = v;
+	}
+	Poly c = content(p, x);
+	if (!c.is_constant()) {
+		factor(c, res, multiplicity);
+		p = exact_quotient(p, c);
+	}
+	auto add = [&res, x, multiplicity](const Poly& a, uint i) {
+		Poly f = a.coprime_coefficients();
+		if (carl::variables(f).size() == 1) {
+			for (const auto& d: zassenhaus::factor_squarefree(to_dense(f, x))) {
+				res[from_dense<Poly>(d, x)] += i * multiplicity;
+			}
+		} else {
+			for (const auto& h: factor_squarefree(f, x)) {
+				res[h] += i * multiplicity;
+			}
+		}
+	};
+	if (has_squarefree_image(p, x)) {
+		add(p, 1);
+		return;
+	}
+	// Square-free decomposition with respect to x by the algorithm of Yun.
+	Poly dp = carl::derivative(p, x);
+	Poly a = carl::gcd(p, dp);
+	Poly b = exact_quotient(p, a);
+	Poly d = exact_quotient(dp, a) - carl::derivative(b, x);
+	for (uint i = 1; b.degree(x) > 0; ++i) {
+		a = carl::is_zero(d) ? b : carl::gcd(b, d);
+		if (a.degree(x) > 0) add(a, i);
+		b = exact_quotient(b, a);
+		d = exact_quotient(d, a) - carl::derivative(b, x);
+	}
+}
+
+}
+
+/**
+ * Factors a polynomial with rational or integer coefficients into irreducible factors.
+ * The factors have coprime integer coefficients and positive leading coefficients, the remaining constant factor is
+ * included if includeConstants is set and it is not one.
+ */
+template<typename C, typename O, typename P>
+Factors<MultivariatePolynomial<C,O,P>> factorization(const MultivariatePolynomial<C,O,P>& p, bool includeConstants = true) {
+	using Poly = MultivariatePolynomial<mpq_class,O,P>;
+	Factors<MultivariatePolynomial<C,O,P>> res;
+	if (carl::is_zero(p)) {
+		if (includeConstants) res.emplace(p, 1);
+		return res;
+	}
+	typename Poly::TermsType terms;
+	for (const auto& t: p) terms.emplace_back(mpq_class(t.coeff()), t.monomial());
+	Poly q(std::move(terms), false, true);
+	Factors<Poly> raw;
+	detail::factor(q, raw, 1);
+	Factors<Poly> factors;
+	for (const auto& [f, e]: raw) {
+		// Factors are normalized with respect to x, but the leading term depends on the monomial ordering.
+		factors[carl::is_negative(f.lcoeff()) ? Poly(-f) : f] += e;
+	}
+	mpq_class constant = q.lcoeff();
+	for (const auto& [f, e]: factors) constant /= carl::pow(f.lcoeff(), e);
+	auto convert = [](const Poly& f) {
+		typename MultivariatePolynomial<C,O,P>::TermsType terms;
+		for (const auto& t: f) {
+			if constexpr (std::is_same_v<C, mpz_class>) terms.emplace_back(t.coeff().get_num(), t.monomial());
+			else terms.emplace_back(t.coeff(), t.monomial());
+		}
+		return MultivariatePolynomial<C,O,P>(std::move(terms), false, true);
+	};
+	if (includeConstants && !carl::is_one(constant)) res.emplace(convert(Poly(constant)), 1);
+	for (const auto& [f, e]: factors) res.emplace(convert(f), e);
+	return res;
+}
+
+}
@@ -0,0 +1,508 @@
+/**
+ * @file
+ *
+ * Factorization of univariate integer polynomials following Zassenhaus.
+ *
+ * A square-free polynomial is factored modulo a small prime by distinct degree and equal degree factorization
+ * (Cantor-Zassenhaus). The modular factors are lifted by Hensel lifting modulo a power of the prime that exceeds a
+ * bound on the coefficients of the integer factors. Finally, the integer factors are recovered by testing
+ * combinations of the lifted factors, which is done in parallel if there are many combinations.
+ *
+ * Polynomials are dense coefficient vectors, coefficients are reduced modulo p^k to the symmetric range.
+ */
+
+#pragma once
+
+#include <carl-arith/numbers/PrimeFactory.h>
+#include <carl-arith/numbers/numbers.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace carl::zassenhaus {
+
+using Integer = mpz_class;
+/// A dense polynomial, the coefficient of x^i is at position i. The zero polynomial is empty.
+using Dense = std::vector<Integer>;
+
+/**
+ * Integers modulo p^k.
+ * GaloisField computes p^k with machine integers, which overflows for the moduli used for Hensel lifting.
+ */
+class Field {
+	unsigned mP;
+	Integer mSize;
+public:
+	explicit Field(unsigned p, unsigned k = 1): mP(p), mSize(carl::pow(Integer(p), k)) {}
+	unsigned p() const {
+		return mP;
+	}
+	const Integer& size() const {
+		return mSize;
+	}
+};
+
+/// Number of suitable primes that are tried before the modular factorization is fixed.
+constexpr std::size_t prime_candidates = 5;
+/// Maximal number of primes that are tried, only a polynomial that is not square-free exhausts them.
+constexpr std::size_t max_primes = 1000;
+/// Minimal number of combinations of a single size that are tested in parallel.
+constexpr std::size_t parallel_threshold = 64;
+
+inline void trim(Dense& a) {
+	while (!a.empty() && carl::is_zero(a.back())) a.pop_back();
+}
+
+inline std::size_t degree(const Dense& a) {
+	assert(!a.empty());
+	return a.size() - 1;
+}
+
+/// Reduces n to the symmetric range around zero.
+inline Integer reduce(const Integer& n, const Field& gf) {
+	Integer res;
+	mpz_fdiv_r(res.get_mpz_t(), n.get_mpz_t(), gf.size().get_mpz_t());
+	if (2 * res > gf.size()) res -= gf.size();
+	return res;
+}
+
+inline void reduce(Dense& a, const Field& gf) {
+	for (auto& c: a) c = reduce(c, gf);
+	trim(a);
+}
+
+inline Integer inverse(const Integer& n, const Field& gf) {
+	Integer res;
+	[[maybe_unused]] int invertible = mpz_invert(res.get_mpz_t(), n.get_mpz_t(), gf.size().get_mpz_t());
+	assert(invertible != 0);
+	return reduce(res, gf);
+}
+
+inline Dense add(const Dense& a, const Dense& b, const Field& gf) {
+	Dense res(std::max(a.size(), b.size()));
+	for (std::size_t i = 0; i < a.size(); ++i) res[i] = a[i];
+	for (std::size_t i = 0; i < b.size(); ++i) res[i] += b[i];
+	reduce(res, gf);
+	return res;
+}
+
+inline Dense sub(const Dense& a, const Dense& b, const Field& gf) {
+	Dense res(std::max(a.size(), b.size()));
+	for (std::size_t i = 0; i < a.size(); ++i) res[i] = a[i];
+	for (std::size_t i = 0; i < b.size(); ++i) res[i] -= b[i];
+	reduce(res, gf);
+	return res;
+}
+
+/// Product over the integers.
+inline Dense mul(const Dense& a, const Dense& b) {
+	if (a.empty() || b.empty()) return Dense();
+	Dense res(a.size() + b.size() - 1);
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		if (carl::is_zero(a[i])) continue;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			res[i + j] += a[i] * b[j];
+		}
+	}
+	return res;
+}
+
+inline Dense mul(const Dense& a, const Dense& b, const Field& gf) {
+	Dense res = mul(a, b);
+	reduce(res, gf);
+	return res;
+}
+
+inline Dense scale(const Dense& a, const Integer& c, const Field& gf) {
+	Dense res(a);
+	for (auto& r: res) r *= c;
+	reduce(res, gf);
+	return res;
+}
+
+/**
+ * Division with remainder, the leading coefficient of b must be invertible.
+ * @return Quotient and remainder.
+ */
+inline std::pair<Dense, Dense> divide(Dense a, const Dense& b, const Field& gf) {
+	assert(!b.empty());
+	if (a.size() < b.size()) {
+		reduce(a, gf);
+		return std::make_pair(Dense(), std::move(a));
+	}
+	Integer inv = inverse(b.back(), gf);
+	Dense q(a.size() - b.size() + 1);
+	for (std::size_t k = q.size(); k-- > 0;) {
+		q[k] = reduce(a[k + b.size() - 1] * inv, gf);
+		if (carl::is_zero(q[k])) continue;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			a[k + j] -= q[k] * b[j];
+		}
+	}
+	a.resize(b.size() - 1);
+	reduce(a, gf);
+	trim(q);
+	return std::make_pair(std::move(q), std::move(a));
+}
+
+inline Dense remainder(const Dense& a, const Dense& b, const Field& gf) {
+	return divide(a, b, gf).second;
+}
+
+inline Dense monic(const Dense& a, const Field& gf) {
+	if (a.empty()) return a;
+	return scale(a, inverse(a.back(), gf), gf);
+}
+
+/// Monic gcd, the modulus must be prime.
+inline Dense gcd(Dense a, Dense b, const Field& gf) {
+	while (!b.empty()) {
+		Dense r = remainder(a, b, gf);
+		a = std::move(b);
+		b = std::move(r);
+	}
+	return monic(a, gf);
+}
+
+/**
+ * Computes s and t such that s*a + t*b = 1 for coprime a and b, the modulus must be prime.
+ */
+inline std::pair<Dense, Dense> extended_gcd(const Dense& a, const Dense& b, const Field& gf) {
+	Dense r0 = a, r1 = b;
+	Dense s0 = {1}, s1;
+	Dense t0, t1 = {1};
+	while (!r1.empty()) {
+		auto [q, r] = divide(r0, r1, gf);
+		r0 = std::move(r1);
+		r1 = std::move(r);
+		Dense s = sub(s0, mul(q, s1, gf), gf);
+		s0 = std::move(s1);
+		s1 = std::move(s);
+		Dense t = sub(t0, mul(q, t1, gf), gf);
+		t0 = std::move(t1);
+		t1 = std::move(t);
+	}
+	assert(r0.size() == 1);
+	Integer inv = inverse(r0.back(), gf);
+	return std::make_pair(scale(s0, inv, gf), scale(t0, inv, gf));
+}
+
+/// Computes base^e modulo m.
+inline Dense power(const Dense& base, const Integer& e, const Dense& m, const Field& gf) {
+	Dense res = remainder({1}, m, gf);
+	Dense b = remainder(base, m, gf);
+	for (std::size_t i = mpz_sizeinbase(e.get_mpz_t(), 2); i-- > 0;) {
+		res = remainder(mul(res, res, gf), m, gf);
+		if (mpz_tstbit(e.get_mpz_t(), i)) {
+			res = remainder(mul(res, b, gf), m, gf);
+		}
+	}
+	return res;
+}
+
+inline Dense derivative(const Dense& a) {
+	if (a.size() <= 1) return Dense();
+	Dense res(a.size() - 1);
+	for (std::size_t i = 1; i < a.size(); ++i) res[i - 1] = a[i] * static_cast<unsigned long>(i);
+	return res;
+}
+
+/// The gcd of the coefficients, with the sign of the leading coefficient.
+inline Integer content(const Dense& a) {
+	assert(!a.empty());
+	Integer res;
+	for (const auto& c: a) res = carl::gcd(res, c);
+	if (a.back() < 0) res = -res;
+	return res;
+}
+
+/**
+ * Divides a by b over the integers.
+ * @return The quotient or std::nullopt if b does not divide a.
+ */
+inline std::optional<Dense> divide_exact(Dense a, const Dense& b) {
+	assert(!b.empty());
+	if (a.size() < b.size()) {
+		if (a.empty()) return a;
+		return std::nullopt;
+	}
+	Dense q(a.size() - b.size() + 1);
+	for (std::size_t k = q.size(); k-- > 0;) {
+		const Integer& c = a[k + b.size() - 1];
+		if (!mpz_divisible_p(c.get_mpz_t(), b.back().get_mpz_t())) return std::nullopt;
+		mpz_divexact(q[k].get_mpz_t(), c.get_mpz_t(), b.back().get_mpz_t());
+		if (carl::is_zero(q[k])) continue;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			a[k + j] -= q[k] * b[j];
+		}
+	}
+	for (std::size_t i = 0; i + 1 < b.size(); ++i) {
+		if (!carl::is_zero(a[i])) return std::nullopt;
+	}
+	return q;
+}
+
+namespace detail {
+
+/**
+ * Distinct degree factorization of a monic square-free polynomial modulo a prime.
+ * @return Pairs of a degree d and the product of all irreducible factors of degree d.
+ */
+inline std::vector<std::pair<std::size_t, Dense>> distinct_degree(Dense f, const Field& gf) {
+	std::vector<std::pair<std::size_t, Dense>> res;
+	const Dense x = {0, 1};
+	Dense h = x;
+	for (std::size_t d = 1; 2 * d <= degree(f); ++d) {
+		h = power(h, gf.size(), f, gf);
+		Dense g = gcd(sub(h, x, gf), f, gf);
+		if (degree(g) > 0) {
+			f = divide(f, g, gf).first;
+			h = remainder(h, f, gf);
+			res.emplace_back(d, std::move(g));
+		}
+	}
+	if (degree(f) > 0) res.emplace_back(degree(f), std::move(f));
+	return res;
+}
+
+/**
+ * Splits a monic product of irreducible factors of degree d modulo an odd prime (Cantor-Zassenhaus).
+ */
+inline void equal_degree(const Dense& f, std::size_t d, const Field& gf, std::mt19937& rng, std::vector<Dense>& res) {
+	if (degree(f) == d) {
+		res.push_back(f);
+		return;
+	}
+	Integer e = (carl::pow(Integer(gf.p()), d) - 1) / 2;
+	std::uniform_int_distribution<unsigned> coefficient(0, gf.p() - 1);
+	while (true) {
+		Dense a(degree(f));
+		for (auto& c: a) c = reduce(Integer(coefficient(rng)), gf);
+		trim(a);
+		if (a.size() < 2) continue;
+		Dense g = gcd(a, f, gf);
+		if (degree(g) == 0) {
+			g = gcd(sub(power(a, e, f, gf), {1}, gf), f, gf);
+		}
+		if (degree(g) > 0 && degree(g) < degree(f)) {
+			equal_degree(g, d, gf, rng, res);
+			equal_degree(divide(f, g, gf).first, d, gf, rng, res);
+			return;
+		}
+	}
+}
+
+/**
+ * Lifts the factorization f = g*h of a monic f from modulo p to modulo p^k.
+ * The factors are monic and coprime modulo p, f is given modulo p^k.
+ */
+inline void lift(const Dense& f, Dense& g, Dense& h, unsigned p, unsigned k) {
+	Field gfp(p);
+	auto [s, t] = extended_gcd(g, h, gfp);
+	Integer modulus = p;
+	for (unsigned j = 1; j < k; ++j) {
+		Field gfj(p, j + 1);
+		Dense e = sub(f, mul(g, h), gfj);
+		for (auto& c: e) mpz_divexact(c.get_mpz_t(), c.get_mpz_t(), modulus.get_mpz_t());
+		reduce(e, gfp);
+		Dense dg = remainder(mul(e, t, gfp), g, gfp);
+		Dense dh = remainder(mul(e, s, gfp), h, gfp);
+		g = add(g, scale(dg, modulus, gfj), gfj);
+		h = add(h, scale(dh, modulus, gfj), gfj);
+		modulus *= p;
+	}
+}
+
+/**
+ * Lifts the monic factors of f modulo p to monic factors modulo p^k by a balanced tree of two factor lifts.
+ */
+inline void lift(const Dense& f, std::vector<Dense>::const_iterator first, std::vector<Dense>::const_iterator last, unsigned p, unsigned k, std::vector<Dense>& res) {
+	if (last - first == 1) {
+		res.push_back(f);
+		return;
+	}
+	Field gfp(p);
+	auto mid = first + (last - first) / 2;
+	Dense g = std::accumulate(first, mid, Dense({1}), [&gfp](const Dense& a, const Dense& b) { return mul(a, b, gfp); });
+	Dense h = std::accumulate(mid, last, Dense({1}), [&gfp](const Dense& a, const Dense& b) { return mul(a, b, gfp); });
+	lift(f, g, h, p, k);
+	lift(g, first, mid, p, k, res);
+	lift(h, mid, last, p, k, res);
+}
+
+/**
+ * Checks whether the given combination of lifted factors yields an integer factor of f.
+ * @return The primitive factor or std::nullopt.
+ */
+inline std::optional<Dense> try_combination(const Dense& f, const std::vector<Dense>& lifted, const std::vector<std::size_t>& combination, const Field& gf) {
+	Integer lc = f.back();
+	// The trailing coefficient of the candidate has to divide the one of lc*f.
+	Integer tc = lc;
+	for (std::size_t i: combination) tc = reduce(tc * lifted[i].front(), gf);
+	if (carl::is_zero(tc)) {
+		if (!carl::is_zero(f.front())) return std::nullopt;
+	} else if (!mpz_divisible_p(Integer(lc * f.front()).get_mpz_t(), tc.get_mpz_t())) {
+		return std::nullopt;
+	}
+	Dense g = {lc};
+	for (std::size_t i: combination) g = mul(g, lifted[i], gf);
+	Integer c = content(g);
+	for (auto& coeff: g) mpz_divexact(coeff.get_mpz_t(), coeff.get_mpz_t(), c.get_mpz_t());
+	if (!divide_exact(f, g)) return std::nullopt;
+	return g;
+}
+
+/// Advances to the next subset of {0, ..., n-1} of the same size in lexicographic order.
+inline bool next_combination(std::vector<std::size_t>& combination, std::size_t n) {
+	std::size_t s = combination.size();
+	for (std::size_t i = s; i-- > 0;) {
+		if (combination[i] < n - s + i) {
+			++combination[i];
+			for (std::size_t j = i + 1; j < s; ++j) combination[j] = combination[j - 1] + 1;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Finds the first combination of s lifted factors in lexicographic order that yields a factor of f.
+ * Combinations are tested in batches, the batches are distributed over several threads if they are large enough.
+ * If 2*s equals the number of factors, only combinations containing the first factor are considered.
+ */
+inline std::optional<std::pair<std::vector<std::size_t>, Dense>> find_combination(const Dense& f, const std::vector<Dense>& lifted, std::size_t s, const Field& gf) {
+	std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+	std::size_t batch_size = threads > 1 ? parallel_threshold * threads : 1;
+	std::vector<std::size_t> combination(s);
+	std::iota(combination.begin(), combination.end(), 0);
+	bool more = true;
+	while (more) {
+		std::vector<std::vector<std::size_t>> batch;
+		while (more && batch.size() < batch_size) {
+			if (2 * s == lifted.size() && combination.front() != 0) {
+				more = false;
+				break;
+			}
+			batch.push_back(combination);
+			more = next_combination(combination, lifted.size());
+		}
+		std::vector<std::optional<Dense>> results(batch.size());
+		if (batch.size() < parallel_threshold || threads == 1) {
+			for (std::size_t i = 0; i < batch.size(); ++i) {
+				results[i] = try_combination(f, lifted, batch[i], gf);
+				if (results[i]) return std::make_pair(batch[i], std::move(*results[i]));
+			}
+			continue;
+		}
+		std::atomic<std::size_t> next = 0;
+		std::atomic<std::size_t> first = batch.size();
+		auto worker = [&]() {
+			for (std::size_t i = next++; i < batch.size() && i < first; i = next++) {
+				results[i] = try_combination(f, lifted, batch[i], gf);
+				if (!results[i]) continue;
+				std::size_t cur = first;
+				while (i < cur && !first.compare_exchange_weak(cur, i)) {}
+			}
+		};
+		std::vector<std::thread> workers;
+		for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(worker);
+		worker();
+		for (auto& w: workers) w.join();
+		if (first < batch.size()) return std::make_pair(batch[first], std::move(*results[first]));
+	}
+	return std::nullopt;
+}
+
+/**
+ * Recovers the integer factors of f from its monic factors modulo p^k.
+ */
+inline std::vector<Dense> recombine(Dense f, std::vector<Dense> lifted, const Field& gf) {
+	std::vector<Dense> res;
+	for (std::size_t s = 1; 2 * s <= lifted.size();) {
+		auto found = find_combination(f, lifted, s, gf);
+		if (!found) {
+			++s;
+			continue;
+		}
+		auto& [combination, g] = *found;
+		f = *divide_exact(f, g);
+		for (std::size_t i = combination.size(); i-- > 0;) {
+			lifted.erase(lifted.begin() + static_cast<std::ptrdiff_t>(combination[i]));
+		}
+		res.push_back(std::move(g));
+	}
+	if (f.size() > 1) res.push_back(std::move(f));
+	return res;
+}
+
+/**
+ * Returns the number of bits of a bound on the coefficients of lc(f)/lc(g) * g for every factor g of f.
+ */
+inline std::size_t coefficient_bound_bits(const Dense& f) {
+	Integer norm;
+	for (const auto& c: f) norm += c * c;
+	mpz_sqrt(norm.get_mpz_t(), norm.get_mpz_t());
+	norm += 1;
+	return mpz_sizeinbase(norm.get_mpz_t(), 2) + mpz_sizeinbase(f.back().get_mpz_t(), 2) + degree(f) + 1;
+}
+
+}
+
+/**
+ * Factors a square-free primitive integer polynomial with positive leading coefficient into its irreducible factors.
+ * The factors are primitive and have positive leading coefficients. If f is not square-free, it is returned unfactored.
+ */
+inline std::vector<Dense> factor_squarefree(const Dense& f) {
+	assert(!f.empty() && f.back() > 0);
+	if (degree(f) <= 1) return {f};
+	PrimeFactory<uint> primes;
+	std::size_t candidates = 0;
+	std::optional<std::pair<uint, std::vector<std::pair<std::size_t, Dense>>>> best;
+	std::size_t bestCount = std::numeric_limits<std::size_t>::max();
+	const Dense df = derivative(f);
+	for (std::size_t i = 1; candidates < prime_candidates && i <= max_primes; ++i) {
+		uint p = primes[i];
+		if (mpz_divisible_ui_p(f.back().get_mpz_t(), p)) continue;
+		Field gf(p);
+		Dense fp = f;
+		reduce(fp, gf);
+		if (degree(gcd(fp, remainder(df, fp, gf), gf)) > 0) continue;
+		++candidates;
+		auto ddf = detail::distinct_degree(monic(fp, gf), gf);
+		std::size_t count = 0;
+		for (const auto& [d, g]: ddf) count += degree(g) / d;
+		if (count == 1) return {f};
+		if (count < bestCount) {
+			bestCount = count;
+			best = std::make_pair(p, std::move(ddf));
+		}
+	}
+	if (!best) {
+		// f is not square-free modulo any prime, hence it is not square-free.
+		assert(false);
+		return {f};
+	}
+	uint p = best->first;
+	Field gfp(p);
+	std::mt19937 rng(p);
+	std::vector<Dense> modular;
+	for (const auto& [d, g]: best->second) {
+		detail::equal_degree(g, d, gfp, rng, modular);
+	}
+	// Choose k such that p^k exceeds twice the coefficient bound.
+	std::size_t bits = detail::coefficient_bound_bits(f) + 1;
+	unsigned k = 1;
+	for (Integer pk = p; mpz_sizeinbase(pk.get_mpz_t(), 2) <= bits; pk *= p) ++k;
+	Field gfk(p, k);
+	std::vector<Dense> lifted;
+	detail::lift(monic(f, gfk), modular.begin(), modular.end(), p, k, lifted);
+	return detail::recombine(f, std::move(lifted), gfk);
+}
+
+}
@@ -0,0 +1,535 @@
+/**
+ * @file
+ *
+ * Modular gcd of multivariate polynomials with integer or rational coefficients.
+ *
+ * Follows the dense modular algorithm of Brown, see Algorithms 7.1 and 7.2 from the book
+ * Algorithms for Computer Algebra by Geddes, Czapor, Labahn.
+ * The gcd is computed modulo several word-size primes and the results are combined by Chinese remaindering.
+ * Modulo a prime, the last variable is evaluated at several points, the gcds of the images are computed recursively
+ * and interpolated. The images for the outermost variable are independent and computed in parallel if this is worth the work.
+ * Unlucky primes and evaluation points are detected by comparing the leading monomials of the images, the final
+ * result is verified by trial division.
+ */
+
+#pragma once
+
+#include "../MultivariatePolynomial.h"
+
+#include <carl-arith/core/Variables.h>
+#include <carl-arith/numbers/numbers.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace carl::brown {
+
+/**
+ * Minimal estimated work for every thread that computes images for the outermost variable.
+ * The work is estimated as the number of images times the number of dense coefficients of the operands.
+ */
+constexpr std::size_t parallel_work = std::size_t(1) << 12;
+
+using Word = std::uint64_t;
+/// A dense univariate polynomial modulo a prime, the coefficient of y^i is at position i. The zero polynomial is empty.
+using Dense = std::vector<Word>;
+/// The exponents of all variables of a polynomial.
+using Exponents = std::vector<uint>;
+/// A sparse polynomial, the terms are sorted by their exponents in increasing lexicographic order.
+template<typename Coeff>
+using Sparse = std::vector<std::pair<Exponents, Coeff>>;
+
+/**
+ * Arithmetic modulo a prime below 2^32, such that products fit into a Word.
+ */
+class Prime {
+	Word mP;
+public:
+	explicit Prime(Word p): mP(p) {}
+	Word p() const {
+		return mP;
+	}
+	Word add(Word a, Word b) const {
+		Word res = a + b;
+		return res >= mP ? res - mP : res;
+	}
+	Word sub(Word a, Word b) const {
+		return a >= b ? a - b : a + mP - b;
+	}
+	Word mul(Word a, Word b) const {
+		return (a * b) % mP;
+	}
+	Word pow(Word a, Word e) const {
+		Word res = 1;
+		for (; e > 0; e >>= 1) {
+			if (e & 1) res = mul(res, a);
+			a = mul(a, a);
+		}
+		return res;
+	}
+	Word inverse(Word a) const {
+		assert(a != 0);
+		return pow(a, mP - 2);
+	}
+	Word reduce(const mpz_class& n) const {
+		return mpz_fdiv_ui(n.get_mpz_t(), static_cast<unsigned long>(mP));
+	}
+};
+
+namespace detail {
+
+inline void trim(Dense& a) {
+	while (!a.empty() && a.back() == 0) a.pop_back();
+}
+
+inline std::size_t degree(const Dense& a) {
+	assert(!a.empty());
+	return a.size() - 1;
+}
+
+inline Word evaluate(const Dense& a, Word x, const Prime& p) {
+	Word res = 0;
+	for (std::size_t i = a.size(); i-- > 0;) res = p.add(p.mul(res, x), a[i]);
+	return res;
+}
+
+inline Dense scale(Dense a, Word c, const Prime& p) {
+	for (auto& coeff: a) coeff = p.mul(coeff, c);
+	trim(a);
+	return a;
+}
+
+inline Dense mul(const Dense& a, const Dense& b, const Prime& p) {
+	if (a.empty() || b.empty()) return Dense();
+	Dense res(a.size() + b.size() - 1);
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		if (a[i] == 0) continue;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			res[i + j] = p.add(res[i + j], p.mul(a[i], b[j]));
+		}
+	}
+	trim(res);
+	return res;
+}
+
+/**
+ * Division with remainder.
+ * @return Quotient and remainder.
+ */
+inline std::pair<Dense, Dense> divide(Dense a, const Dense& b, const Prime& p) {
+	assert(!b.empty());
+	if (a.size() < b.size()) return std::make_pair(Dense(), std::move(a));
+	Word inv = p.inverse(b.back());
+	Dense q(a.size() - b.size() + 1);
+	for (std::size_t k = q.size(); k-- > 0;) {
+		q[k] = p.mul(a[k + b.size() - 1], inv);
+		if (q[k] == 0) continue;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			a[k + j] = p.sub(a[k + j], p.mul(q[k], b[j]));
+		}
+	}
+	a.resize(b.size() - 1);
+	trim(a);
+	trim(q);
+	return std::make_pair(std::move(q), std::move(a));
+}
+
+inline Dense monic(const Dense& a, const Prime& p) {
+	if (a.empty()) return a;
+	return scale(a, p.inverse(a.back()), p);
+}
+
+/// The monic gcd.
+inline Dense gcd(Dense a, Dense b, const Prime& p) {
+	while (!b.empty()) {
+		Dense r = divide(a, b, p).second;
+		a = std::move(b);
+		b = std::move(r);
+	}
+	return monic(a, p);
+}
+
+/// The coefficients with respect to the last of the first k variables, indexed by the exponents of the other ones.
+using Coefficients = std::map<Exponents, Dense>;
+
+inline Coefficients coefficients(const Sparse<Word>& a, std::size_t k) {
+	Coefficients res;
+	for (const auto& [exp, c]: a) {
+		Exponents e = exp;
+		uint d = e[k - 1];
+		e[k - 1] = 0;
+		Dense& coeff = res[e];
+		if (coeff.size() <= d) coeff.resize(d + 1);
+		coeff[d] = c;
+	}
+	return res;
+}
+
+inline Sparse<Word> from_coefficients(const Coefficients& coeffs, std::size_t k) {
+	Sparse<Word> res;
+	for (const auto& [exp, coeff]: coeffs) {
+		for (std::size_t d = 0; d < coeff.size(); ++d) {
+			if (coeff[d] == 0) continue;
+			res.emplace_back(exp, coeff[d]);
+			res.back().first[k - 1] = static_cast<uint>(d);
+		}
+	}
+	std::sort(res.begin(), res.end());
+	return res;
+}
+
+/// The monic gcd of all coefficients.
+inline Dense content(const Coefficients& coeffs, const Prime& p) {
+	Dense res;
+	for (const auto& [exp, coeff]: coeffs) {
+		res = gcd(std::move(res), coeff, p);
+		if (res.size() == 1) break;
+	}
+	return res;
+}
+
+/// Evaluates the last of the first k variables.
+inline Sparse<Word> evaluate(const Coefficients& coeffs, Word x, const Prime& p) {
+	Sparse<Word> res;
+	for (const auto& [exp, coeff]: coeffs) {
+		Word c = evaluate(coeff, x, p);
+		if (c != 0) res.emplace_back(exp, c);
+	}
+	return res;
+}
+
+inline bool is_constant(const Sparse<Word>& a) {
+	return a.size() == 1 && std::all_of(a.front().first.begin(), a.front().first.end(), [](uint e) { return e == 0; });
+}
+
+/// The polynomial in the first k variables that is the given univariate polynomial in the last of them.
+inline Sparse<Word> from_dense(const Dense& a, std::size_t n, std::size_t k) {
+	Coefficients coeffs;
+	coeffs.emplace(Exponents(n, 0), a);
+	return from_coefficients(coeffs, k);
+}
+
+/// Whether b divides a, both are nonzero.
+inline bool divides(const Sparse<Word>& a, const Sparse<Word>& b, const Prime& p) {
+	std::map<Exponents, Word> remainder(a.begin(), a.end());
+	const auto& [lm, lc] = b.back();
+	Word inv = p.inverse(lc);
+	Exponents e(lm.size());
+	while (!remainder.empty()) {
+		auto it = std::prev(remainder.end());
+		for (std::size_t i = 0; i < e.size(); ++i) {
+			if (it->first[i] < lm[i]) return false;
+			e[i] = it->first[i] - lm[i];
+		}
+		Word c = p.mul(it->second, inv);
+		for (const auto& [exp, coeff]: b) {
+			Exponents m = exp;
+			for (std::size_t i = 0; i < m.size(); ++i) m[i] += e[i];
+			auto r = remainder.try_emplace(std::move(m), 0).first;
+			r->second = p.sub(r->second, p.mul(c, coeff));
+			if (r->second == 0) remainder.erase(r);
+		}
+	}
+	return true;
+}
+
+/**
+ * Computes the monic gcd of two nonzero polynomials in the first k variables (Algorithm 7.2).
+ * The interpolated gcd is verified by trial division, as all evaluation points may be unlucky.
+ * If parallel is set, the images for the last variable are computed in parallel.
+ */
+inline Sparse<Word> gcd(const Sparse<Word>& a, const Sparse<Word>& b, std::size_t k, const Prime& p, bool parallel) {
+	assert(!a.empty() && !b.empty());
+	std::size_t n = a.front().first.size();
+	Coefficients ca = coefficients(a, k);
+	Coefficients cb = coefficients(b, k);
+	if (k == 1) {
+		return from_dense(gcd(ca.begin()->second, cb.begin()->second, p), n, k);
+	}
+	Dense contA = content(ca, p);
+	Dense contB = content(cb, p);
+	Dense cont = gcd(contA, contB, p);
+	std::size_t degA = 0;
+	std::size_t degB = 0;
+	for (auto& [exp, coeff]: ca) {
+		coeff = divide(coeff, contA, p).first;
+		degA = std::max(degA, degree(coeff));
+	}
+	for (auto& [exp, coeff]: cb) {
+		coeff = divide(coeff, contB, p).first;
+		degB = std::max(degB, degree(coeff));
+	}
+	// The work to compute a single image, estimated by the number of dense coefficients.
+	std::size_t imageWork = 0;
+	for (const auto& [exp, coeff]: ca) imageWork += coeff.size();
+	for (const auto& [exp, coeff]: cb) imageWork += coeff.size();
+	auto with_content = [&](Coefficients& coeffs) {
+		for (auto& [exp, coeff]: coeffs) coeff = mul(coeff, cont, p);
+		Sparse<Word> res = from_coefficients(coeffs, k);
+		Word inv = p.inverse(res.back().second);
+		for (auto& t: res) t.second = p.mul(t.second, inv);
+		return res;
+	};
+	if (degA == 0 && degB == 0) {
+		Coefficients res = coefficients(gcd(evaluate(ca, 0, p), evaluate(cb, 0, p), k - 1, p, parallel), k);
+		return with_content(res);
+	}
+	Dense g = gcd(ca.rbegin()->second, cb.rbegin()->second, p);
+	std::size_t bound = std::min(degA, degB) + degree(g);
+
+	// The interpolated gcd, scaled such that its leading coefficient is g.
+	Coefficients result;
+	Exponents leading;
+	Dense modulus = {1};
+	std::size_t count = 0;
+	Word next = 1;
+	// Removes the content of the interpolated gcd, which is the gcd of the primitive parts if it divides them.
+	auto candidate = [&]() -> std::optional<Coefficients> {
+		Coefficients res;
+		for (const auto& [exp, coeff]: result) {
+			if (!coeff.empty()) res.emplace(exp, coeff);
+		}
+		Dense c = content(res, p);
+		for (auto& [exp, coeff]: res) coeff = divide(coeff, c, p).first;
+		Sparse<Word> s = from_coefficients(res, k);
+		if (divides(from_coefficients(ca, k), s, p) && divides(from_coefficients(cb, k), s, p)) return res;
+		return std::nullopt;
+	};
+	while (true) {
+		std::vector<Word> points;
+		std::size_t needed = count <= bound ? bound + 1 - count : 1;
+		while (points.size() < needed) {
+			if (next == p.p()) {
+				CARL_LOG_WARN("carl.core.gcd", "Ran out of evaluation points modulo " << p.p());
+				return from_dense({1}, n, k);
+			}
+			if (evaluate(g, next, p) != 0) points.push_back(next);
+			++next;
+		}
+		std::vector<Sparse<Word>> images(points.size());
+		auto image = [&](std::size_t i) {
+			images[i] = gcd(evaluate(ca, points[i], p), evaluate(cb, points[i], p), k - 1, p, false);
+		};
+		std::size_t threads = 1;
+		if (parallel) {
+			threads = std::min<std::size_t>({std::max(1u, std::thread::hardware_concurrency()), points.size(), points.size() * imageWork / parallel_work});
+		}
+		if (threads > 1) {
+			std::atomic<std::size_t> index = 0;
+			auto worker = [&]() {
+				for (std::size_t i = index++; i < points.size(); i = index++) image(i);
+			};
+			std::vector<std::thread> workers;
+			for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(worker);
+			worker();
+			for (auto& w: workers) w.join();
+		} else {
+			for (std::size_t i = 0; i < points.size(); ++i) image(i);
+		}
+		for (std::size_t i = 0; i < points.size(); ++i) {
+			const Sparse<Word>& img = images[i];
+			if (is_constant(img)) {
+				Coefficients res;
+				res.emplace(Exponents(n, 0), Dense({1}));
+				return with_content(res);
+			}
+			if (count > 0 && leading < img.back().first) continue;
+			Word scaling = evaluate(g, points[i], p);
+			if (count == 0 || img.back().first < leading) {
+				// All previous points were unlucky.
+				result.clear();
+				for (const auto& [exp, c]: img) result.emplace(exp, Dense({p.mul(c, scaling)}));
+				leading = img.back().first;
+				modulus = {p.sub(0, points[i]), 1};
+				count = 1;
+			} else {
+				// Newton interpolation
+				for (const auto& t: img) result.try_emplace(t.first);
+				Word inv = p.inverse(evaluate(modulus, points[i], p));
+				auto it = img.begin();
+				for (auto& [exp, coeff]: result) {
+					Word value = 0;
+					if (it != img.end() && it->first == exp) value = p.mul(it++->second, scaling);
+					Word delta = p.mul(p.sub(value, evaluate(coeff, points[i], p)), inv);
+					if (delta == 0) continue;
+					Dense d = scale(modulus, delta, p);
+					if (coeff.size() < d.size()) coeff.resize(d.size());
+					for (std::size_t j = 0; j < d.size(); ++j) coeff[j] = p.add(coeff[j], d[j]);
+					trim(coeff);
+				}
+				modulus = mul(modulus, Dense({p.sub(0, points[i]), 1}), p);
+				++count;
+			}
+			// If all points so far were unlucky, more points are needed.
+			if (count > bound) {
+				if (auto res = candidate()) return with_content(*res);
+			}
+		}
+	}
+}
+
+inline Word next_prime(Word p) {
+	mpz_class n(static_cast<unsigned long>(p));
+	do {
+		--n;
+	} while (mpz_probab_prime_p(n.get_mpz_t(), 25) == 0);
+	return n.get_ui();
+}
+
+/// Whether b divides a over the integers, both are nonzero.
+inline bool divides(const Sparse<mpz_class>& a, const Sparse<mpz_class>& b) {
+	std::map<Exponents, mpz_class> remainder(a.begin(), a.end());
+	const auto& [lm, lc] = b.back();
+	Exponents e(lm.size());
+	mpz_class c;
+	while (!remainder.empty()) {
+		auto it = std::prev(remainder.end());
+		for (std::size_t i = 0; i < e.size(); ++i) {
+			if (it->first[i] < lm[i]) return false;
+			e[i] = it->first[i] - lm[i];
+		}
+		if (!mpz_divisible_p(it->second.get_mpz_t(), lc.get_mpz_t())) return false;
+		mpz_divexact(c.get_mpz_t(), it->second.get_mpz_t(), lc.get_mpz_t());
+		for (const auto& [exp, coeff]: b) {
+			Exponents m = exp;
+			for (std::size_t i = 0; i < m.size(); ++i) m[i] += e[i];
+			auto r = remainder.try_emplace(std::move(m), 0).first;
+			r->second -= c * coeff;
+			if (carl::is_zero(r->second)) remainder.erase(r);
+		}
+	}
+	return true;
+}
+
+/**
+ * Computes the gcd of two nonzero primitive integer polynomials up to its sign (Algorithm 7.1).
+ */
+inline Sparse<mpz_class> gcd(const Sparse<mpz_class>& a, const Sparse<mpz_class>& b) {
+	std::size_t n = a.front().first.size();
+	mpz_class g = carl::gcd(a.back().second, b.back().second);
+	Sparse<mpz_class> result;
+	Sparse<mpz_class> last;
+	mpz_class modulus;
+	for (Word prime = 1ul << 31;;) {
+		prime = next_prime(prime);
+		Prime p(prime);
+		if (p.reduce(a.back().second) == 0 || p.reduce(b.back().second) == 0) continue;
+		auto reduce = [&p](const Sparse<mpz_class>& s) {
+			Sparse<Word> res;
+			for (const auto& [exp, c]: s) {
+				Word r = p.reduce(c);
+				if (r != 0) res.emplace_back(exp, r);
+			}
+			return res;
+		};
+		Sparse<Word> image = gcd(reduce(a), reduce(b), n, p, true);
+		if (is_constant(image)) return { std::make_pair(Exponents(n, 0), mpz_class(1)) };
+		Word scaling = p.reduce(g);
+		if (!result.empty() && result.back().first < image.back().first) continue;
+		if (result.empty() || image.back().first < result.back().first) {
+			// All previous primes were unlucky.
+			result.clear();
+			for (const auto& [exp, c]: image) result.emplace_back(exp, mpz_class(static_cast<unsigned long>(p.mul(c, scaling))));
+			modulus = static_cast<unsigned long>(prime);
+			last.clear();
+		} else {
+			// Chinese remaindering, coefficients are kept in [0, modulus).
+			Word inv = p.inverse(p.reduce(modulus));
+			Sparse<mpz_class> combined;
+			auto it = image.begin();
+			auto combine = [&](const Exponents& exp, const mpz_class& h, Word c) {
+				Word delta = p.mul(p.sub(p.mul(c, scaling), p.reduce(h)), inv);
+				combined.emplace_back(exp, h + modulus * static_cast<unsigned long>(delta));
+			};
+			for (const auto& [exp, h]: result) {
+				for (; it != image.end() && it->first < exp; ++it) combine(it->first, 0, it->second);
+				if (it != image.end() && it->first == exp) combine(exp, h, it++->second);
+				else combine(exp, h, 0);
+			}
+			for (; it != image.end(); ++it) combine(it->first, 0, it->second);
+			result = std::move(combined);
+			modulus *= static_cast<unsigned long>(prime);
+		}
+		// The candidate in the symmetric range, it is only checked once it does not change anymore.
+		Sparse<mpz_class> candidate;
+		mpz_class half = modulus / 2;
+		mpz_class content;
+		for (const auto& [exp, c]: result) {
+			if (carl::is_zero(c)) continue;
+			candidate.emplace_back(exp, c > half ? mpz_class(c - modulus) : c);
+			content = carl::gcd(content, candidate.back().second);
+		}
+		if (candidate != last) {
+			last = std::move(candidate);
+			continue;
+		}
+		for (auto& t: candidate) t.second /= content;
+		if (divides(a, candidate) && divides(b, candidate)) return candidate;
+	}
+}
+
+}
+
+/**
+ * Computes the gcd of two nonzero polynomials with integer or rational coefficients by the modular algorithm.
+ * The integer content of the result is the gcd of the integer contents of the inputs for integer coefficients
+ * and one for rational coefficients. The leading coefficient of the result is positive.
+ */
+template<typename C, typename O, typename P>
+MultivariatePolynomial<C,O,P> gcd(const MultivariatePolynomial<C,O,P>& a, const MultivariatePolynomial<C,O,P>& b) {
+	using Poly = MultivariatePolynomial<C,O,P>;
+	carlVariables allVars;
+	carl::variables(a, allVars);
+	carl::variables(b, allVars);
+	auto vars = allVars.as_vector();
+	// Primitive integer polynomials.
+	auto convert = [&vars](const Poly& p, mpz_class& content) {
+		mpz_class denominator = 1;
+		if constexpr (std::is_same_v<C, mpq_class>) {
+			for (const auto& t: p) denominator = carl::lcm(denominator, carl::get_denom(t.coeff()));
+		}
+		Sparse<mpz_class> res;
+		content = 0;
+		for (const auto& t: p) {
+			Exponents exp(vars.size(), 0);
+			if (t.monomial() != nullptr) {
+				for (const auto& [v, e]: *t.monomial()) {
+					exp[static_cast<std::size_t>(std::lower_bound(vars.begin(), vars.end(), v) - vars.begin())] = e;
+				}
+			}
+			if constexpr (std::is_same_v<C, mpq_class>) {
+				res.emplace_back(std::move(exp), mpz_class(carl::get_num(t.coeff()) * (denominator / carl::get_denom(t.coeff()))));
+			} else {
+				res.emplace_back(std::move(exp), t.coeff());
+			}
+			content = carl::gcd(content, res.back().second);
+		}
+		for (auto& t: res) t.second /= content;
+		std::sort(res.begin(), res.end());
+		return res;
+	};
+	mpz_class contentA;
+	mpz_class contentB;
+	Sparse<mpz_class> ia = convert(a, contentA);
+	Sparse<mpz_class> ib = convert(b, contentB);
+	mpz_class content = 1;
+	if constexpr (std::is_same_v<C, mpz_class>) content = carl::gcd(contentA, contentB);
+	typename Poly::TermsType terms;
+	for (const auto& [exp, c]: detail::gcd(ia, ib)) {
+		std::vector<std::pair<Variable, exponent>> monomial;
+		for (std::size_t i = 0; i < exp.size(); ++i) {
+			if (exp[i] > 0) monomial.emplace_back(vars[i], exp[i]);
+		}
+		if (monomial.empty()) terms.emplace_back(C(c * content));
+		else terms.emplace_back(C(c * content), createMonomial(std::move(monomial)));
+	}
+	Poly res(std::move(terms));
+	return carl::is_negative(res.lcoeff()) ? Poly(-res) : res;
+}
+
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <carl-common/config.h>
+#include <carl-arith/memo/Memoization.h>
+#include <carl-arith/trace/carl-recording.h>
+#include <carl-statistics/carl-profiling.h>
+#include "GCD_modular.h"
 #include "PrimitiveEuclidean.h"
 #include <carl-arith/numbers/typetraits.h>
 #include <carl-arith/poly/umvpoly/functions/to_univariate_polynomial.h>
@@ -58,6 +62,8 @@ MultivariatePolynomial<C,O,P> gcd(const MultivariatePolynomial<C,O,P>& a, const
 	if (a.is_constant() || b.is_constant()) {
 		return MultivariatePolynomial<C,O,P>(1);
 	}
+	CARL_PROFILE_ZONE("poly.gcd");
+	CARL_RECORD(GCD, a, b);
 
 	auto s = overloaded {
 	#if defined USE_GINAC
@@ -65,15 +71,15 @@ MultivariatePolynomial<C,O,P> gcd(const MultivariatePolynomial<C,O,P>& a, const
 		[](const MultivariatePolynomial<cln::cl_I,O,P>& n1, const MultivariatePolynomial<cln::cl_I,O,P>& n2){ return ginacGcd<MultivariatePolynomial<cln::cl_I,O,P>>( n1, n2 ); },
 	#endif
 	#if defined USE_COCOA
-		[](const MultivariatePolynomial<mpq_class,O,P>& n1, const MultivariatePolynomial<mpq_class,O,P>& n2){ CoCoAAdaptor<MultivariatePolynomial<mpq_class,O,P>> c({n1, n2}); return c.gcd(n1,n2); },
-		[](const MultivariatePolynomial<mpz_class,O,P>& n1, const MultivariatePolynomial<mpz_class,O,P>& n2){ CoCoAAdaptor<MultivariatePolynomial<mpz_class,O,P>> c({n1, n2}); return c.gcd(n1,n2); }
+		[](const MultivariatePolynomial<mpq_class,O,P>& n1, const MultivariatePolynomial<mpq_class,O,P>& n2){ return CoCoAAdaptorContext<MultivariatePolynomial<mpq_class,O,P>>::get().adaptor(n1, n2)->gcd(n1,n2); },
+		[](const MultivariatePolynomial<mpz_class,O,P>& n1, const MultivariatePolynomial<mpz_class,O,P>& n2){ return CoCoAAdaptorContext<MultivariatePolynomial<mpz_class,O,P>>::get().adaptor(n1, n2)->gcd(n1,n2); }
 	#else
-		[](const MultivariatePolynomial<mpq_class,O,P>& n1, const MultivariatePolynomial<mpq_class,O,P>& n2){ return gcd_detail::gcd_calculate(n1,n2); },
-		[](const MultivariatePolynomial<mpz_class,O,P>& n1, const MultivariatePolynomial<mpz_class,O,P>& n2){ return gcd_detail::gcd_calculate(n1,n2); }
+		[](const MultivariatePolynomial<mpq_class,O,P>& n1, const MultivariatePolynomial<mpq_class,O,P>& n2){ return brown::gcd(n1,n2); },
+		[](const MultivariatePolynomial<mpz_class,O,P>& n1, const MultivariatePolynomial<mpz_class,O,P>& n2){ return brown::gcd(n1,n2); }
 	#endif
 	};
 	CARL_LOG_DEBUG("carl.core.gcd", "gcd(" << a << ", " << b << ")");
-	auto res = s(a, b);
+	auto res = memo::memoized<MultivariatePolynomial<C,O,P>>(memo::Operation::GCD, 0, [&s, &a, &b]() { return s(a, b); }, a, b);
 	CARL_LOG_DEBUG("carl.core.gcd", "gcd(" << a << ", " << b << ") = " << res);
 	return res;
 }
@@ -9,6 +9,9 @@
 #include "Remainder.h"
 #include "to_univariate_polynomial.h"
 
+#include <carl-arith/trace/carl-recording.h>
+#include <carl-statistics/carl-profiling.h>
+
 #include <list>
 #include <vector>
 
@@ -292,6 +295,8 @@ UnivariatePolynomial<Coeff> resultant(
 	SubresultantStrategy strategy) {
 	assert(p.main_var() == q.main_var());
 	if (carl::is_zero(p) || carl::is_zero(q)) return UnivariatePolynomial<Coeff>(p.main_var());
+	CARL_PROFILE_ZONE("poly.resultant");
+	CARL_RECORD(Resultant, p, q);
 
 	UnivariatePolynomial<Coeff> res = subresultants(p.normalized(), q.normalized(), strategy).front();
 
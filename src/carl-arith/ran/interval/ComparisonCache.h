@@ -0,0 +1,108 @@
+#pragma once
+
+#include <carl-common/config.h>
+#include <carl-common/memory/Singleton.h>
+#include <carl-common/util/hash.h>
+#include <carl-arith/core/Sign.h>
+
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#ifdef THREAD_SAFE
+#include <mutex>
+#endif
+
+namespace carl::ran::interval {
+
+/**
+ * Caches the outcome of comparisons of interval-represented real algebraic numbers that needed refinements or gcd computations.
+ *
+ * Entries are keyed by the identifiers of the shared contents of the numbers.
+ * The identifiers are never reused and the represented numbers never change, hence entries never become invalid.
+ * To bound the memory consumption, the cache is cleared whenever it exceeds its capacity.
+ */
+class ComparisonCache : public Singleton<ComparisonCache> {
+	friend Singleton<ComparisonCache>;
+	using Key = std::pair<std::size_t, std::size_t>;
+	struct KeyHash {
+		std::size_t operator()(const Key& key) const {
+			return carl::hash_all(key.first, key.second);
+		}
+	};
+
+	/// Maps (lhs,rhs) with lhs < rhs to the sign of lhs - rhs.
+	std::unordered_map<Key, Sign, KeyHash> mCache;
+	std::size_t mCapacity = 65536;
+	std::size_t mHits = 0;
+#ifdef THREAD_SAFE
+	mutable std::mutex mMutex;
+	#define RAN_COMPARISON_CACHE_LOCK_GUARD std::lock_guard<std::mutex> lock(mMutex);
+#else
+	#define RAN_COMPARISON_CACHE_LOCK_GUARD
+#endif
+
+	ComparisonCache() = default;
+
+	static Sign negated(Sign sign) {
+		return static_cast<Sign>(-static_cast<int>(sign));
+	}
+public:
+	/**
+	 * Returns a fresh identifier for the content of a real algebraic number.
+	 */
+	static std::size_t next_id() {
+		static std::atomic<std::size_t> id = 1;
+		return id++;
+	}
+
+	/**
+	 * Returns the sign of lhs - rhs if it is known.
+	 */
+	std::optional<Sign> get(std::size_t lhs, std::size_t rhs) {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		if (lhs > rhs) {
+			auto res = get_ordered(rhs, lhs);
+			if (res) return negated(*res);
+			return std::nullopt;
+		}
+		return get_ordered(lhs, rhs);
+	}
+	/**
+	 * Stores the sign of lhs - rhs.
+	 */
+	void set(std::size_t lhs, std::size_t rhs, Sign sign) {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		if (mCache.size() >= mCapacity) mCache.clear();
+		if (lhs > rhs) mCache[Key(rhs, lhs)] = negated(sign);
+		else mCache[Key(lhs, rhs)] = sign;
+	}
+
+	void clear() {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		mCache.clear();
+	}
+	std::size_t size() const {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		return mCache.size();
+	}
+	/// Number of comparisons answered by the cache.
+	std::size_t hits() const {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		return mHits;
+	}
+	void set_capacity(std::size_t capacity) {
+		RAN_COMPARISON_CACHE_LOCK_GUARD
+		mCapacity = capacity;
+		if (mCache.size() > mCapacity) mCache.clear();
+	}
+private:
+	std::optional<Sign> get_ordered(std::size_t lhs, std::size_t rhs) {
+		auto it = mCache.find(Key(lhs, rhs));
+		if (it == mCache.end()) return std::nullopt;
+		++mHits;
+		return it->second;
+	}
+};
+
+}
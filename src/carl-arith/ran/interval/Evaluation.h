@@ -5,6 +5,7 @@
 #include <carl-arith/interval/Evaluation.h>
 #include <carl-arith/constraint/BasicConstraint.h>
 #include <carl-arith/constraint/Simplification.h>
+#include <carl-arith/core/DenseAssignment.h>
 
 #include "Ran.h"
 #include "helper/AlgebraicSubstitution.h"
@@ -16,35 +17,67 @@
 
 namespace carl {
 
+namespace ran::interval::detail {
+
 /**
- * Evaluate the given polynomial with the given values for the variables.
- * Asserts that all variables of p have an assignment in m and that m has no additional assignments.
- * 
- * Returns std::nullopt if some unassigned variables are still contained in p after plugging in m.
- *
- * @param p Polynomial to be evaluated
- * @param m Variable assignment
- * @return Evaluation result
+ * Calls f(var, ran) for every variable that is assigned in m and still occurs in p.
+ * p is checked before every call, hence f may substitute into p.
  */
-template<typename Number>
-std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial<Number> p, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true) {
+template<typename Number, typename F>
+void for_each_assigned(const MultivariatePolynomial<Number>& p, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, F&& f) {
+	for (const auto& [var, ran] : m) {
+		if (p.has(var)) f(var, ran);
+	}
+}
+/**
+ * Calls f(var, ran) for every variable that is assigned in m and still occurs in p.
+ * Only the variables of p are looked up, hence the size of the whole assignment does not matter.
+ */
+template<typename Number, typename F>
+void for_each_assigned(const MultivariatePolynomial<Number>& p, const DenseAssignment<IntRepRealAlgebraicNumber<Number>>& m, F&& f) {
+	for (Variable var : carl::variables(p)) {
+		if (!p.has(var)) continue;
+		if (const auto* ran = m.get(var)) f(var, *ran);
+	}
+}
+
+/**
+ * Refines the numbers assigned to the variables in var_to_interval and updates p and var_to_interval accordingly.
+ */
+template<typename Number, typename A>
+void refine_intervals(MultivariatePolynomial<Number>& p, const A& m, std::map<Variable, Interval<Number>>& var_to_interval) {
+	std::vector<Variable> vars;
+	for (const auto& entry : var_to_interval) vars.push_back(entry.first);
+	for (Variable var : vars) {
+		auto it = var_to_interval.find(var);
+		if (it == var_to_interval.end()) continue;
+		const auto& ran = m.at(var);
+		ran.refine();
+		if (ran.is_numeric()) {
+			substitute_inplace(p, var, MultivariatePolynomial<Number>(ran.value()));
+			std::erase_if(var_to_interval, [&p](const auto& entry) { return !p.has(entry.first); });
+		} else {
+			it->second = ran.interval();
+		}
+	}
+}
+
+/// Evaluates a polynomial, see carl::evaluate().
+template<typename Number, typename A>
+std::optional<IntRepRealAlgebraicNumber<Number>> evaluate_polynomial(MultivariatePolynomial<Number> p, const A& m, bool refine_model) {
 	CARL_LOG_DEBUG("carl.ran.interval", "Evaluating " << p << " on " << m);
 	
 	CARL_LOG_TRACE("carl.ran.interval", "Substitute rationals");
-	for (const auto& [var, ran] : m) {
-		if (!p.has(var)) continue;
+	for_each_assigned(p, m, [&](Variable var, const auto& ran) {
 		if (refine_model) {
 			CARL_LOG_TRACE("carl.ran.interval", "Refine " << var << " = " << ran);
-			static Number min_width = Number(1) / (Number(1048576)); // 1/2^20, taken from libpoly
-			while (!ran.is_numeric() && ran.interval().diameter() > min_width) {
-				ran.refine();
-			}
+			ran.refine_to_precision(20); // 1/2^20, taken from libpoly
 		}
 		if (ran.is_numeric()) {
 			CARL_LOG_TRACE("carl.ran.interval", "Substitute " << var << " = " << ran);
 			substitute_inplace(p, var, MultivariatePolynomial<Number>(ran.value()));
 		} 
-	}
+	});
     if (p.is_number()) {
 		CARL_LOG_DEBUG("carl.ran.interval", "Returning " << p.constant_part());
         return IntRepRealAlgebraicNumber<Number>(p.constant_part());
@@ -54,12 +87,10 @@ std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial
 
 	CARL_LOG_TRACE("carl.ran.interval", "Create interval map");
 	std::map<Variable, Interval<Number>> var_to_interval;
-	for (const auto& [var, ran] : m) {
-		if (p.has(var)) {
-			assert(!ran.is_numeric());
-			var_to_interval.emplace(var, ran.interval());
-		}
-	}
+	for_each_assigned(p, m, [&](Variable var, const auto& ran) {
+		assert(!ran.is_numeric());
+		var_to_interval.emplace(var, ran.interval());
+	});
 	CARL_LOG_TRACE("carl.ran.interval", "Interval map: " << var_to_interval);
 
     assert(!var_to_interval.empty());
@@ -85,10 +116,10 @@ std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial
 	CARL_LOG_TRACE("carl.ran.interval", "Compute result polynomial");
 	static Variable v = fresh_real_variable();
 	std::vector<UnivariatePolynomial<MultivariatePolynomial<Number>>> algebraic_information;
-	for (const auto& [var, ran] : m) {
-		if (var_to_interval.find(var) == var_to_interval.end()) continue;
+	for (const auto& entry : var_to_interval) {
+		const auto& ran = m.at(entry.first);
 		assert(!ran.is_numeric());
-		algebraic_information.emplace_back(replace_main_variable(ran.polynomial_int(), var).template convert<MultivariatePolynomial<Number>>());
+		algebraic_information.emplace_back(replace_main_variable(ran.polynomial_int(), entry.first).template convert<MultivariatePolynomial<Number>>());
 	}
 	// substitute RANs with low degrees first
 	std::sort(algebraic_information.begin(), algebraic_information.end(), [](const auto& a, const auto& b){ 
@@ -115,18 +146,7 @@ std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial
 	while (!interval.is_point_interval() && (carl::is_root_of(*res, interval.lower()) || carl::is_root_of(*res, interval.upper()) || count_real_roots(sturm_seq, interval) != 1)) {
 		CARL_LOG_TRACE("carl.ran.interval", "Refinement step");
 		// refine the result interval until it isolates exactly one real root of the result polynomial
-		for (const auto& [var, ran] : m) {
-			if (var_to_interval.find(var) == var_to_interval.end()) continue;
-			ran.refine();
-			if (ran.is_numeric()) {
-				substitute_inplace(p, var, MultivariatePolynomial<Number>(ran.value()));
-				for (const auto& entry : m) {
-					if (!p.has(entry.first)) var_to_interval.erase(entry.first);
-				}
-			} else {
-				var_to_interval[var] = ran.interval();
-			}
-		}
+		refine_intervals(p, m, var_to_interval);
 		CARL_LOG_TRACE("carl.ran.interval", "Interval evaluation");
 		interval = carl::evaluate(p, var_to_interval);
 	}
@@ -138,13 +158,14 @@ std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial
 	}
 }
 
-template<typename Number>
-boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true, bool use_root_bounds = true) {
+/// Evaluates a constraint, see carl::evaluate().
+template<typename Number, typename A>
+boost::tribool evaluate_constraint(const BasicConstraint<MultivariatePolynomial<Number>>& c, const A& m, bool refine_model, bool use_root_bounds) {
 	CARL_LOG_DEBUG("carl.ran.interval", "Evaluating " << c << " on " << m);
 	
 	if (!use_root_bounds) {
 		CARL_LOG_DEBUG("carl.ran.interval", "Evaluate constraint by evaluating poly");
-		auto res = evaluate(c.lhs(), m);
+		auto res = evaluate_polynomial(c.lhs(), m, true);
 		if (!res) return boost::indeterminate;
 		else return evaluate(sgn(res), c.relation());
 	} else {
@@ -152,19 +173,15 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 
 		CARL_LOG_TRACE("carl.ran.interval", "p = " << p);
 
-		for (const auto& [var, ran] : m) {
-			if (!p.has(var)) continue;
+		for_each_assigned(p, m, [&](Variable var, const auto& ran) {
 			if (refine_model) {
-				static Number min_width = Number(1) / (Number(1048576)); // 1/2^20, taken from libpoly
-				while (!ran.is_numeric() && ran.interval().diameter() > min_width) {
-					ran.refine();
-				}
+				ran.refine_to_precision(20); // 1/2^20, taken from libpoly
 			}
 			if (ran.is_numeric()) {
 				substitute_inplace(p, var, MultivariatePolynomial<Number>(ran.value()));
 				CARL_LOG_TRACE("carl.ran.interval", "Substituting numeric value p["<<ran.value()<<"/"<<var<<"] = " << p);
 			}
-		}
+		});
 		
 		if (p.is_number()) {
 			CARL_LOG_DEBUG("carl.ran.interval", "Left hand side is constant");
@@ -179,12 +196,10 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 		CARL_LOG_TRACE("carl.ran.interval", "p = " << p << " (after simplification)");
 
 		std::map<Variable, Interval<Number>> var_to_interval;
-		for (const auto& [var, ran] : m) {
-			if (p.has(var)) {
-				assert(!ran.is_numeric());
-				var_to_interval.emplace(var, ran.interval());
-			}
-		}
+		for_each_assigned(p, m, [&](Variable var, const auto& ran) {
+			assert(!ran.is_numeric());
+			var_to_interval.emplace(var, ran.interval());
+		});
 
 		Interval<Number> interval = carl::evaluate(p, var_to_interval);
 		{
@@ -213,10 +228,10 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 		// compute the result polynomial	
 		static Variable v = fresh_real_variable();
 		std::vector<UnivariatePolynomial<MultivariatePolynomial<Number>>> algebraic_information;
-		for (const auto& [var, ran] : m) {
-			if (var_to_interval.find(var) == var_to_interval.end()) continue;
+		for (const auto& entry : var_to_interval) {
+			const auto& ran = m.at(entry.first);
 			assert(!ran.is_numeric());
-			algebraic_information.emplace_back(replace_main_variable(ran.polynomial_int(), var).template convert<MultivariatePolynomial<Number>>());
+			algebraic_information.emplace_back(replace_main_variable(ran.polynomial_int(), entry.first).template convert<MultivariatePolynomial<Number>>());
 		}
 		// substitute RANs with low degrees first
 		std::sort(algebraic_information.begin(), algebraic_information.end(), [](const auto& a, const auto& b){ 
@@ -271,18 +286,7 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 		// refine the interval until it is either positive or negative or is contained in (neg_ub,pos_lb)
 		CARL_LOG_DEBUG("carl.ran.interval", "Refine until interval is in (" << neg_ub << "," << pos_lb << ") or interval is positive or negative");
 		while (!((neg_ub < interval.lower() || neg_ub == 0) && (interval.upper() < pos_lb || pos_lb == 0))) {
-			for (const auto& [var, ran] : m) {
-				if (var_to_interval.find(var) == var_to_interval.end()) continue;
-				ran.refine();
-				if (ran.is_numeric()) {
-					substitute_inplace(p, var, MultivariatePolynomial<Number>(ran.value()));
-					for (const auto& entry : m) {
-						if (!p.has(entry.first)) var_to_interval.erase(entry.first);
-					}
-				} else {
-					var_to_interval[var] = ran.interval();
-				}
-			}
+			refine_intervals(p, m, var_to_interval);
 			interval = carl::evaluate(p, var_to_interval);
 			auto int_res = carl::evaluate(interval, constr.relation());
 			if (!indeterminate(int_res)) {
@@ -297,6 +301,42 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 }
 
 
+}
+
+/**
+ * Evaluate the given polynomial with the given values for the variables.
+ * Asserts that all variables of p have an assignment in m and that m has no additional assignments.
+ * 
+ * Returns std::nullopt if some unassigned variables are still contained in p after plugging in m.
+ *
+ * @param p Polynomial to be evaluated
+ * @param m Variable assignment
+ * @return Evaluation result
+ */
+template<typename Number>
+std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(const MultivariatePolynomial<Number>& p, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true) {
+	return ran::interval::detail::evaluate_polynomial(p, m, refine_model);
+}
+
+/**
+ * Evaluate the given polynomial with the given values for the variables, see the overload for Assignment.
+ * Only the variables of p are looked up in m, and the real algebraic numbers share their representation, hence refinements carry over to m.
+ */
+template<typename Number>
+std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(const MultivariatePolynomial<Number>& p, const DenseAssignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true) {
+	return ran::interval::detail::evaluate_polynomial(p, m, refine_model);
+}
+
+template<typename Number>
+boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true, bool use_root_bounds = true) {
+	return ran::interval::detail::evaluate_constraint(c, m, refine_model, use_root_bounds);
+}
+
+template<typename Number>
+boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c, const DenseAssignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true, bool use_root_bounds = true) {
+	return ran::interval::detail::evaluate_constraint(c, m, refine_model, use_root_bounds);
+}
+
 template<typename Coeff, typename Ordering, typename Policies>
 auto evaluate(const ContextPolynomial<Coeff, Ordering, Policies>& p, const Assignment<typename ContextPolynomial<Coeff, Ordering, Policies>::RootType>& a) {
     return evaluate(MultivariatePolynomial<Coeff, Ordering, Policies>(p.content()), a);
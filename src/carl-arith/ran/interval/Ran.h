@@ -15,8 +15,11 @@
 
 #include "../common/Operations.h"
 #include "../common/NumberOperations.h"
+#include "ComparisonCache.h"
 
+#include <algorithm>
 #include <list>
+#include <vector>
 #include <boost/logic/tribool.hpp>
 
 namespace carl {
@@ -70,6 +73,10 @@ private:
 		Interval<Number> interval;
 		/// Sign of polynomial at interval.lower()
 		Sign lower_sign;
+		/// Unique identifier, used as key for the ComparisonCache.
+		std::size_t id = ran::interval::ComparisonCache::next_id();
+		/// Quadratic interval refinement splits the interval into 2^qir_exponent parts.
+		std::size_t qir_exponent = 2;
 
 		content(const Interval<Number>& i)
 			: polynomial(std::nullopt), interval(i), lower_sign(Sign::ZERO) {}
@@ -165,6 +172,49 @@ public:
 		return std::nullopt;
 	}
 
+	/**
+	 * Performs a step of the quadratic interval refinement (QIR) due to Abbott.
+	 * The interval is split into N = 2^k parts and the secant through the interval bounds selects the part that should contain the root.
+	 * If the guess is correct, the interval shrinks by the factor N and N is squared for the next step, yielding quadratic convergence.
+	 * Otherwise, N is reduced and a bisection step is performed.
+	 */
+	void refine_quadratic() const {
+		if (is_numeric()) return;
+		const Number a = interval_int().lower();
+		const Number b = interval_int().upper();
+		const Number fa = carl::evaluate(polynomial_int(), a);
+		const Number fb = carl::evaluate(polynomial_int(), b);
+		std::size_t& exponent = m_content->qir_exponent;
+		const Number parts = carl::pow(Number(2), exponent);
+		const Number step = (b - a) / parts;
+		// the secant intersects the axis within the part [lo, lo + step]
+		const Number k = carl::floor(parts * fa / (fa - fb));
+		const Number lo = a + k * step;
+		const Number hi = lo + step;
+		CARL_LOG_TRACE("carl.ran.interval", "QIR: guessing (" << lo << ", " << hi << ") in " << interval_int() << " with N = 2^" << exponent);
+
+		bool success = true;
+		if (lo > a && refine_internal(lo) == Sign::NEGATIVE) success = false;
+		if (success && !is_numeric() && hi < b && refine_internal(hi) == Sign::POSITIVE) success = false;
+		if (is_numeric()) return;
+		if (success) {
+			exponent *= 2;
+		} else {
+			exponent = std::max<std::size_t>(2, exponent / 2);
+			refine();
+		}
+	}
+
+	/**
+	 * Refines the interval using quadratic interval refinement until its width is at most 2^-bits.
+	 */
+	void refine_to_precision(std::size_t bits) const {
+		const Number width = Number(1) / carl::pow(Number(2), bits);
+		while (!is_numeric() && interval_int().diameter() > width) {
+			refine_quadratic();
+		}
+	}
+
 private:
 	/// Refines until the number is either numeric or the interval does not contain any integer.
 	void refine_to_integrality() const {
@@ -394,7 +444,14 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgeb
 		return evaluate(lhs.interval_int().lower(), relation, rhs.interval_int().lower());
 	}
 
-	if (carl::set_have_intersection(lhs.interval_int(), rhs.interval_int())) {
+	// Disjoint intervals are decided immediately, only comparisons that need refinements are worth caching.
+	auto& cache = ran::interval::ComparisonCache::getInstance();
+	bool intersected = carl::set_have_intersection(lhs.interval_int(), rhs.interval_int());
+	if (intersected) {
+		if (auto cached = cache.get(lhs.m_content->id, rhs.m_content->id); cached) {
+			CARL_LOG_TRACE("carl.ran.interval", "Comparison result is cached: " << *cached);
+			return evaluate(*cached, relation);
+		}
 		CARL_LOG_TRACE("carl.ran.interval", "Intervals " << lhs.interval_int() << " and " << rhs.interval_int() << " do intersect");
 		auto intersection = carl::set_intersection(lhs.interval_int(), rhs.interval_int());
 		assert(!intersection.is_empty());
@@ -411,10 +468,12 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgeb
 		CARL_LOG_TRACE("carl.ran.interval", "Intervals " << lhs.interval_int() << " and " << rhs.interval_int() << " are equal");
 		if (lhs.is_numeric()) {
 			CARL_LOG_TRACE("carl.ran.interval", "Interval " << lhs.interval_int() << " is a point interval");
+			cache.set(lhs.m_content->id, rhs.m_content->id, Sign::ZERO);
 			return evaluate(Sign::ZERO, relation);
 		}
 		if (lhs.polynomial_int() == rhs.polynomial_int()) {
 			CARL_LOG_TRACE("carl.ran.interval", "Polynomials " << lhs.polynomial_int() << " and " << rhs.polynomial_int() << " are equal");
+			cache.set(lhs.m_content->id, rhs.m_content->id, Sign::ZERO);
 			return evaluate(Sign::ZERO, relation);
 		}
 		auto g = carl::gcd(lhs.polynomial_int(), rhs.polynomial_int());
@@ -424,6 +483,7 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgeb
 			CARL_LOG_TRACE("carl.ran.interval", "gcd(lhs,rhs) has a zero in the common interval");
 			lhs.set_polynomial(g, lsgn);
 			rhs.set_polynomial(g, lsgn);
+			cache.set(lhs.m_content->id, rhs.m_content->id, Sign::ZERO);
 			return evaluate(Sign::ZERO, relation);
 		} else {
 			CARL_LOG_TRACE("carl.ran.interval", "gcd(lhs,rhs) has no zero in the common interval");
@@ -440,9 +500,11 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgeb
 	CARL_LOG_TRACE("carl.ran.interval", "Intervals " << lhs.interval_int() << " and " << rhs.interval_int() << " are disjoint");
 	assert(!carl::set_have_intersection(lhs.interval_int(), rhs.interval_int()));
 	if (lhs.interval_int().upper() <= rhs.interval_int().lower()) {
+		if (intersected) cache.set(lhs.m_content->id, rhs.m_content->id, Sign::NEGATIVE);
 		return relation == Relation::LESS || relation == Relation::LEQ;
 	}
 	if (lhs.interval_int().lower() >= rhs.interval_int().upper()) {
+		if (intersected) cache.set(lhs.m_content->id, rhs.m_content->id, Sign::POSITIVE);
 		return relation == Relation::GREATER || relation == Relation::GEQ;
 	}
 
@@ -450,6 +512,50 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgeb
 	return false;
 }
 
+/**
+ * Sorts the given real algebraic numbers in ascending order.
+ *
+ * Instead of refining pairs of numbers within every single comparison, numbers with overlapping intervals are refined together:
+ * every number of a cluster of overlapping intervals is refined at all interval bounds of the cluster that lie within its interval.
+ * Afterwards, any two intervals are either disjoint or equal and most comparisons are decided by the intervals alone.
+ */
+template<typename Number>
+void sort_batched(std::vector<IntRepRealAlgebraicNumber<Number>>& rans) {
+	using RAN = IntRepRealAlgebraicNumber<Number>;
+	std::sort(rans.begin(), rans.end(), [](const RAN& lhs, const RAN& rhs) {
+		return lhs.interval_int().lower() < rhs.interval_int().lower();
+	});
+	std::vector<Number> pivots;
+	for (std::size_t begin = 0; begin < rans.size();) {
+		Number upper = rans[begin].interval_int().upper();
+		std::size_t end = begin + 1;
+		while (end < rans.size() && rans[end].interval_int().lower() <= upper) {
+			upper = std::max(upper, rans[end].interval_int().upper());
+			++end;
+		}
+		if (end - begin > 1) {
+			CARL_LOG_TRACE("carl.ran.interval", "Refining cluster of " << (end - begin) << " numbers");
+			pivots.clear();
+			for (std::size_t i = begin; i < end; ++i) {
+				pivots.push_back(rans[i].interval_int().lower());
+				pivots.push_back(rans[i].interval_int().upper());
+			}
+			std::sort(pivots.begin(), pivots.end());
+			pivots.erase(std::unique(pivots.begin(), pivots.end()), pivots.end());
+			// Only bounds within the (shrinking) interval of a number are used for its refinement.
+			for (std::size_t i = begin; i < end; ++i) {
+				const auto& n = rans[i];
+				auto it = std::upper_bound(pivots.begin(), pivots.end(), n.interval_int().lower());
+				for (; it != pivots.end() && !n.is_numeric() && *it < n.interval_int().upper(); ++it) {
+					n.refine_using(*it);
+				}
+			}
+		}
+		begin = end;
+	}
+	std::sort(rans.begin(), rans.end());
+}
+
 template<typename Number>
 bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const Number& rhs, const Relation relation) {
 	auto res = lhs.refine_using(rhs);
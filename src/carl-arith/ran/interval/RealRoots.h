@@ -7,6 +7,7 @@
 #include <carl-logging/carl-logging.h>
 #include <carl-arith/core/Sign.h>
 #include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/trace/carl-recording.h>
 
 #include "helper/RealRootIsolation.h"
 
@@ -30,6 +31,7 @@ RealRootsResult<IntRepRealAlgebraicNumber<Number>> real_roots(
 		return RealRootsResult<IntRepRealAlgebraicNumber<Number>>::nullified_response();
 	}
 	CARL_LOG_DEBUG("carl.ran.interval", polynomial << " within " << interval);
+	CARL_RECORD(RealRoots, polynomial);
 	carl::ran::interval::RealRootIsolation rri(polynomial, interval);
 	auto r = rri.get_roots();
 	CARL_LOG_DEBUG("carl.ran.interval", "-> " << r);
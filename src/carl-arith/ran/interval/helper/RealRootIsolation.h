@@ -8,6 +8,7 @@
 #include <carl-arith/poly/umvpoly/functions/Factorization_univariate.h>
 #include <carl-arith/poly/umvpoly/functions/SignVariations.h>
 #include <carl-common/util/streamingOperators.h>
+#include <carl-statistics/carl-profiling.h>
 #include <carl-arith/poly/umvpoly/functions/EigenWrapper.h>
 #include <carl-arith/poly/umvpoly/functions/Evaluation.h>
 #include <carl-arith/poly/umvpoly/functions/RootElimination.h>
@@ -299,6 +300,7 @@ public:
 
 	/// Compute and sort the roots of mPolynomial within mInterval.
 	std::vector<IntRepRealAlgebraicNumber<Number>> get_roots() {
+		CARL_PROFILE_ZONE("ran.isolation");
 		if (simplify_by_factorization) {
 			auto factors = carl::factorization(mPolynomial);
 			CARL_LOG_DEBUG("carl.ran.interval", "Factorized " << mPolynomial << " to " << factors);
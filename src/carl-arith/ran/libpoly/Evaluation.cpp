@@ -7,10 +7,9 @@
 
 namespace carl {
 
-std::optional<LPRealAlgebraicNumber> evaluate(
-	const LPPolynomial& polynomial,
-	const std::map<Variable, LPRealAlgebraicNumber>& evalMap) {
-	lp_assignment_t& assignment = LPAssignment::getInstance().get(evalMap);
+namespace {
+
+std::optional<LPRealAlgebraicNumber> evaluate_assigned(const LPPolynomial& polynomial, lp_assignment_t& assignment) {
 	auto result = lp_polynomial_evaluate(polynomial.get_internal(), &assignment);
 
 	if (result->type == LP_VALUE_NONE) {
@@ -23,6 +22,20 @@ std::optional<LPRealAlgebraicNumber> evaluate(
 	return ran;
 }
 
+}
+
+std::optional<LPRealAlgebraicNumber> evaluate(
+	const LPPolynomial& polynomial,
+	const std::map<Variable, LPRealAlgebraicNumber>& evalMap) {
+	return evaluate_assigned(polynomial, LPAssignment::getInstance().get(evalMap));
+}
+
+std::optional<LPRealAlgebraicNumber> evaluate(
+	const LPPolynomial& polynomial,
+	const DenseAssignment<LPRealAlgebraicNumber>& evalMap) {
+	return evaluate_assigned(polynomial, LPAssignment::getInstance().get(evalMap));
+}
+
 inline auto lp_sign(carl::Relation rel) {
 	switch (rel) {
 	case Relation::EQ:
@@ -43,7 +56,10 @@ inline auto lp_sign(carl::Relation rel) {
 	}
 }
 
-boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const std::map<Variable, LPRealAlgebraicNumber>& evalMap) {
+namespace {
+
+template<typename Map>
+boost::tribool evaluate_constraint(const BasicConstraint<LPPolynomial>& constraint, const Map& evalMap) {
 	CARL_LOG_DEBUG("carl.ran.libpoly", " Evaluation constraint " << constraint << " for assignment " << evalMap);
 
 	if (is_constant(constraint.lhs())) {
@@ -54,7 +70,7 @@ boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const s
 	lp_assignment_t& assignment = LPAssignment::getInstance().get(evalMap);
 
 	for (const auto& v : carl::variables(constraint)) {
-		if (evalMap.find(v) == evalMap.end()) {
+		if (!evalMap.contains(v)) {
 			int result = lp_polynomial_constraint_evaluate_subs(poly_pol, lp_sign(constraint.relation()), &assignment);
 			if (result == -1) return boost::indeterminate;
 			else return result;
@@ -66,5 +82,15 @@ boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const s
 
 }
 
+boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const std::map<Variable, LPRealAlgebraicNumber>& evalMap) {
+	return evaluate_constraint(constraint, evalMap);
+}
+
+boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const DenseAssignment<LPRealAlgebraicNumber>& evalMap) {
+	return evaluate_constraint(constraint, evalMap);
+}
+
+}
+
 
 #endif
\ No newline at end of file
@@ -5,12 +5,16 @@
 
 #include "LPRan.h"
 #include "carl-arith/poly/libpoly/LPPolynomial.h"
+#include <carl-arith/core/DenseAssignment.h>
 
 namespace carl {
 
 std::optional<LPRealAlgebraicNumber> evaluate(const LPPolynomial& polynomial,const std::map<Variable, LPRealAlgebraicNumber>& evalMap);
 boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const std::map<Variable, LPRealAlgebraicNumber>& evalMap);
 
+std::optional<LPRealAlgebraicNumber> evaluate(const LPPolynomial& polynomial, const DenseAssignment<LPRealAlgebraicNumber>& evalMap);
+boost::tribool evaluate(const BasicConstraint<LPPolynomial>& constraint, const DenseAssignment<LPRealAlgebraicNumber>& evalMap);
+
 } // namespace carl
 
 #endif
\ No newline at end of file
@@ -10,29 +10,51 @@
 namespace carl {
 
 LPAssignment::LPAssignment() {
-    lp_assignment_construct(&lp_assignment, LPVariables::getInstance().lp_var_db);
+    LPVariables::getInstance().construct_assignment(&lp_assignment);
 }
 
 LPAssignment::~LPAssignment() {
-    lp_assignment_destruct(&lp_assignment);
+    LPVariables::getInstance().destruct_assignment(&lp_assignment);
+}
+
+void LPAssignment::reset() {
+    if (lp_assignment.values) {
+        for (size_t i = 0; i < lp_assignment.size; ++ i) {
+            lp_assignment_set_value(&lp_assignment, i, 0);
+        }
+    }
 }
 
 lp_assignment_t& LPAssignment::get(const carl::Assignment<LPRealAlgebraicNumber>& ass) {
-    if (last_assignment == ass) {
+    if (last_uid == 0 && last_assignment == ass) {
         return lp_assignment;
     } else {
         last_assignment = ass; 
-        if (lp_assignment.values) {
-            for (size_t i = 0; i < lp_assignment.size; ++ i) {
-                lp_assignment_set_value(&lp_assignment, i, 0);
-            }
-        }
+        last_uid = 0;
+        reset();
         for (const auto& entry : ass) {
             lp_assignment_set_value(&lp_assignment, LPVariables::getInstance().lp_variable(entry.first), entry.second.get_internal());
         }
         return lp_assignment;
     }
 }
+
+lp_assignment_t& LPAssignment::get(const carl::DenseAssignment<LPRealAlgebraicNumber>& ass) {
+    if (last_uid == ass.uid()) {
+        ass.for_each_changed_since(last_version, [this](Variable var, const LPRealAlgebraicNumber* value) {
+            lp_assignment_set_value(&lp_assignment, LPVariables::getInstance().lp_variable(var), value == nullptr ? 0 : value->get_internal());
+        });
+    } else {
+        last_assignment.clear();
+        reset();
+        ass.for_each([this](Variable var, const LPRealAlgebraicNumber& value) {
+            lp_assignment_set_value(&lp_assignment, LPVariables::getInstance().lp_variable(var), value.get_internal());
+        });
+        last_uid = ass.uid();
+    }
+    last_version = ass.version();
+    return lp_assignment;
+}
     
 } // namespace carl
 
@@ -11,21 +11,46 @@
 #include <poly/polynomial_context.h>
 #include <poly/assignment.h>
 #include <carl-arith/core/Common.h>
+#include <carl-arith/core/DenseAssignment.h>
 #include "LPRan.h"
 
 
 namespace carl {
 
+/**
+ * Caches the conversion of a carl assignment to a libpoly assignment.
+ * If THREAD_SAFE is set, every thread gets its own instance so that evaluation and root isolation can run concurrently.
+ * Note that the polynomials of a single LPContext share libpoly state and should still be used by a single thread.
+ */
 class LPAssignment : public Singleton<LPAssignment> {
     friend Singleton<LPAssignment>;
 
     lp_assignment_t lp_assignment;
     carl::Assignment<LPRealAlgebraicNumber> last_assignment;
+    /// Identifier and version of the DenseAssignment that lp_assignment mirrors, zero if none.
+    std::size_t last_uid = 0;
+    std::size_t last_version = 0;
+
+    void reset();
 
 public:
     LPAssignment();
     ~LPAssignment();
+#ifdef THREAD_SAFE
+    /**
+     * Returns the instance for the calling thread.
+     */
+    static LPAssignment& getInstance() {
+        thread_local LPAssignment t;
+        return t;
+    }
+#endif
     lp_assignment_t& get(const carl::Assignment<LPRealAlgebraicNumber>& ass);
+    /**
+     * Returns the libpoly assignment for the given dense assignment.
+     * If the previous call used the same dense assignment, only the variables that changed in the meantime are updated.
+     */
+    lp_assignment_t& get(const carl::DenseAssignment<LPRealAlgebraicNumber>& ass);
 };
     
 } // namespace carl
@@ -58,35 +58,17 @@ RealRootsResult<LPRealAlgebraicNumber> real_roots(
     return RealRootsResult<LPRealAlgebraicNumber>::roots_response(std::move(res));
 }
 
-RealRootsResult<LPRealAlgebraicNumber> real_roots(
+namespace {
+
+/**
+ * Isolates the real roots of the given polynomial in its main variable.
+ * The given libpoly assignment must assign all other variables of the polynomial but not the main variable.
+ */
+RealRootsResult<LPRealAlgebraicNumber> real_roots_assigned(
     const LPPolynomial& polynomial,
-    const std::map<Variable, LPRealAlgebraicNumber>& m,
+    lp_assignment_t& assignment,
     const Interval<LPRealAlgebraicNumber::NumberType>& interval) {
-    CARL_LOG_DEBUG("carl.ran.libpoly", polynomial << " " << m << " " << interval);
-
-    if (carl::is_univariate(polynomial)) {
-        return real_roots(polynomial, interval);
-    }
-
-    // easy checks
-    if (carl::is_zero(polynomial)) {
-        CARL_LOG_TRACE("carl.ran.libpoly", "poly is 0 -> nullified");
-        return RealRootsResult<LPRealAlgebraicNumber>::nullified_response();
-    } else if (carl::is_constant(polynomial)) {
-        CARL_LOG_TRACE("carl.ran.libpoly", "poly is constant but not zero -> no root");
-        return RealRootsResult<LPRealAlgebraicNumber>::no_roots_response();
-    }
-
-    for (const auto& v : carl::variables(polynomial)) {
-		if (v != polynomial.main_var() && m.find(v) == m.end()) return RealRootsResult<LPRealAlgebraicNumber>::non_univariate_response();
-	}
-
-    // Multivariate Polynomial
-    // build the assignment
     Variable mainVar = polynomial.main_var();
-    auto evalMap = m;
-    evalMap.erase(mainVar);
-    lp_assignment_t& assignment = LPAssignment::getInstance().get(evalMap);
 
     CARL_LOG_TRACE("carl.ran.libpoly", "Call libpoly");
     lp_value_t* roots = new lp_value_t[lp_polynomial_degree(polynomial.get_internal())];
@@ -132,6 +114,77 @@ RealRootsResult<LPRealAlgebraicNumber> real_roots(
 
     return RealRootsResult<LPRealAlgebraicNumber>::roots_response(std::move(res));
 }
+
+/**
+ * Handles the cases of real_roots that do not need libpoly.
+ */
+template<typename Map>
+std::optional<RealRootsResult<LPRealAlgebraicNumber>> real_roots_trivial(const LPPolynomial& polynomial, const Map& m) {
+    // easy checks
+    if (carl::is_zero(polynomial)) {
+        CARL_LOG_TRACE("carl.ran.libpoly", "poly is 0 -> nullified");
+        return RealRootsResult<LPRealAlgebraicNumber>::nullified_response();
+    } else if (carl::is_constant(polynomial)) {
+        CARL_LOG_TRACE("carl.ran.libpoly", "poly is constant but not zero -> no root");
+        return RealRootsResult<LPRealAlgebraicNumber>::no_roots_response();
+    }
+
+    for (const auto& v : carl::variables(polynomial)) {
+        if (v != polynomial.main_var() && !m.contains(v)) return RealRootsResult<LPRealAlgebraicNumber>::non_univariate_response();
+    }
+    return std::nullopt;
+}
+
+}
+
+RealRootsResult<LPRealAlgebraicNumber> real_roots(
+    const LPPolynomial& polynomial,
+    const std::map<Variable, LPRealAlgebraicNumber>& m,
+    const Interval<LPRealAlgebraicNumber::NumberType>& interval) {
+    CARL_LOG_DEBUG("carl.ran.libpoly", polynomial << " " << m << " " << interval);
+
+    if (carl::is_univariate(polynomial)) {
+        return real_roots(polynomial, interval);
+    }
+    if (auto res = real_roots_trivial(polynomial, m); res) {
+        return *res;
+    }
+
+    // Multivariate Polynomial
+    // build the assignment
+    auto evalMap = m;
+    evalMap.erase(polynomial.main_var());
+    lp_assignment_t& assignment = LPAssignment::getInstance().get(evalMap);
+    return real_roots_assigned(polynomial, assignment, interval);
+}
+
+RealRootsResult<LPRealAlgebraicNumber> real_roots(
+    const LPPolynomial& polynomial,
+    const DenseAssignment<LPRealAlgebraicNumber>& m,
+    const Interval<LPRealAlgebraicNumber::NumberType>& interval) {
+    CARL_LOG_DEBUG("carl.ran.libpoly", polynomial << " " << m << " " << interval);
+
+    if (carl::is_univariate(polynomial)) {
+        return real_roots(polynomial, interval);
+    }
+    if (auto res = real_roots_trivial(polynomial, m); res) {
+        return *res;
+    }
+
+    // Multivariate Polynomial
+    // the main variable is unassigned temporarily, so that the cached assignment can be updated incrementally
+    Variable mainVar = polynomial.main_var();
+    lp_assignment_t& assignment = LPAssignment::getInstance().get(m);
+    const LPRealAlgebraicNumber* mainValue = m.get(mainVar);
+    if (mainValue != nullptr) {
+        lp_assignment_set_value(&assignment, LPVariables::getInstance().lp_variable(mainVar), 0);
+    }
+    auto res = real_roots_assigned(polynomial, assignment, interval);
+    if (mainValue != nullptr) {
+        lp_assignment_set_value(&assignment, LPVariables::getInstance().lp_variable(mainVar), mainValue->get_internal());
+    }
+    return res;
+}
 }
 
 #endif
\ No newline at end of file
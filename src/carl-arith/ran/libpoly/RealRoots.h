@@ -6,6 +6,7 @@
 
 #include "../common/RealRoots.h"
 #include <carl-arith/core/Variable.h>
+#include <carl-arith/core/DenseAssignment.h>
 
 #include "helper.h"
 #include <carl-logging/carl-logging.h>
@@ -20,6 +21,8 @@ RealRootsResult<LPRealAlgebraicNumber> real_roots(const LPPolynomial& polynomial
 
 RealRootsResult<LPRealAlgebraicNumber> real_roots(const LPPolynomial& polynomial, const std::map<Variable, LPRealAlgebraicNumber>& m, const Interval<LPRealAlgebraicNumber::NumberType>& interval = Interval<LPRealAlgebraicNumber::NumberType>::unbounded_interval());
 
+RealRootsResult<LPRealAlgebraicNumber> real_roots(const LPPolynomial& polynomial, const DenseAssignment<LPRealAlgebraicNumber>& m, const Interval<LPRealAlgebraicNumber::NumberType>& interval = Interval<LPRealAlgebraicNumber::NumberType>::unbounded_interval());
+
 }
 
 #endif
\ No newline at end of file
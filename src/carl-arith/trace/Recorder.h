@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Trace.h"
+
+#include <carl-common/memory/Singleton.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <set>
+
+namespace carl::trace {
+
+/**
+ * Records calls to carl operations into a binary trace, see Trace.h for the format.
+ *
+ * Calls are usually recorded using the `CARL_RECORD` macro from carl-recording.h, which is disabled unless CARL_DEVOPTION_Recording is set.
+ * Calls that are nested inside another traced operation on the same thread are not recorded, they are part of the outer operation.
+ * Calls within carl that are not nested in this way, e.g. a gcd computed by a function that is not traced, are recorded as well.
+ * Recording has to be started explicitly by calling start().
+ */
+class Recorder : public carl::Singleton<Recorder> {
+	friend carl::Singleton<Recorder>;
+
+	std::mutex mMutex;
+	std::ofstream mOut;
+	std::atomic<bool> mActive = false;
+	/// Keys of the variables that were already declared in the trace.
+	std::set<std::size_t> mDeclared;
+
+	Recorder() = default;
+public:
+	~Recorder() override {
+		stop();
+	}
+
+	/**
+	 * Starts recording into the given file. A trace that is currently recorded is closed.
+	 * @return false if the file could not be opened.
+	 */
+	bool start(const std::string& filename) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mOut.is_open()) mOut.close();
+		mDeclared.clear();
+		mOut.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!mOut) return false;
+		mOut.write(header, sizeof(header) - 1);
+		mOut.put(static_cast<char>(version));
+		mActive = true;
+		return true;
+	}
+	/// Stops recording and closes the trace.
+	void stop() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mActive = false;
+		if (mOut.is_open()) mOut.close();
+	}
+	bool active() const {
+		return mActive.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Writes a single operation to the trace.
+	 * @param payload The encoded operands.
+	 * @param variables All variables that occur in the payload.
+	 */
+	void write(Operation op, std::uint64_t duration_ns, const std::string& payload, const std::vector<Variable>& variables) {
+		std::string buffer;
+		std::vector<Variable> unused;
+		Encoder e(buffer, unused);
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mActive) return;
+		for (Variable v: variables) {
+			if (!mDeclared.insert(key(v)).second) continue;
+			buffer.push_back(static_cast<char>(declare_variable));
+			e.varint(key(v));
+			buffer.push_back(static_cast<char>(v.type()));
+			e.bytes(v.name());
+		}
+		buffer.push_back(static_cast<char>(op));
+		e.varint(duration_ns);
+		e.varint(payload.size());
+		mOut.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		mOut.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+	}
+};
+
+/**
+ * Records a call to an operation if the recorder is active and the call is not nested inside another RecordScope on this thread.
+ * The operands are encoded on construction, the call is written to the trace with its duration on destruction.
+ * Calls with operands that are not traceable (e.g. with coefficients other than GMP numbers) are ignored.
+ */
+class RecordScope {
+	static std::size_t& depth() {
+		thread_local std::size_t d = 0;
+		return d;
+	}
+
+	Operation mOperation;
+	bool mRecording = false;
+	std::string mPayload;
+	std::vector<Variable> mVariables;
+	std::chrono::steady_clock::time_point mStart;
+public:
+	template<typename... Args>
+	explicit RecordScope(Operation op, const Args&... args): mOperation(op) {
+		if (depth()++ > 0) return;
+		if constexpr ((is_traceable<Args>::value && ...)) {
+			if (!Recorder::getInstance().active()) return;
+			Encoder e(mPayload, mVariables);
+			(e.write(args), ...);
+			mRecording = true;
+			mStart = std::chrono::steady_clock::now();
+		}
+	}
+	~RecordScope() {
+		--depth();
+		if (!mRecording) return;
+		auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count();
+		Recorder::getInstance().write(mOperation, static_cast<std::uint64_t>(duration), mPayload, mVariables);
+	}
+	RecordScope(const RecordScope&) = delete;
+	RecordScope& operator=(const RecordScope&) = delete;
+};
+
+}
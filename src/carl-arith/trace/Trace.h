@@ -0,0 +1,217 @@
+/**
+ * @file
+ *
+ * The binary format of traces of carl operations, see Recorder.
+ *
+ * A trace starts with the seven magic bytes `CARLTRC` followed by a byte holding the format version.
+ * Afterwards, it consists of a sequence of records, each starting with a tag byte:
+ * - A tag of zero declares a variable: its key within the trace (varint), its type (byte) and its name (varint length and bytes).
+ * - Any other tag is an Operation: the duration of the original call in nanoseconds (varint), the length of the payload (varint) and the payload.
+ *
+ * The payload contains the operands of the operation as written by the Encoder.
+ * Integers are stored as a varint holding the number of bytes and the sign, followed by the magnitude in little endian.
+ * Variables are referenced by their key, see key(), and declared before they are first used.
+ */
+
+#pragma once
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/numbers/numbers.h>
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace carl {
+
+template<typename C, typename O, typename P>
+class MultivariatePolynomial;
+template<typename C>
+class UnivariatePolynomial;
+
+namespace trace {
+
+constexpr char header[] = "CARLTRC";
+constexpr std::uint8_t version = 2;
+constexpr std::uint8_t declare_variable = 0;
+
+/// Identifies a variable within a trace, variable ids are only unique per type.
+inline std::size_t key(Variable v) {
+	return v.dense_index();
+}
+
+/**
+ * The operations that are recorded in a trace.
+ * The operands of each operation are listed in the comment.
+ */
+enum class Operation : std::uint8_t {
+	Multiply = 1, ///< Two multivariate polynomials.
+	GCD = 2, ///< Two multivariate polynomials.
+	Resultant = 3, ///< Two univariate polynomials with multivariate coefficients. The subresultant strategy is not recorded.
+	Factorization = 4, ///< A multivariate polynomial.
+	RealRoots = 5, ///< A univariate polynomial with numeric coefficients. The interval is not recorded.
+	MAX = RealRoots
+};
+
+inline const char* name(Operation op) {
+	switch (op) {
+		case Operation::Multiply: return "multiply";
+		case Operation::GCD: return "gcd";
+		case Operation::Resultant: return "resultant";
+		case Operation::Factorization: return "factorization";
+		case Operation::RealRoots: return "real_roots";
+	}
+	return "unknown";
+}
+
+/// States whether values of type T can be written to a trace.
+template<typename T>
+struct is_traceable: std::false_type {};
+template<>
+struct is_traceable<mpq_class>: std::true_type {};
+template<>
+struct is_traceable<mpz_class>: std::true_type {};
+template<typename C, typename O, typename P>
+struct is_traceable<MultivariatePolynomial<C,O,P>>: is_traceable<C> {};
+template<typename C>
+struct is_traceable<UnivariatePolynomial<C>>: is_traceable<C> {};
+
+/**
+ * Appends values to a binary buffer.
+ * All variables that are written are collected, such that they can be declared before the buffer is written to a trace.
+ */
+class Encoder {
+	std::string& mBuffer;
+	std::vector<Variable>& mVariables;
+public:
+	Encoder(std::string& buffer, std::vector<Variable>& variables): mBuffer(buffer), mVariables(variables) {}
+
+	void varint(std::uint64_t n) {
+		while (n >= 0x80) {
+			mBuffer.push_back(static_cast<char>((n & 0x7f) | 0x80));
+			n >>= 7;
+		}
+		mBuffer.push_back(static_cast<char>(n));
+	}
+	void bytes(const std::string& s) {
+		varint(s.size());
+		mBuffer.append(s);
+	}
+	void write(const mpz_class& n) {
+		std::size_t count = (mpz_sizeinbase(n.get_mpz_t(), 2) + 7) / 8;
+		if (sgn(n) == 0) count = 0;
+		varint(count * 2 + (sgn(n) < 0 ? 1 : 0));
+		std::size_t offset = mBuffer.size();
+		mBuffer.resize(offset + count);
+		mpz_export(mBuffer.data() + offset, nullptr, -1, 1, -1, 0, n.get_mpz_t());
+	}
+	void write(const mpq_class& n) {
+		write(n.get_num());
+		write(n.get_den());
+	}
+	void write(Variable v) {
+		varint(key(v));
+		mVariables.push_back(v);
+	}
+	template<typename C, typename O, typename P>
+	void write(const MultivariatePolynomial<C,O,P>& p) {
+		varint(p.nr_terms());
+		for (const auto& term: p) {
+			write(mpq_class(term.coeff()));
+			if (term.monomial() == nullptr) {
+				varint(0);
+				continue;
+			}
+			varint(term.monomial()->num_variables());
+			for (const auto& [var, exp]: *term.monomial()) {
+				write(var);
+				varint(exp);
+			}
+		}
+	}
+	template<typename C>
+	void write(const UnivariatePolynomial<C>& p) {
+		write(p.main_var());
+		varint(p.coefficients().size());
+		for (const auto& c: p.coefficients()) {
+			if constexpr (std::is_same_v<C, mpz_class>) write(mpq_class(c));
+			else write(c);
+		}
+	}
+};
+
+/**
+ * Reads values from a binary buffer as written by the Encoder.
+ * Throws std::runtime_error if the buffer is malformed.
+ */
+class Decoder {
+	const char* mCur;
+	const char* mEnd;
+	const std::map<std::size_t, Variable>& mVariables;
+
+	void require(std::size_t n) const {
+		if (static_cast<std::size_t>(mEnd - mCur) < n) throw std::runtime_error("Unexpected end of trace");
+	}
+public:
+	/**
+	 * @param variables Maps the variable keys of the trace to variables.
+	 */
+	Decoder(const char* begin, const char* end, const std::map<std::size_t, Variable>& variables): mCur(begin), mEnd(end), mVariables(variables) {}
+
+	bool empty() const {
+		return mCur == mEnd;
+	}
+	/// Current position within the buffer.
+	const char* position() const {
+		return mCur;
+	}
+	std::uint8_t byte() {
+		require(1);
+		return static_cast<std::uint8_t>(*mCur++);
+	}
+	std::uint64_t varint() {
+		std::uint64_t res = 0;
+		for (std::size_t shift = 0; shift < 64; shift += 7) {
+			std::uint8_t b = byte();
+			res |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+			if ((b & 0x80) == 0) return res;
+		}
+		throw std::runtime_error("Invalid varint in trace");
+	}
+	std::string bytes() {
+		std::size_t size = varint();
+		require(size);
+		std::string res(mCur, size);
+		mCur += size;
+		return res;
+	}
+	mpz_class integer() {
+		std::uint64_t n = varint();
+		std::size_t count = n / 2;
+		require(count);
+		mpz_class res;
+		mpz_import(res.get_mpz_t(), count, -1, 1, -1, 0, mCur);
+		mCur += count;
+		if (n % 2 == 1) res = -res;
+		return res;
+	}
+	mpq_class rational() {
+		mpz_class num = integer();
+		mpz_class den = integer();
+		if (den == 0) throw std::runtime_error("Zero denominator in trace");
+		mpq_class res(num, den);
+		res.canonicalize();
+		return res;
+	}
+	Variable variable() {
+		auto it = mVariables.find(varint());
+		if (it == mVariables.end()) throw std::runtime_error("Undeclared variable in trace");
+		return it->second;
+	}
+};
+
+}
+}
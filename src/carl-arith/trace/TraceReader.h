@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Trace.h"
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+namespace carl::trace {
+
+/**
+ * Reads a multivariate polynomial as written by Encoder::write().
+ */
+template<typename Poly>
+Poly read_polynomial(Decoder& d) {
+	using Coeff = typename Poly::CoeffType;
+	typename Poly::TermsType terms;
+	std::size_t size = d.varint();
+	for (std::size_t i = 0; i < size; ++i) {
+		Coeff coeff(d.rational());
+		std::size_t vars = d.varint();
+		if (vars == 0) {
+			terms.emplace_back(coeff);
+			continue;
+		}
+		Monomial::Content content;
+		std::size_t degree = 0;
+		for (std::size_t j = 0; j < vars; ++j) {
+			Variable v = d.variable();
+			std::size_t exp = d.varint();
+			content.emplace_back(v, exp);
+			degree += exp;
+		}
+		std::sort(content.begin(), content.end(), [](const auto& lhs, const auto& rhs){ return lhs.first < rhs.first; });
+		terms.emplace_back(coeff, createMonomial(std::move(content), degree));
+	}
+	return Poly(std::move(terms));
+}
+
+/**
+ * Reads a univariate polynomial as written by Encoder::write().
+ * The coefficients are either numbers or multivariate polynomials.
+ */
+template<typename Coeff>
+UnivariatePolynomial<Coeff> read_univariate(Decoder& d) {
+	Variable v = d.variable();
+	std::vector<Coeff> coeffs;
+	std::size_t size = d.varint();
+	for (std::size_t i = 0; i < size; ++i) {
+		if constexpr (is_number_type<Coeff>::value) coeffs.emplace_back(d.rational());
+		else coeffs.emplace_back(read_polynomial<Coeff>(d));
+	}
+	return UnivariatePolynomial<Coeff>(v, std::move(coeffs));
+}
+
+/**
+ * Reads the records of a trace that was written by the Recorder.
+ *
+ * Variables declared in the trace are created as fresh variables with the same name and type.
+ * Operations with an unknown tag are skipped.
+ */
+class TraceReader {
+public:
+	struct Record {
+		Operation operation;
+		/// Duration of the original call.
+		std::uint64_t duration_ns;
+		/// Decodes the operands of the operation.
+		Decoder operands;
+	};
+private:
+	std::string mData;
+	std::size_t mPosition = 0;
+	std::map<std::size_t, Variable> mVariables;
+public:
+	/**
+	 * Reads the whole trace from the given file.
+	 * Throws std::runtime_error if the file can not be read or is not a trace.
+	 */
+	explicit TraceReader(const std::string& filename) {
+		std::ifstream in(filename, std::ios::in | std::ios::binary);
+		if (!in) throw std::runtime_error("Could not open trace " + filename);
+		mData.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		std::string expected(header);
+		expected.push_back(static_cast<char>(version));
+		if (mData.compare(0, expected.size(), expected) != 0) throw std::runtime_error(filename + " is not a trace of version " + std::to_string(version));
+		mPosition = expected.size();
+	}
+
+	/**
+	 * Returns the next operation of the trace or std::nullopt at the end of the trace.
+	 * The returned record refers to this reader and is only valid as long as the reader is.
+	 */
+	std::optional<Record> next() {
+		while (mPosition < mData.size()) {
+			Decoder d(mData.data() + mPosition, mData.data() + mData.size(), mVariables);
+			std::uint8_t tag = d.byte();
+			if (tag == declare_variable) {
+				std::size_t key = d.varint();
+				auto type = static_cast<VariableType>(d.byte());
+				std::string name = d.bytes();
+				mVariables.emplace(key, fresh_variable(name, type));
+			} else {
+				std::uint64_t duration = d.varint();
+				std::size_t size = d.varint();
+				const char* begin = d.position();
+				if (static_cast<std::size_t>(mData.data() + mData.size() - begin) < size) throw std::runtime_error("Unexpected end of trace");
+				mPosition = static_cast<std::size_t>(begin - mData.data()) + size;
+				if (tag > static_cast<std::uint8_t>(Operation::MAX)) continue;
+				return Record{ static_cast<Operation>(tag), duration, Decoder(begin, begin + size, mVariables) };
+			}
+			mPosition = static_cast<std::size_t>(d.position() - mData.data());
+		}
+		return std::nullopt;
+	}
+};
+
+}
@@ -0,0 +1,22 @@
+/**
+ * @file
+ *
+ * Macros to record calls to carl operations into a trace.
+ *
+ * If CARL_DEVOPTION_Recording is not set, all macros are empty and this header does not pull in anything else.
+ * Otherwise, `CARL_RECORD(operation, operands...)` records the call of the current scope with the given operands, see Recorder.
+ */
+
+#pragma once
+
+#include <carl-common/config.h>
+
+#ifdef CARL_DEVOPTION_Recording
+	#include "Recorder.h"
+
+	#define __CARL_RECORD_CONCAT(a, b) a ## b
+	#define __CARL_RECORD(line, operation, ...) carl::trace::RecordScope __CARL_RECORD_CONCAT(__carl_record_scope_, line)(carl::trace::Operation::operation, __VA_ARGS__)
+	#define CARL_RECORD(operation, ...) __CARL_RECORD(__LINE__, operation, __VA_ARGS__)
+#else
+	#define CARL_RECORD(operation, ...)
+#endif
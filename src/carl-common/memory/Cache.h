@@ -8,10 +8,18 @@
 #pragma once
 
 #include "../util/container_types.h"
+#include "MemoryUsage.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <iostream>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <stack>
 #include <unordered_set>
 #include <vector>
@@ -43,6 +51,16 @@ namespace carl
     template<typename T>
     void doNothing( const T& /*unused*/, const T& /*unused*/) {}
    
+    /**
+     * A cache of objects of type T, which can be shared by several threads.
+     * 
+     * The entries are distributed over several shards by their hash, each shard has its own lock. An entry is accessed by its
+     * reference, which stays valid as long as the entry is registered. get() does not lock at all.
+     * Unused entries are evicted by the CLOCK algorithm: every shard keeps its entries in a ring, a hand walks over this ring
+     * and removes unused entries whose reference bit is not set. Using an entry sets its reference bit.
+     * 
+     * The type T must provide hash(), rehash() and operator==.
+     */
     template<typename T>
     class Cache {
         
@@ -54,7 +72,7 @@ namespace carl
             /**
              * Store the number of usages of the entry in the cache for which this information hold by external objects.
              */
-            std::size_t usageCount;
+            std::atomic<std::size_t> usageCount = 0;
             
             /**
              * Stores the reference of the entry in the cache for which this information hold.
@@ -62,90 +80,161 @@ namespace carl
             std::vector<Ref> refStoragePositions;
             
             /**
-             * Stores the activity of the entry in the cache for which this information hold. The activity states how often the entry
-             * is involved in computations in the recent past.
+             * The reference bit of the CLOCK algorithm. It is set whenever the entry is involved in computations and reset
+             * whenever the hand of the clock passes the entry.
              */
-            double activity;
+            std::atomic<bool> referenced = true;
 
-            explicit Info( double _activity ):
-                usageCount(0),
-                refStoragePositions(),
-                activity(_activity)
-            {}
+            /**
+             * The position of the entry in the clock of its shard.
+             */
+            std::size_t clockPosition = 0;
+
+            /**
+             * Entries that have been merged into this entry by rehash() while they were used. They may still be read by
+             * their users and are deleted once the usage count of this entry drops to zero or the entry is evicted.
+             * Guarded by the mutex of the shard.
+             */
+            std::vector<TypeInfoPair<T,Info>*> retired;
+
+            /**
+             * Whether retired is not empty, can be read without locking.
+             */
+            std::atomic<bool> hasRetired = false;
         };
         
         using Container = std::unordered_set<TypeInfoPair<T,Info>*, pointerHash<TypeInfoPair<T,Info>>, pointerEqual<TypeInfoPair<T,Info>>>;
         
     private:
+        using Entry = TypeInfoPair<T,Info>;
+
+        /**
+         * A part of the cache containing all entries whose hash is mapped to this shard.
+         */
+        struct alignas(64) Shard {
+            /// A mutex for all changes of this shard.
+            std::mutex mutex;
+            /// The entries of this shard.
+            Container entries;
+            /// The entries of this shard in the order they are visited by the hand of the clock.
+            std::vector<Entry*> clock;
+            /// The position of the hand of the clock.
+            std::size_t hand = 0;
+        };
+
+        /// The number of references in the first chunk of the reference table is 2^first_chunk_bits, every further chunk doubles.
+        static constexpr std::size_t first_chunk_bits = 10;
+        /// The maximum number of chunks of the reference table.
+        static constexpr std::size_t max_chunks = std::numeric_limits<std::size_t>::digits - first_chunk_bits;
+        /// The maximum number of steps of the hand of the clock when looking for an entry to evict.
+        static constexpr std::size_t max_clock_steps = 32;
+
         // Members
         
         /**
          * The threshold for the cache's size which should not be exceeded, except more of the cache entries are still in use.
          */
         std::size_t mMaxCacheSize;
-        
+
         /**
-         * The current number of entries in the cache, which are not used.
+         * The threshold for the size of a single shard.
          */
-        std::size_t mNumOfUnusedEntries = 0;
+        std::size_t mMaxShardSize;
         
         /**
-         * The percentage of the cache, which shall be removed at best, if the cache size exceeds the threshold. (NOT YET USED)
+         * The current number of entries in the cache, which are not used.
          */
-        double mCacheReductionAmount;
-        
+        std::atomic<std::size_t> mNumOfUnusedEntries = 0;
+
         /**
-         * The threshold for the maximum activity. In case it is exceeded, all activities are rescaled.
+         * The current number of entries in the cache.
          */
-        double mMaxActivity = 0.0;
-        
+        std::atomic<std::size_t> mSize = 0;
+
         /**
-         * The reciprocal of the factor to multiply an activity with in order to increase it. 
-         * This member can increased by a user interface.
+         * The largest number of entries in the cache so far.
          */
-        double mActivityIncrement = 1.0;
+        std::atomic<std::size_t> mPeakSize = 0;
         
         /**
-         * The decay (between 0.9 and 1.0) of the given increments on activities. 
-         * It is applied by increasing the increment by multiplying this members reciprocal to it.
+         * The percentage of the cache, which shall be removed at best, if the cache size exceeds the threshold. (NOT YET USED)
          */
-        double mDecay;
+        double mCacheReductionAmount;
         
         /**
-         * The threshold limiting the maximum activity. If this threshold is exceeded, all activities are rescaled.
+         * The shards, their number is a power of two.
          */
-        double mActivityThreshold = 1e100;
-        
+        std::unique_ptr<Shard[]> mShards;
+
         /**
-         * The factor multiplied to all activities in order to rescale (decrease) them.
+         * The number of shards minus one.
          */
-        double mActivityDecrementFactor = 1e-100;
+        std::size_t mShardMask;
         
         /**
-         * A mutex for situation where any member is changed. TODO: Refine the locking-situations. 
+         * Stores at the reference of an entry in the cache a pointer to this entry.
+         * The chunks are never moved or freed while the cache exists, hence the entries can be read without locking.
          */
-        std::recursive_mutex mMutex;
-        
+        std::array<std::atomic<std::atomic<Entry*>*>, max_chunks> mCacheRefs;
+
         /**
-         *  The container storing all cached entries. It maps the objects to store to cache information, which cover a usage counter, 
-         *  the position in mCacheRefs, being the entries reference, and the activity of this entry.
+         * A mutex for the allocation of references.
          */
-        Container mCache;
-        
+        std::mutex mRefMutex;
+
         /**
-         * Stores at the reference of an entry in the cache an iterator to this entry. 
-         * This reference can be used to access the entry outside this class.
+         * Serializes rehash(), which is the only method locking two shards at once.
          */
-        std::vector<TypeInfoPair<T,Info>*> mCacheRefs;
+        std::mutex mRehashMutex;
+
+        /// The smallest reference that has never been used.
+        Ref mNextRef = 1;
         /// A stack containing free references, which have been used before but freed now.
         std::stack<Ref> mUnusedPositionsInCacheRefs;
+
+        /// Bytes used by an entry without the data owned by the cached object.
+        static constexpr std::size_t entry_bytes = sizeof(Entry) + sizeof(T) + sizeof(Ref);
+
+        static std::size_t chunk_size( std::size_t _chunk )
+        {
+            return std::size_t(1) << (_chunk + first_chunk_bits);
+        }
+
+        /**
+         * @return The slot of the reference table that stores the entry with the given reference.
+         */
+        std::atomic<Entry*>& slot( Ref _refStoragePos ) const
+        {
+            std::size_t index = _refStoragePos + chunk_size( 0 );
+            std::size_t chunk = std::size_t(std::bit_width( index )) - 1 - first_chunk_bits;
+            assert( chunk < max_chunks );
+            std::atomic<Entry*>* refs = mCacheRefs[chunk].load( std::memory_order_acquire );
+            assert( refs != nullptr );
+            return refs[index - chunk_size( chunk )];
+        }
+
+        Shard& shard( std::size_t _hash ) const
+        {
+            return mShards[((_hash * std::size_t(0x9E3779B97F4A7C15ull)) >> 48) & mShardMask];
+        }
+
+        Shard& shard( const Entry* _entry ) const
+        {
+            return shard( _entry->first->hash() );
+        }
         
     public:
 
         static const Ref NO_REF;
 
-        // The constructor.
-        explicit Cache( size_t _maxCacheSize = 10000, double _cacheReductionAmount = 0.2, double _decay = 0.98 );
+        /**
+         * The constructor.
+         * @param _maxCacheSize The desired maximum number of entries.
+         * @param _cacheReductionAmount Not used.
+         * @param _decay Not used, the entries are aged by the clock.
+         * @param _shards The number of shards, rounded up to a power of two.
+         */
+        explicit Cache( size_t _maxCacheSize = 10000, double _cacheReductionAmount = 0.2, double _decay = 0.98, std::size_t _shards = 16 );
         Cache( const Cache& ) = delete; // no implementation
         Cache& operator=( const Cache& ) = delete; // no implementation
 
@@ -153,6 +242,7 @@ namespace carl
         
         /**
          * Caches the given object.
+         * The entry is protected from eviction by its reference bit only, it should be registered right away.
          * @param _toCache The object to cache.
          * @param _canBeUpdated A function, which determines whether, in the case an equal object has already been cached, the given object
          *                      can update the information in this already cached object.
@@ -160,7 +250,20 @@ namespace carl
          *                After this function has been applied, the corresponding entry in the cache will be reinserted in it after been rehashed.
          * @return The reference of the entry, which can be used outside this class to access the entry.
          */
-        std::pair<Ref,bool> cache( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> );
+        std::pair<Ref,bool> cache( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> )
+        {
+            return insert( _toCache, _canBeUpdated, _update, false );
+        }
+
+        /**
+         * Caches the given object and registers the entry, such that it can not be evicted by another thread in between.
+         * @param _toCache The object to cache.
+         * @return The reference of the entry and whether the given object has been inserted.
+         */
+        std::pair<Ref,bool> cacheAndReg( T* _toCache )
+        {
+            return insert( _toCache, &returnFalse<T>, &doNothing<T>, true );
+        }
         
         /**
          * Registers the entry to the given reference. It mainly increases the usage counter of this entry in the cache.
@@ -176,21 +279,24 @@ namespace carl
         
         /**
          * Removes and reinserts the entry with the given reference, after its hash value is recalculated.
+         * Must not run concurrently with reg() or dereg() for the same entry.
          * @param _refStoragePos The reference of the entry to apply the given function to.
-         * @return The new reference.
          */
         void rehash( Ref _refStoragePos );
         
         /**
-         * Decays all activities by increasing the activity increment.
+         * Does nothing, the entries are aged by the hand of the clock.
          */
-        void decayActivity();
+        void decayActivity() {}
         
         /**
-         * Strenghtens the activity of the entry in the cache with the given reference, by increasing its activity.
+         * Strenghtens the activity of the entry in the cache with the given reference, by setting its reference bit.
          * @param _refStoragePos The reference of the entry in the cache to strengthen its activity.
          */
-        void strengthenActivity( Ref _refStoragePos );
+        void strengthenActivity( Ref _refStoragePos )
+        {
+            slot( _refStoragePos ).load( std::memory_order_acquire )->second.referenced.store( true, std::memory_order_relaxed );
+        }
         
         /**
          * Prints all information stored in this cache to std::cout.
@@ -198,78 +304,78 @@ namespace carl
          */
         void print( std::ostream& _out = std::cout ) const;
         
+        std::size_t size() const
+        {
+            return mSize.load( std::memory_order_relaxed );
+        }
+
+        /**
+         * Returns the memory used by the cache and its entries.
+         * Data owned by the cached objects is not included.
+         * The ids are the references handed out by the cache.
+         */
+        MemoryUsage memory_usage();
+
         /**
+         * Does not lock.
          * @param _refStoragePos The reference of the entry to obtain the object from. 
          * @return The object in the entry with the given reference.
          */
         const T& get( Ref _refStoragePos ) const
         {
-            assert( _refStoragePos < mCacheRefs.size() );
-            assert( mCacheRefs[_refStoragePos] != nullptr );
-            assert( mCacheRefs[_refStoragePos]->second.usageCount > 0 );
-            return *mCacheRefs[_refStoragePos]->first;
+            const Entry* entry = slot( _refStoragePos ).load( std::memory_order_acquire );
+            assert( entry != nullptr );
+            assert( entry->second.usageCount > 0 );
+            return *entry->first;
         }
         
     private:
-        
+
+        std::pair<Ref,bool> insert( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ), void (*_update)( const T&, const T& ), bool _reg );
+
         /**
-         * Removes a certain amount of unused entries in the cache.
+         * Obtains a fresh reference for the given entry. The reference mutex must not be held.
          */
-        void clean();
-        
+        Ref allocateRef( Entry* _entry );
+
         /**
-         * Removes the entry at the given position in the cache.
-         * @param _toRemove The position to the entry to remove from the cache.
-         * @return 
+         * Moves the hand of the clock of the given shard until an unused entry without reference bit is found or
+         * max_clock_steps are made. The shard must be locked.
+         * @return The entry removed from the shard or nullptr. It still has to be deleted.
          */
-        std::size_t erase( TypeInfoPair<T,Info>* _toRemove )
+        Entry* evict( Shard& _shard );
+
+        /**
+         * Removes the entry from the clock of the given shard. The shard must be locked.
+         */
+        void removeFromClock( Shard& _shard, Entry* _entry )
         {
-            assert( checkNumOfUnusedEntries() );
-            std::lock_guard<std::recursive_mutex> lock( mMutex );
-            assert( _toRemove->second.usageCount == 0 );
-            for( const Ref& ref : _toRemove->second.refStoragePositions )
-            {
-                mCacheRefs[ref] = nullptr;
-                assert (ref > 0);
-                mUnusedPositionsInCacheRefs.push( ref );
-            }
-            assert( mNumOfUnusedEntries > 0 );
-            --mNumOfUnusedEntries;
-            assert(_toRemove->second.usageCount == 0);
-            auto result = mCache.erase( _toRemove );
-            T* toDel = _toRemove->first;
-            delete _toRemove;
-            delete toDel;
-            assert( checkNumOfUnusedEntries() );
-            return result;
+            std::size_t pos = _entry->second.clockPosition;
+            assert( _shard.clock[pos] == _entry );
+            _shard.clock[pos] = _shard.clock.back();
+            _shard.clock[pos]->second.clockPosition = pos;
+            _shard.clock.pop_back();
         }
-        
+
         /**
-         * Removes the entry at the given position in the cache.
-         * @param _toRemove The position to the entry to remove from the cache.
-         * @return An iterator to the entry in the cache right after the entry which has to be removed.
+         * Adds the entry to the clock of the given shard, right behind the hand. The shard must be locked.
          */
-        typename Container::iterator erase( typename Container::iterator _toRemove )
+        void addToClock( Shard& _shard, Entry* _entry )
         {
-            assert( checkNumOfUnusedEntries() );
-            std::lock_guard<std::recursive_mutex> lock( mMutex );
-            assert( (*_toRemove)->second.usageCount == 0 );
-            for( const Ref& ref : (*_toRemove)->second.refStoragePositions )
-            {
-                mCacheRefs[ref] = nullptr;
-                assert (ref > 0);
-                mUnusedPositionsInCacheRefs.push( ref );
-            }
-            assert( mNumOfUnusedEntries > 0 );
-            --mNumOfUnusedEntries;
-            assert((*_toRemove)->second.usageCount == 0);
-            T* toDel = (*_toRemove)->first;
-            TypeInfoPair<T,Info>* toDelB = *_toRemove;
-            auto result = mCache.erase( _toRemove );
-            delete toDelB;
+            _entry->second.clockPosition = _shard.clock.size();
+            _shard.clock.push_back( _entry );
+        }
+
+        /**
+         * Deletes the entry, its object and its retired entries.
+         */
+        static void destroy( Entry* _entry )
+        {
+            for( Entry* retired : _entry->second.retired )
+                destroy( retired );
+            T* toDel = _entry->first;
+            delete _entry;
             delete toDel;
-            assert( checkNumOfUnusedEntries() );
-            return result;
         }
         
         bool hasDuplicates(const std::vector<Ref>& _vec) const
@@ -282,30 +388,6 @@ namespace carl
             }
             return false;
         }
-        
-        bool checkNumOfUnusedEntries() const
-        {
-            std::size_t actualNumOfUnusedEntries = 0;
-            for( auto iter = mCache.begin(); iter != mCache.end(); ++iter )
-            {
-                if( (*iter)->second.usageCount == 0 )
-                {
-                    ++actualNumOfUnusedEntries;
-                }
-            }
-            return mNumOfUnusedEntries == actualNumOfUnusedEntries;
-        }
-        
-        size_t sumOfAllUsageCounts() const
-        {
-            std::size_t result = 0;
-            for( auto iter = mCache.begin(); iter != mCache.end(); ++iter )
-            {
-                result += (*iter)->second.usageCount;
-            }
-            return result;
-        }
-        
     };
     
 } // namespace carl
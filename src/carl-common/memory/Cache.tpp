@@ -16,245 +16,282 @@ namespace carl
     const typename Cache<T>::Ref Cache<T>::NO_REF = 0;
 
     template<typename T>
-    Cache<T>::Cache( size_t _maxCacheSize, double _cacheReductionAmount, double _decay ):
+    Cache<T>::Cache( size_t _maxCacheSize, double _cacheReductionAmount, double /*_decay*/, std::size_t _shards ):
         mMaxCacheSize( _maxCacheSize ),
         mCacheReductionAmount( _cacheReductionAmount ), // TODO: use it, but without the effort of quick select
-        mDecay( _decay ),
-        mCache(),
-        mCacheRefs(),
-        mUnusedPositionsInCacheRefs()
+        mCacheRefs()
     {
-        assert( _decay >= 0.9 && _decay <= 1.0 );
-        mCache.reserve( _maxCacheSize ); // TODO: maybe no reservation of memory and let it grow dynamically
-        mCacheRefs.reserve( _maxCacheSize ); // TODO: maybe no reservation of memory and let it grow dynamically
+        assert( _shards > 0 && _shards <= (std::size_t(1) << 16) );
+        std::size_t shards = std::bit_ceil( _shards );
+        mShards = std::make_unique<Shard[]>( shards );
+        mShardMask = shards - 1;
+        mMaxShardSize = std::max( std::size_t(1), _maxCacheSize / shards );
+        for( std::size_t i = 0; i < shards; ++i )
+            mShards[i].entries.reserve( mMaxShardSize );
         // reserve the first entry with index 0 as default
-        mCacheRefs.push_back( nullptr ); 
+        mCacheRefs[0].store( new std::atomic<Entry*>[chunk_size( 0 )](), std::memory_order_release );
     }
     
     template<typename T>
     Cache<T>::~Cache()
     {
-        mCacheRefs.clear();
-        while( !mCache.empty() )
+        for( std::size_t i = 0; i <= mShardMask; ++i )
         {
-            TypeInfoPair<T,Info>* tip = *mCache.begin();
-            mCache.erase( mCache.begin() );
-            T* t = tip->first;
-            delete tip;
-            delete t;
+            Container& entries = mShards[i].entries;
+            while( !entries.empty() )
+            {
+                Entry* entry = *entries.begin();
+                entries.erase( entries.begin() );
+                destroy( entry );
+            }
         }
+        for( auto& chunk : mCacheRefs )
+            delete[] chunk.load( std::memory_order_relaxed );
+    }
+
+    template<typename T>
+    typename Cache<T>::Ref Cache<T>::allocateRef( Entry* _entry )
+    {
+        std::lock_guard<std::mutex> lock( mRefMutex );
+        Ref ref;
+        if( mUnusedPositionsInCacheRefs.empty() ) // Get a brand new reference.
+        {
+            ref = mNextRef++;
+            std::size_t chunk = std::size_t(std::bit_width( ref + chunk_size( 0 ) )) - 1 - first_chunk_bits;
+            assert( chunk < max_chunks );
+            if( mCacheRefs[chunk].load( std::memory_order_relaxed ) == nullptr )
+                mCacheRefs[chunk].store( new std::atomic<Entry*>[chunk_size( chunk )](), std::memory_order_release );
+        }
+        else // Try to take the reference from the stack of old ones.
+        {
+            ref = mUnusedPositionsInCacheRefs.top();
+            mUnusedPositionsInCacheRefs.pop();
+        }
+        assert( ref > 0 );
+        slot( ref ).store( _entry, std::memory_order_release );
+        return ref;
     }
     
     template<typename T>
-    std::pair<typename Cache<T>::Ref,bool> Cache<T>::cache( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ), void (*_update)( const T&, const T& ) )
+    std::pair<typename Cache<T>::Ref,bool> Cache<T>::insert( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ), void (*_update)( const T&, const T& ), bool _reg )
     {
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        if( mCache.size() >= mMaxCacheSize ) // Clean, if the number of elements in the cache exceeds the threshold.
+        Shard& sh = shard( _toCache->hash() );
+        std::unique_lock<std::mutex> lock( sh.mutex );
+        Entry* evicted = nullptr;
+        if( sh.entries.size() >= mMaxShardSize ) // Evict, if the number of elements in the shard exceeds the threshold.
         {
-            clean();
+            evicted = evict( sh );
         }
-        auto newElement = new TypeInfoPair<T,Info>(_toCache, Info(mMaxActivity));
-        auto ret = mCache.insert( newElement );
-        
+        auto newElement = new Entry( std::piecewise_construct, std::forward_as_tuple( _toCache ), std::forward_as_tuple() );
+        auto ret = sh.entries.insert( newElement );
+        Entry* element = *ret.first;
         if( !ret.second ) // There is already an equal object in the cache.
         {
+            delete newElement;
+            element->second.referenced.store( true, std::memory_order_relaxed );
+            if( _reg )
+                reg( element->second.refStoragePositions.front() );
+            Ref ref = element->second.refStoragePositions.front();
             // Try to update the entry in the cache by the information in the given object.
-            if( (*_canBeUpdated)( *((*ret.first)->first), *_toCache ) )
-            {
-                TypeInfoPair<T,Info>* element = *ret.first;
+            bool updated = (*_canBeUpdated)( *element->first, *_toCache );
+            if( updated )
                 (*_update)( *element->first, *_toCache );
-                mCache.erase( ret.first );
-                element->first->rehash();
-                auto retB = mCache.insert( element );
-                assert( retB.second );
-                for( const Ref& ref : element->second.refStoragePositions )
-                    mCacheRefs[ref] = *retB.first;
-                delete newElement;
-                Info& info = (*retB.first)->second;
-                assert( info.refStoragePositions.size() > 0);
-                assert( info.refStoragePositions.front() > 0 );
-                info.refStoragePositions.insert( info.refStoragePositions.end(), element->second.refStoragePositions.begin(), element->second.refStoragePositions.end() );
-                return std::make_pair( info.refStoragePositions.front(), false );
-            }
-            else
-                delete newElement;
+            lock.unlock();
+            if( evicted != nullptr )
+                destroy( evicted );
+            if( updated )
+                rehash( ref );
+            return std::make_pair( ref, false );
         }
-        else // Create a new entry in the cache.
+        // Create a new entry in the cache.
+        element->second.refStoragePositions.push_back( allocateRef( element ) );
+        assert( !hasDuplicates( element->second.refStoragePositions ) );
+        addToClock( sh, element );
+        if( _reg )
+            element->second.usageCount.store( 1, std::memory_order_relaxed );
+        else
+            ++mNumOfUnusedEntries;
+        std::size_t size = ++mSize;
+        std::size_t peak = mPeakSize.load( std::memory_order_relaxed );
+        while( peak < size && !mPeakSize.compare_exchange_weak( peak, size, std::memory_order_relaxed ) );
+        Ref ref = element->second.refStoragePositions.front();
+        lock.unlock();
+        if( evicted != nullptr )
+            destroy( evicted );
+        return std::make_pair( ref, true );
+    }
+
+    template<typename T>
+    typename Cache<T>::Entry* Cache<T>::evict( Shard& _shard )
+    {
+        for( std::size_t step = 0; step < max_clock_steps && !_shard.clock.empty(); ++step )
         {
-            if( mUnusedPositionsInCacheRefs.empty() ) // Get a brand new reference.
+            if( _shard.hand >= _shard.clock.size() )
+                _shard.hand = 0;
+            Entry* entry = _shard.clock[_shard.hand];
+            if( entry->second.usageCount.load( std::memory_order_acquire ) > 0 )
             {
-                assert( mCacheRefs.size() > 0);
-                (*ret.first)->second.refStoragePositions.push_back( mCacheRefs.size() );
-                assert( !hasDuplicates( (*ret.first)->second.refStoragePositions ) );
-                mCacheRefs.push_back( newElement );
+                ++_shard.hand;
             }
-            else // Try to take the reference from the stack of old ones.
+            else if( entry->second.referenced.exchange( false, std::memory_order_relaxed ) )
             {
-                mCacheRefs[mUnusedPositionsInCacheRefs.top()] = newElement;
-                assert( mUnusedPositionsInCacheRefs.top() > 0);
-                newElement->second.refStoragePositions.push_back( mUnusedPositionsInCacheRefs.top() );
-                assert( !hasDuplicates( newElement->second.refStoragePositions ) );
-                mUnusedPositionsInCacheRefs.pop();
+                // Second chance.
+                ++_shard.hand;
+            }
+            else
+            {
+                // The entry at the hand is replaced by the last one, which is checked next.
+                removeFromClock( _shard, entry );
+                _shard.entries.erase( entry );
+                {
+                    std::lock_guard<std::mutex> lock( mRefMutex );
+                    for( const Ref& ref : entry->second.refStoragePositions )
+                    {
+                        assert( ref > 0 );
+                        slot( ref ).store( nullptr, std::memory_order_release );
+                        mUnusedPositionsInCacheRefs.push( ref );
+                    }
+                }
+                assert( mNumOfUnusedEntries > 0 );
+                --mNumOfUnusedEntries;
+                --mSize;
+                return entry;
             }
-            assert( mNumOfUnusedEntries < std::numeric_limits<sint>::max() );
-            ++mNumOfUnusedEntries;
         }
-        assert( (*ret.first)->second.refStoragePositions.size() > 0);
-        assert( (*ret.first)->second.refStoragePositions.front() > 0 );
-        return std::make_pair( (*ret.first)->second.refStoragePositions.front(), ret.second );
+        return nullptr;
     }
     
     template<typename T>
     void Cache<T>::reg( Ref _refStoragePos )
     {
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        assert( _refStoragePos < mCacheRefs.size() );
-        TypeInfoPair<T,Info>* cacheRef = mCacheRefs[_refStoragePos];
+        Entry* cacheRef = slot( _refStoragePos ).load( std::memory_order_acquire );
         assert( cacheRef != nullptr );
-        if( cacheRef->second.usageCount == 0 )
+        if( cacheRef->second.usageCount.fetch_add( 1, std::memory_order_acq_rel ) == 0 )
         {
             assert( mNumOfUnusedEntries > 0 );
             --mNumOfUnusedEntries;
         }
-        assert( cacheRef->second.usageCount < std::numeric_limits<sint>::max() );
-        ++cacheRef->second.usageCount;
     }
     
     template<typename T>
     void Cache<T>::dereg( Ref _refStoragePos )
     {
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        assert( _refStoragePos < mCacheRefs.size() );
-        TypeInfoPair<T,Info>* cacheRef = mCacheRefs[_refStoragePos];
+        Entry* cacheRef = slot( _refStoragePos ).load( std::memory_order_acquire );
         assert( cacheRef != nullptr );
         assert( cacheRef->second.usageCount > 0 );
-        --cacheRef->second.usageCount;
-        if( cacheRef->second.usageCount == 0 ) // no more usage
+        cacheRef->second.referenced.store( true, std::memory_order_relaxed );
+        std::vector<Entry*> retired;
+        if( cacheRef->second.hasRetired.load( std::memory_order_acquire ) )
         {
-            assert( mNumOfUnusedEntries < std::numeric_limits<sint>::max() );
-            ++mNumOfUnusedEntries;
-            // If the cache contains more used elements than the maximum desired cache size, remove this entry directly.
-            if( mCache.size() - mNumOfUnusedEntries >= mMaxCacheSize )
+            // The shard is locked such that the entry can not be evicted before its retired entries are taken.
+            std::lock_guard<std::mutex> lock( shard( cacheRef ).mutex );
+            if( cacheRef->second.usageCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) // no more usage
             {
-                erase( cacheRef );
+                ++mNumOfUnusedEntries;
+                // All users of the retired entries have been counted by this entry, hence they are gone.
+                retired.swap( cacheRef->second.retired );
+                cacheRef->second.hasRetired.store( false, std::memory_order_relaxed );
             }
         }
+        else if( cacheRef->second.usageCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) // no more usage
+        {
+            ++mNumOfUnusedEntries;
+        }
+        for( Entry* entry : retired )
+            destroy( entry );
     }
     
     template<typename T>
     void Cache<T>::rehash( Ref _refStoragePos )
     {
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        assert( _refStoragePos < mCacheRefs.size() );
-        TypeInfoPair<T,Info>* cacheRef = mCacheRefs[_refStoragePos];
+        Entry* cacheRef = slot( _refStoragePos ).load( std::memory_order_acquire );
         assert( cacheRef != nullptr );
-        mCache.erase( cacheRef );
+        // The entry is moved while both shards are locked, such that it can always be found by other threads.
+        std::lock_guard<std::mutex> rehashLock( mRehashMutex );
+        Shard& from = shard( cacheRef );
+        std::unique_lock<std::mutex> fromLock( from.mutex );
+        auto erased = from.entries.erase( cacheRef );
+        assert( erased == 1 );
+        (void)erased;
+        removeFromClock( from, cacheRef );
         cacheRef->first->rehash();
-        const Info& infoB = cacheRef->second;
-        auto ret = mCache.insert( cacheRef );
-        if( !ret.second )
+        Shard& to = shard( cacheRef );
+        std::unique_lock<std::mutex> toLock( to.mutex, std::defer_lock );
+        if( &to != &from )
+            toLock.lock();
+        auto ret = to.entries.insert( cacheRef );
+        if( ret.second )
         {
-            Info& info = (*ret.first)->second;
-            if( infoB.usageCount == 0 )
-            {
-                assert( mNumOfUnusedEntries > 0 );
-                --mNumOfUnusedEntries;
-            }
-            else if( info.usageCount == 0 )
-            {
-                assert( mNumOfUnusedEntries > 0 );
-                --mNumOfUnusedEntries;
-            }
-            assert( info.usageCount + infoB.usageCount >= info.usageCount );
-            info.usageCount += infoB.usageCount;
-            info.refStoragePositions.insert( info.refStoragePositions.end(), infoB.refStoragePositions.begin(), infoB.refStoragePositions.end() );
-            assert( !hasDuplicates( info.refStoragePositions ) );
-            assert( std::find( infoB.refStoragePositions.begin(), infoB.refStoragePositions.end(), _refStoragePos ) != infoB.refStoragePositions.end() );
-            for( const Ref& ref : infoB.refStoragePositions )
-            {
-                assert( mCacheRefs[ref] != *(ret.first) );
-                mCacheRefs[ref] = *(ret.first);
-            }
-            delete cacheRef->first;
-            delete cacheRef;
+            addToClock( to, cacheRef );
+            return;
         }
-    }
-    
-    template<typename T>
-    void Cache<T>::clean()
-    {
-        //CARL_LOG_TRACE( "carl.util.cache", "Cleaning cache..." );
-        if( double(mNumOfUnusedEntries) < (double(mCache.size()) * mCacheReductionAmount) )
+        // An equal entry exists already, all references are redirected to it.
+        Entry* target = *ret.first;
+        Info& info = target->second;
+        Info& infoB = cacheRef->second;
+        std::size_t usage = infoB.usageCount.exchange( 0, std::memory_order_acq_rel );
+        if( usage == 0 )
         {
-            if( mNumOfUnusedEntries > 0 )
-            {
-                // There are less entries we can delete than we want to delete: just delete them all
-                for( auto iter = mCache.begin(); iter != mCache.end(); )
-                {
-                    if( (*iter)->second.usageCount == 0 )
-                    {
-                        iter = erase( iter );
-                    }
-                    else
-                    {
-                        ++iter;
-                    }
-                }
-            }
-            assert( mNumOfUnusedEntries == 0 );
+            assert( mNumOfUnusedEntries > 0 );
+            --mNumOfUnusedEntries;
         }
-        else
+        else if( info.usageCount.fetch_add( usage, std::memory_order_acq_rel ) == 0 )
         {
-            std::vector<typename Container::iterator> noUsageEntries;
-            // Calculate the expected median of the activities of all entries in the cache with no usage.
-            double limit = 0.0;
-            for( auto iter = mCache.begin(); iter != mCache.end(); ++iter )
-            {
-                if( (*iter)->second.usageCount == 0 )
-                {
-                    noUsageEntries.push_back( iter );
-                    limit += (*iter)->second.activity;
-                }
-            }
-            limit = limit / double(noUsageEntries.size());
-            // Remove all entries in the cache with no usage, which have an activity below the calculated median.
-            for( auto iter = noUsageEntries.begin(); iter != noUsageEntries.end(); ++iter )
-            {
-                if( (**iter)->second.activity <= limit )
-                {
-                    erase( *iter );
-                }
-            }
+            assert( mNumOfUnusedEntries > 0 );
+            --mNumOfUnusedEntries;
         }
+        info.referenced.store( true, std::memory_order_relaxed );
+        if( usage > 0 )
+        {
+            // The users of the merged entry may still read it, it is deleted once they are gone.
+            info.retired.insert( info.retired.end(), infoB.retired.begin(), infoB.retired.end() );
+            infoB.retired.clear();
+            info.retired.push_back( cacheRef );
+            info.hasRetired.store( true, std::memory_order_release );
+        }
+        info.refStoragePositions.insert( info.refStoragePositions.end(), infoB.refStoragePositions.begin(), infoB.refStoragePositions.end() );
+        assert( !hasDuplicates( info.refStoragePositions ) );
+        assert( std::find( infoB.refStoragePositions.begin(), infoB.refStoragePositions.end(), _refStoragePos ) != infoB.refStoragePositions.end() );
+        for( const Ref& ref : infoB.refStoragePositions )
+        {
+            assert( slot( ref ).load() != target );
+            slot( ref ).store( target, std::memory_order_release );
+        }
+        --mSize;
+        if( usage > 0 )
+            return;
+        fromLock.unlock();
+        if( toLock.owns_lock() )
+            toLock.unlock();
+        destroy( cacheRef );
     }
-    
-    template<typename T>
-    void Cache<T>::decayActivity()
-    {
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        mActivityIncrement *= (1 / mDecay);
-    }
-    
+
     template<typename T>
-    void Cache<T>::strengthenActivity( Ref _refStoragePos )
+    MemoryUsage Cache<T>::memory_usage()
     {
-        assert( _refStoragePos < mCacheRefs.size() );
-        TypeInfoPair<T,Info>* cacheRef = mCacheRefs[_refStoragePos];
-        assert( cacheRef != nullptr );
-        // update the activity of the cache entry at the given position
-        if( (cacheRef->second.activity += mActivityIncrement) > mActivityThreshold )
+        MemoryUsage res;
+        for( std::size_t i = 0; i <= mShardMask; ++i )
+        {
+            Shard& sh = mShards[i];
+            std::lock_guard<std::mutex> lock( sh.mutex );
+            res.objects += sh.entries.size();
+            for( const auto* entry : sh.entries )
+            {
+                res.object_bytes += sizeof(Entry) + sizeof(T) + entry->second.refStoragePositions.capacity() * sizeof(Ref);
+                res.object_bytes += entry->second.retired.size() * entry_bytes;
+            }
+            res.table_bytes += sh.entries.bucket_count() * sizeof(void*) + sh.entries.size() * memory::unordered_node<Entry*> + sh.clock.capacity() * sizeof(Entry*);
+        }
+        std::lock_guard<std::mutex> lock( mRefMutex );
+        for( std::size_t chunk = 0; chunk < max_chunks && mCacheRefs[chunk].load( std::memory_order_relaxed ) != nullptr; ++chunk )
         {
-            std::lock_guard<std::recursive_mutex> lock( mMutex );
-            // rescale if the threshold for the maximum activity has been exceeded
-            for( auto iter = mCache.begin(); iter != mCache.end(); ++iter )
-                (*iter)->second.activity *= mActivityDecrementFactor;
-            mActivityIncrement *= mActivityDecrementFactor;
-            mMaxActivity *= mActivityDecrementFactor;
+            res.id_bytes += chunk_size( chunk ) * sizeof(std::atomic<Entry*>);
         }
-        // update the maximum activity
-        std::lock_guard<std::recursive_mutex> lock( mMutex );
-        if( mMaxActivity < cacheRef->second.activity )
-            mMaxActivity = cacheRef->second.activity;
+        res.id_bytes += mUnusedPositionsInCacheRefs.size() * sizeof(Ref);
+        res.id_range = mNextRef;
+        std::size_t peakEntries = mPeakSize.load( std::memory_order_relaxed );
+        res.peak_bytes = std::max( res.total_bytes(), peakEntries * (entry_bytes + memory::unordered_node<Entry*> + sizeof(Entry*)) + res.id_bytes );
+        return res;
     }
     
     template<typename T>
@@ -262,26 +299,26 @@ namespace carl
     {
         _out << "General cache information:" << std::endl;
         _out << "   desired maximum cache size                                 : "  << mMaxCacheSize << std::endl;
+        _out << "   number of shards                                           : "  << (mShardMask + 1) << std::endl;
         _out << "   number of unused entries                                   : "  << mNumOfUnusedEntries << std::endl;
         _out << "   desired reduction amount when cleaning the cache (not used): "  << mCacheReductionAmount << std::endl;
-        _out << "   maximum of all activities                                  : "  << mMaxActivity << std::endl;
-        _out << "   the current value of the activity increment                : "  << mActivityIncrement << std::endl;
-        _out << "   decay factor for the given activities                      : "  << mDecay << std::endl;
-        _out << "   upper bound of the activities                              : "  << mActivityThreshold << std::endl;
-        _out << "   scaling factor of the activities                           : "  << mActivityDecrementFactor << std::endl;
-        _out << "   current size of the cache                                  : "  << mCache.size() << std::endl;
-        _out << "   number of yet involved references                          : "  << mCacheRefs.size() << std::endl;
+        _out << "   current size of the cache                                  : "  << mSize << std::endl;
+        _out << "   number of yet involved references                          : "  << mNextRef << std::endl;
         _out << "   number of currently freed references                       : "  << mUnusedPositionsInCacheRefs.size() << std::endl;
         _out << "Cache contains:" << std::endl;
-        for( auto iter = mCache.begin(); iter != mCache.end(); ++iter )
+        for( std::size_t i = 0; i <= mShardMask; ++i )
         {
-            assert( (*iter)->first != nullptr );
-            _out << "   " << *(*iter)->first << std::endl;
-            _out << "                       usage count: " << (*iter)->second.usageCount << std::endl;
-            _out << "        reference storage positions:";
-            for( Ref ref : (*iter)->second.refStoragePositions )
-                _out << "  " << ref;
-            _out << "                          activity: " << (*iter)->second.activity << std::endl;
+            for( auto iter = mShards[i].entries.begin(); iter != mShards[i].entries.end(); ++iter )
+            {
+                assert( (*iter)->first != nullptr );
+                _out << "   " << *(*iter)->first << std::endl;
+                _out << "                       usage count: " << (*iter)->second.usageCount << std::endl;
+                _out << "        reference storage positions:";
+                for( Ref ref : (*iter)->second.refStoragePositions )
+                    _out << "  " << ref;
+                _out << std::endl;
+                _out << "                     reference bit: " << (*iter)->second.referenced << std::endl;
+            }
         }
     }
     
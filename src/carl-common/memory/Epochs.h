@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * The stack of epochs of a pool, used to make backtracking cheap.
+ *
+ * An epoch holds a reference to every object that was created while it was the innermost epoch.
+ * Hence these objects are not freed one by one while the epoch is active, but in bulk when it is popped.
+ * Objects that are still referenced from outside of the epoch survive: they are promoted to the enclosing epoch or, if there is none, become ordinary objects of the pool.
+ *
+ * Epochs are global to a pool, i.e. they also record objects created by other threads.
+ * The pool is responsible for synchronization.
+ */
+template<typename Ref>
+class EpochStack {
+	std::vector<std::vector<Ref>> mEpochs;
+public:
+	std::size_t depth() const {
+		return mEpochs.size();
+	}
+	void push() {
+		mEpochs.emplace_back();
+	}
+	/// Adds a newly created object to the innermost epoch.
+	void record(Ref&& ref) {
+		assert(!mEpochs.empty());
+		mEpochs.back().push_back(std::move(ref));
+	}
+	/**
+	 * Removes the innermost epoch.
+	 * Objects that are still used are moved to the enclosing epoch, if there is one.
+	 * @param used Checks whether an object is referenced from outside of the epoch.
+	 * @return The references to all objects that were not moved.
+	 */
+	template<typename Used>
+	std::vector<Ref> pop(Used&& used) {
+		assert(!mEpochs.empty());
+		std::vector<Ref> epoch = std::move(mEpochs.back());
+		mEpochs.pop_back();
+		if (mEpochs.empty()) return epoch;
+		std::vector<Ref> res;
+		for (auto& ref: epoch) {
+			if (used(ref)) mEpochs.back().push_back(std::move(ref));
+			else res.push_back(std::move(ref));
+		}
+		return res;
+	}
+};
+
+/**
+ * Pushes an epoch of a pool on construction and pops it on destruction.
+ * @tparam Pool A pool providing push_epoch() and pop_epoch(), e.g. MonomialPool.
+ */
+template<typename Pool>
+class EpochScope {
+	Pool& mPool;
+public:
+	explicit EpochScope(Pool& pool = Pool::getInstance()): mPool(pool) {
+		mPool.push_epoch();
+	}
+	~EpochScope() {
+		mPool.pop_epoch();
+	}
+	EpochScope(const EpochScope&) = delete;
+	EpochScope& operator=(const EpochScope&) = delete;
+};
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Maps the ids of a pool before a compaction to the ids afterwards.
+ *
+ * Compaction keeps the relative order of the ids, hence containers that are sorted by id stay sorted.
+ */
+class IDRemapping {
+public:
+	/// Marks ids that were not used by a live object.
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+private:
+	std::vector<std::size_t> mMapping;
+	std::size_t mRange = 0;
+public:
+	/// Creates an empty mapping for ids below old_range.
+	explicit IDRemapping(std::size_t old_range): mMapping(old_range, npos) {}
+
+	void set(std::size_t old_id, std::size_t new_id) {
+		assert(old_id < mMapping.size());
+		assert(new_id <= old_id);
+		mMapping[old_id] = new_id;
+		mRange = std::max(mRange, new_id + 1);
+	}
+	/// Returns the new id of an object, or npos if no live object had this id.
+	std::size_t operator()(std::size_t old_id) const {
+		return old_id < mMapping.size() ? mMapping[old_id] : npos;
+	}
+	/// Number of ids that were reserved before the compaction.
+	std::size_t old_range() const {
+		return mMapping.size();
+	}
+	/// Number of ids that are reserved after the compaction, i.e. the largest new id plus one.
+	std::size_t new_range() const {
+		return mRange;
+	}
+};
+
+/**
+ * Callbacks that are run when a pool renumbers its objects.
+ *
+ * Data structures that store or are indexed by ids of pooled objects register a callback to update or shrink themselves.
+ * Callbacks are run while the pool is locked and must not create or free objects of this pool.
+ */
+class CompactionListeners {
+public:
+	using Callback = std::function<void(const IDRemapping&)>;
+private:
+	mutable std::mutex mMutex;
+	std::map<std::size_t, Callback> mCallbacks;
+	std::size_t mNextHandle = 0;
+public:
+	/// Adds a callback and returns a handle to remove it again.
+	std::size_t add(Callback&& callback) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCallbacks.emplace(mNextHandle, std::move(callback));
+		return mNextHandle++;
+	}
+	void remove(std::size_t handle) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCallbacks.erase(handle);
+	}
+	void notify(const IDRemapping& remapping) const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (const auto& c: mCallbacks) c.second(remapping);
+	}
+};
+
+}
@@ -27,6 +27,11 @@ namespace carl {
 			IDPOOL_LOCK;
 			return mLargestID;
 		}
+		/// Bytes used to store the free ids.
+		std::size_t memory_usage() const {
+			IDPOOL_LOCK;
+			return mFreeIDs.num_blocks() * Bitset::bits_per_block / 8;
+		}
 		std::size_t get() {
 			IDPOOL_LOCK;
 			std::size_t pos = mFreeIDs.find_first();
@@ -47,6 +52,17 @@ namespace carl {
 			IDPOOL_LOCK;
 			mFreeIDs = Bitset(true);
 		}
+		/**
+		 * Marks the ids below the given bound as used and all other ids as free.
+		 * This is used by pools that renumbered their objects into a dense range of ids.
+		 */
+		void compact(std::size_t used) {
+			IDPOOL_LOCK;
+			mFreeIDs = Bitset(true);
+			mFreeIDs.resize((used / Bitset::bits_per_block + 1) * Bitset::bits_per_block);
+			for (std::size_t id = 0; id < used; ++id) mFreeIDs.reset(id);
+			mLargestID = used == 0 ? 0 : used - 1;
+		}
 		friend std::ostream& operator<<(std::ostream& os, const IDPool& p) {
 			return os << "Free: " << p.mFreeIDs;
 		}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+namespace carl {
+
+/**
+ * Memory used by a pool or cache, in bytes.
+ *
+ * The numbers are estimates based on the sizes of the involved types and the capacities of the containers.
+ * They do not include the overhead of the memory allocator.
+ */
+struct MemoryUsage {
+	/// Number of live objects.
+	std::size_t objects = 0;
+	/// Bytes used by live objects, including the data they own (if known to the pool).
+	std::size_t object_bytes = 0;
+	/// Bytes used by the hash table or other index structures, e.g. bucket arrays.
+	std::size_t table_bytes = 0;
+	/// Bytes used to manage ids.
+	std::size_t id_bytes = 0;
+	/// Number of ids that are currently reserved, i.e. the largest id plus one.
+	std::size_t id_range = 0;
+	/// Largest total number of bytes used so far.
+	std::size_t peak_bytes = 0;
+
+	std::size_t total_bytes() const {
+		return object_bytes + table_bytes + id_bytes;
+	}
+	/// Average number of bytes per live object, including the overhead of the pool.
+	double bytes_per_object() const {
+		return objects == 0 ? 0 : static_cast<double>(total_bytes()) / static_cast<double>(objects);
+	}
+	/**
+	 * The fraction of reserved ids that are not used by live objects.
+	 * Data structures indexed by ids have to be sized by id_range, hence a high fragmentation wastes memory there.
+	 */
+	double id_fragmentation() const {
+		return id_range == 0 ? 0 : 1 - static_cast<double>(std::min(objects, id_range)) / static_cast<double>(id_range);
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const MemoryUsage& mu) {
+	return os << mu.objects << " objects, " << mu.total_bytes() << " bytes (objects: " << mu.object_bytes << ", table: " << mu.table_bytes << ", ids: " << mu.id_bytes << "), peak " << mu.peak_bytes << " bytes, id range " << mu.id_range;
+}
+
+/**
+ * Tracks the number and the size of the live objects of a pool as well as the peak memory usage.
+ * The pool is responsible for synchronization.
+ */
+class MemoryTracker {
+	std::size_t mObjects = 0;
+	std::size_t mBytes = 0;
+	std::size_t mPeak = 0;
+public:
+	/**
+	 * Records a new object.
+	 * @param bytes Size of the new object.
+	 * @param overhead Current size of the data structures of the pool itself.
+	 */
+	void allocated(std::size_t bytes, std::size_t overhead) {
+		++mObjects;
+		mBytes += bytes;
+		mPeak = std::max(mPeak, mBytes + overhead);
+	}
+	/// Records that an object of the given size was released.
+	void released(std::size_t bytes) {
+		--mObjects;
+		mBytes -= bytes;
+	}
+	/// Records a change of the data structures of the pool itself, e.g. a rehash.
+	void resized(std::size_t overhead) {
+		mPeak = std::max(mPeak, mBytes + overhead);
+	}
+
+	MemoryUsage usage(std::size_t table_bytes, std::size_t id_bytes, std::size_t id_range) const {
+		MemoryUsage res;
+		res.objects = mObjects;
+		res.object_bytes = mBytes;
+		res.table_bytes = table_bytes;
+		res.id_bytes = id_bytes;
+		res.id_range = id_range;
+		res.peak_bytes = std::max(mPeak, res.total_bytes());
+		return res;
+	}
+};
+
+namespace memory {
+	/// Estimated size of the control block of a std::shared_ptr that is not created by std::make_shared.
+	constexpr std::size_t shared_ptr_control_block = 2 * sizeof(void*) + 2 * sizeof(int);
+	/// Estimated size of a node of a std::unordered_set or std::unordered_map storing values of type T.
+	template<typename T>
+	constexpr std::size_t unordered_node = sizeof(void*) + sizeof(T) + sizeof(std::size_t);
+}
+
+}
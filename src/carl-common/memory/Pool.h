@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../config.h"
+#include "Epochs.h"
 #include "IDPool.h"
+#include "MemoryUsage.h"
 #include "PoolHelper.h"
 #include "Singleton.h"
 
@@ -79,6 +81,10 @@ namespace carl::pool {
         std::unique_ptr<typename UnderlyingSet::bucket_type[]> m_pool_buckets;
         /// The pool.
         UnderlyingSet m_pool;
+        /// Memory used by the elements in the pool.
+        MemoryTracker m_memory;
+        /// Elements created in the active epochs.
+        EpochStack<std::shared_ptr<PoolElementWrapper<Content>>> m_epochs;
         
         #ifdef THREAD_SAFE
         /// Mutex to avoid multiple access to the pool
@@ -98,9 +104,17 @@ namespace carl::pool {
                 auto new_buckets = new typename UnderlyingSet::bucket_type[rehash.second];
                 m_pool.rehash(typename UnderlyingSet::bucket_traits(new_buckets, rehash.second));
                 m_pool_buckets.reset(new_buckets);
+                m_memory.resized(overhead_bytes());
             }
         }
 
+        /// Bytes used by an element, including the control block of its shared pointer. Data owned by the content is not included.
+        static constexpr std::size_t object_bytes = sizeof(PoolElementWrapper<Content>) + memory::shared_ptr_control_block;
+        /// Bytes used by the pool itself.
+        std::size_t overhead_bytes() const {
+            return m_pool.bucket_count() * sizeof(typename UnderlyingSet::bucket_type) + m_ids.memory_usage();
+        }
+
     protected:
 
         explicit Pool(std::size_t _capacity = 1000)
@@ -128,10 +142,55 @@ namespace carl::pool {
                 shared.get()->m_weak_ptr = shared;
                 m_pool.insert_commit(*shared.get(), insert_data);
                 check_rehash();
+                m_memory.allocated(object_bytes, overhead_bytes());
+                if (m_epochs.depth() > 0) m_epochs.record(std::shared_ptr<PoolElementWrapper<Content>>(shared));
                 return shared;
             }
         }
 
+        std::size_t size() const {
+            return m_pool.size();
+        }
+        /**
+         * Returns the memory used by the pool and its elements.
+         */
+        MemoryUsage memory_usage() const {
+            DATASTRUCTURES_POOL_LOCK_GUARD
+            return m_memory.usage(m_pool.bucket_count() * sizeof(typename UnderlyingSet::bucket_type), m_ids.memory_usage(), m_ids.largestID() + 1);
+        }
+
+        /**
+         * Starts a new epoch: all elements created from now on are kept alive until the epoch is popped.
+         */
+        void push_epoch() {
+            DATASTRUCTURES_POOL_LOCK_GUARD
+            m_epochs.push();
+        }
+        /**
+         * Ends the innermost epoch and removes all elements created within it that are not referenced anymore.
+         * Elements that are still referenced are moved to the enclosing epoch, if there is one.
+         * @return The number of elements removed from the pool.
+         */
+        std::size_t pop_epoch() {
+            DATASTRUCTURES_POOL_LOCK_GUARD
+            auto elements = m_epochs.pop([](const auto& e) { return e.use_count() > 1; });
+            std::size_t released = 0;
+            for (const auto& e: elements) {
+                if (e.use_count() > 1) continue;
+                // Remove the element here such that the destructor does not need to look it up in the pool.
+                m_pool.erase(m_pool.iterator_to(*e));
+                m_ids.free(e->m_id);
+                m_memory.released(object_bytes);
+                e->m_id = 0;
+                ++released;
+            }
+            return released;
+        }
+        std::size_t epoch_depth() const {
+            DATASTRUCTURES_POOL_LOCK_GUARD
+            return m_epochs.depth();
+        }
+
     protected:
 
         void free(const PoolElementWrapper<Content>* c) {
@@ -141,6 +200,7 @@ namespace carl::pool {
                 assert(it != m_pool.end());
                 m_pool.erase(it);
                 m_ids.free(c->id());
+                m_memory.released(object_bytes);
             }
         }
     };
@@ -0,0 +1,368 @@
+/**
+ * @file DeferredRationalFunction.h
+ *
+ * Rational functions that keep numerator and denominator in factored form and cancel common factors lazily.
+ */
+
+#pragma once
+
+#include "RationalFunction.h"
+
+#include <carl-arith/numbers/numbers.h>
+#include <carl-arith/poly/umvpoly/functions/Division.h>
+#include <carl-arith/poly/umvpoly/functions/Evaluation.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
+#include <carl-arith/poly/umvpoly/functions/Power.h>
+#include <carl-common/util/hash.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Settings that control when a DeferredRationalFunction cancels common factors of its numerator and denominator.
+ */
+struct DeferredSimplificationSettings {
+	/// Cancel if numerator and denominator together consist of more distinct factors.
+	std::size_t max_factors = 8;
+	/// Cancel if numerator and denominator together have a larger total degree.
+	std::size_t max_degree = 32;
+};
+
+/**
+ * Pool of the factors of deferred rational functions.
+ *
+ * The factors are non-constant primitive polynomials with a positive leading coefficient and are identified by their id.
+ * The id zero is reserved for the constant one.
+ * The pool caches the gcd of every pair of factors it was asked for, including the quotients of the factors by their gcd.
+ * All methods are thread-safe, gcds are computed without holding the lock.
+ */
+template<typename Pol>
+class FactorPool {
+public:
+	using CoeffType = typename Pol::CoeffType;
+
+	/// The gcd of two factors and the quotients of the factors by the gcd, where the gcd is zero for coprime factors.
+	struct GCDResult {
+		std::size_t gcd;
+		std::size_t restA;
+		std::size_t restB;
+	};
+private:
+	struct Entry {
+		Pol polynomial;
+		std::size_t degree;
+	};
+	struct PairHash {
+		std::size_t operator()(const std::pair<std::size_t, std::size_t>& p) const {
+			return carl::hash_all(p.first, p.second);
+		}
+	};
+
+	mutable std::mutex mMutex;
+	/// The factors by their id, a deque keeps references valid while factors are added.
+	std::deque<Entry> mFactors;
+	std::unordered_map<Pol, std::size_t> mIds;
+	/// Cached gcds by the ids of the factors, where the first id is the smaller one.
+	std::unordered_map<std::pair<std::size_t, std::size_t>, GCDResult, PairHash> mGCDs;
+	std::size_t mGCDLookups = 0;
+	std::size_t mGCDComputations = 0;
+	DeferredSimplificationSettings mSettings;
+
+public:
+	explicit FactorPool(const DeferredSimplificationSettings& settings = DeferredSimplificationSettings()):
+		mSettings(settings)
+	{
+		mFactors.push_back(Entry{ Pol(CoeffType(1)), 0 });
+	}
+
+	FactorPool(const FactorPool&) = delete;
+	FactorPool& operator=(const FactorPool&) = delete;
+
+	const DeferredSimplificationSettings& settings() const {
+		return mSettings;
+	}
+
+	/**
+	 * Splits a non-zero polynomial into a constant and a factor such that the polynomial equals their product.
+	 * @return The constant and the id of the factor, which is zero if the polynomial is constant.
+	 */
+	std::pair<CoeffType, std::size_t> insert(const Pol& p) {
+		assert(!carl::is_zero(p));
+		if (p.is_constant()) return std::make_pair(p.constant_part(), std::size_t(0));
+		CoeffType factor = p.coprime_factor();
+		Pol primitive = p * factor;
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mIds.find(primitive);
+		if (it == mIds.end()) {
+			std::size_t degree = primitive.total_degree();
+			it = mIds.emplace(primitive, mFactors.size()).first;
+			mFactors.push_back(Entry{ std::move(primitive), degree });
+		}
+		return std::make_pair(CoeffType(1) / factor, it->second);
+	}
+
+	/// Returns the factor with the given id.
+	const Pol& get(std::size_t id) const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		assert(id < mFactors.size());
+		return mFactors[id].polynomial;
+	}
+
+	/// Returns the total degree of the factor with the given id.
+	std::size_t degree(std::size_t id) const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		assert(id < mFactors.size());
+		return mFactors[id].degree;
+	}
+
+	/// Returns the gcd of the two given distinct factors, which is computed at most once for every pair.
+	GCDResult gcd(std::size_t a, std::size_t b);
+
+	/// Number of factors in the pool, including the constant one.
+	std::size_t size() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mFactors.size();
+	}
+	/// Number of gcds that were requested.
+	std::size_t gcd_lookups() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mGCDLookups;
+	}
+	/// Number of gcds that were actually computed.
+	std::size_t gcd_computations() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mGCDComputations;
+	}
+};
+
+/**
+ * A rational function that defers the cancellation of common factors.
+ *
+ * In contrast to RationalFunction, numerator and denominator are kept as products of factors from a FactorPool and a rational coefficient.
+ * Multiplication and division only merge the factors, addition uses the product of the denominator factors as common denominator and only expands the numerator.
+ * Identical factors in numerator and denominator are always cancelled as this is cheap.
+ * Cancellation via gcds only happens if the size of the function exceeds the thresholds of the pool's settings or if simplify() is called.
+ * The gcds of pairs of factors are cached in the pool, hence functions from the same pool share this work.
+ *
+ * Constant functions do not need a pool, all non-constant functions that are combined must use the same pool.
+ */
+template<typename Pol>
+class DeferredRationalFunction {
+	static_assert(!needs_cache_type<Pol>::value, "DeferredRationalFunction manages its own factors");
+public:
+	using PolyType = Pol;
+	using CoeffType = typename Pol::CoeffType;
+	using Pool = FactorPool<Pol>;
+	/// Ids of factors with their exponents, sorted by id.
+	using Factors = std::vector<std::pair<std::size_t, exponent>>;
+
+private:
+	std::shared_ptr<Pool> mPool;
+	CoeffType mCoefficient;
+	Factors mNumerator;
+	Factors mDenominator;
+
+	static std::shared_ptr<Pool> choosePool(const std::shared_ptr<Pool>& a, const std::shared_ptr<Pool>& b) {
+		assert(a == nullptr || b == nullptr || a == b);
+		return a != nullptr ? a : b;
+	}
+
+	/// Multiplies the factors a by the factors b, or divides if negative is set. The latter requires that b divides a.
+	template<bool negative = false>
+	static Factors merge(const Factors& a, const Factors& b);
+	/// The factors that occur in both a and b with the minimal exponent.
+	static Factors meet(const Factors& a, const Factors& b);
+	/// The factors that occur in a or b with the maximal exponent.
+	static Factors join(const Factors& a, const Factors& b);
+
+	Pol expand(const Factors& factors) const;
+	std::size_t degree(const Factors& factors) const;
+	/// Sets the numerator to the given polynomial times the given factors.
+	void setNumerator(const Pol& p, Factors&& factors);
+	/// Cancels identical factors of numerator and denominator.
+	void cancelIdentical();
+	/// Cancels common factors of numerator and denominator if the thresholds are exceeded.
+	void checkThresholds();
+
+	template<bool byInverse>
+	DeferredRationalFunction& add(const DeferredRationalFunction& rhs);
+
+public:
+	DeferredRationalFunction():
+		mCoefficient(0)
+	{}
+
+	explicit DeferredRationalFunction(const CoeffType& c, std::shared_ptr<Pool> pool = nullptr):
+		mPool(std::move(pool)),
+		mCoefficient(c)
+	{}
+
+	DeferredRationalFunction(const Pol& p, std::shared_ptr<Pool> pool):
+		mPool(std::move(pool)),
+		mCoefficient(0)
+	{
+		assert(mPool != nullptr);
+		if (!carl::is_zero(p)) setNumerator(p, Factors());
+	}
+
+	/// Creates the quotient of the given polynomials without looking for common factors.
+	DeferredRationalFunction(const Pol& nom, const Pol& denom, std::shared_ptr<Pool> pool):
+		mPool(std::move(pool)),
+		mCoefficient(0)
+	{
+		assert(mPool != nullptr);
+		assert(!carl::is_zero(denom));
+		if (carl::is_zero(nom)) return;
+		auto [c, id] = mPool->insert(denom);
+		if (id != 0) mDenominator.emplace_back(id, 1);
+		setNumerator(nom, Factors());
+		mCoefficient /= c;
+		cancelIdentical();
+	}
+
+	const std::shared_ptr<Pool>& pool() const {
+		return mPool;
+	}
+	const CoeffType& coefficient() const {
+		return mCoefficient;
+	}
+	const Factors& nominatorFactors() const {
+		return mNumerator;
+	}
+	const Factors& denominatorFactors() const {
+		return mDenominator;
+	}
+
+	bool is_zero() const {
+		return carl::is_zero(mCoefficient);
+	}
+	bool is_constant() const {
+		return mNumerator.empty() && mDenominator.empty();
+	}
+
+	/// The numerator in its current, possibly not cancelled form.
+	Pol nominator() const {
+		return expand(mNumerator) * CoeffType(carl::get_num(mCoefficient));
+	}
+	/// The denominator in its current, possibly not cancelled form.
+	Pol denominator() const {
+		return expand(mDenominator) * CoeffType(carl::get_denom(mCoefficient));
+	}
+
+	/**
+	 * Cancels all common factors of numerator and denominator.
+	 * Afterwards, the expanded numerator and denominator are coprime.
+	 */
+	void simplify();
+
+	/// Returns the normal form as a simplified RationalFunction.
+	template<bool AS = false>
+	RationalFunction<Pol, AS> normal_form() const {
+		DeferredRationalFunction tmp(*this);
+		tmp.simplify();
+		if (tmp.is_constant()) return RationalFunction<Pol, AS>(tmp.mCoefficient);
+		return RationalFunction<Pol, AS>(std::make_pair(tmp.nominator(), tmp.denominator()), CoeffType(0), true);
+	}
+
+	DeferredRationalFunction inverse() const {
+		assert(!is_zero());
+		DeferredRationalFunction res(*this);
+		std::swap(res.mNumerator, res.mDenominator);
+		res.mCoefficient = CoeffType(1) / mCoefficient;
+		return res;
+	}
+
+	/// Evaluates the function, every factor is evaluated separately.
+	CoeffType evaluate(const std::map<Variable, CoeffType>& substitutions) const;
+
+	DeferredRationalFunction& operator+=(const DeferredRationalFunction& rhs) {
+		return add<false>(rhs);
+	}
+	DeferredRationalFunction& operator+=(const CoeffType& rhs) {
+		return add<false>(DeferredRationalFunction(rhs));
+	}
+	DeferredRationalFunction& operator-=(const DeferredRationalFunction& rhs) {
+		return add<true>(rhs);
+	}
+	DeferredRationalFunction& operator-=(const CoeffType& rhs) {
+		return add<true>(DeferredRationalFunction(rhs));
+	}
+	DeferredRationalFunction& operator*=(const DeferredRationalFunction& rhs);
+	DeferredRationalFunction& operator*=(const CoeffType& rhs) {
+		mCoefficient *= rhs;
+		if (carl::is_zero(mCoefficient)) {
+			mNumerator.clear();
+			mDenominator.clear();
+		}
+		return *this;
+	}
+	DeferredRationalFunction& operator/=(const DeferredRationalFunction& rhs) {
+		return *this *= rhs.inverse();
+	}
+	DeferredRationalFunction& operator/=(const CoeffType& rhs) {
+		assert(!carl::is_zero(rhs));
+		mCoefficient /= rhs;
+		return *this;
+	}
+
+	template<typename P>
+	friend bool operator==(const DeferredRationalFunction<P>& lhs, const DeferredRationalFunction<P>& rhs);
+	template<typename P>
+	friend std::ostream& operator<<(std::ostream& os, const DeferredRationalFunction<P>& rhs);
+};
+
+template<typename Pol>
+DeferredRationalFunction<Pol> operator+(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) += rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator+(const DeferredRationalFunction<Pol>& lhs, const typename Pol::CoeffType& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) += rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator-(const DeferredRationalFunction<Pol>& lhs) {
+	return DeferredRationalFunction<Pol>(lhs) *= typename Pol::CoeffType(-1);
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator-(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) -= rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator-(const DeferredRationalFunction<Pol>& lhs, const typename Pol::CoeffType& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) -= rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator*(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) *= rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator*(const DeferredRationalFunction<Pol>& lhs, const typename Pol::CoeffType& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) *= rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator*(const typename Pol::CoeffType& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return DeferredRationalFunction<Pol>(rhs) *= lhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator/(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) /= rhs;
+}
+template<typename Pol>
+DeferredRationalFunction<Pol> operator/(const DeferredRationalFunction<Pol>& lhs, const typename Pol::CoeffType& rhs) {
+	return DeferredRationalFunction<Pol>(lhs) /= rhs;
+}
+template<typename Pol>
+bool operator!=(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	return !(lhs == rhs);
+}
+
+} // namespace carl
+
+#include "DeferredRationalFunction.tpp"
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "DeferredRationalFunction.h"
+
+namespace carl {
+
+template<typename Pol>
+typename FactorPool<Pol>::GCDResult FactorPool<Pol>::gcd(std::size_t a, std::size_t b) {
+	assert(a != 0 && b != 0 && a != b);
+	bool swapped = a > b;
+	if (swapped) std::swap(a, b);
+	auto result = [swapped](const GCDResult& res) {
+		return swapped ? GCDResult{ res.gcd, res.restB, res.restA } : res;
+	};
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		++mGCDLookups;
+		auto it = mGCDs.find(std::make_pair(a, b));
+		if (it != mGCDs.end()) return result(it->second);
+	}
+	const Pol& pa = get(a);
+	const Pol& pb = get(b);
+	GCDResult res{ 0, a, b };
+	Pol g = carl::gcd(pa, pb);
+	if (!g.is_constant()) {
+		res.gcd = insert(g).second;
+		const Pol& primitive = get(res.gcd);
+		// The quotients of primitive polynomials by a primitive polynomial are primitive.
+		auto [ca, restA] = insert(carl::quotient(pa, primitive));
+		auto [cb, restB] = insert(carl::quotient(pb, primitive));
+		assert(carl::is_one(ca) && carl::is_one(cb));
+		res.restA = restA;
+		res.restB = restB;
+	}
+	std::lock_guard<std::mutex> lock(mMutex);
+	++mGCDComputations;
+	mGCDs.emplace(std::make_pair(a, b), res);
+	return result(res);
+}
+
+template<typename Pol>
+template<bool negative>
+typename DeferredRationalFunction<Pol>::Factors DeferredRationalFunction<Pol>::merge(const Factors& a, const Factors& b) {
+	Factors res;
+	res.reserve(a.size() + b.size());
+	auto ia = a.begin();
+	auto ib = b.begin();
+	while (ia != a.end() || ib != b.end()) {
+		if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+			res.push_back(*ia++);
+		} else if (ia == a.end() || ib->first < ia->first) {
+			assert(!negative);
+			res.push_back(*ib++);
+		} else {
+			if constexpr (negative) {
+				assert(ia->second >= ib->second);
+				if (ia->second > ib->second) res.emplace_back(ia->first, ia->second - ib->second);
+			} else {
+				res.emplace_back(ia->first, ia->second + ib->second);
+			}
+			++ia;
+			++ib;
+		}
+	}
+	return res;
+}
+
+template<typename Pol>
+typename DeferredRationalFunction<Pol>::Factors DeferredRationalFunction<Pol>::meet(const Factors& a, const Factors& b) {
+	Factors res;
+	auto ia = a.begin();
+	auto ib = b.begin();
+	while (ia != a.end() && ib != b.end()) {
+		if (ia->first < ib->first) ++ia;
+		else if (ib->first < ia->first) ++ib;
+		else {
+			res.emplace_back(ia->first, std::min(ia->second, ib->second));
+			++ia;
+			++ib;
+		}
+	}
+	return res;
+}
+
+template<typename Pol>
+typename DeferredRationalFunction<Pol>::Factors DeferredRationalFunction<Pol>::join(const Factors& a, const Factors& b) {
+	Factors res;
+	res.reserve(a.size() + b.size());
+	auto ia = a.begin();
+	auto ib = b.begin();
+	while (ia != a.end() || ib != b.end()) {
+		if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) res.push_back(*ia++);
+		else if (ia == a.end() || ib->first < ia->first) res.push_back(*ib++);
+		else {
+			res.emplace_back(ia->first, std::max(ia->second, ib->second));
+			++ia;
+			++ib;
+		}
+	}
+	return res;
+}
+
+template<typename Pol>
+Pol DeferredRationalFunction<Pol>::expand(const Factors& factors) const {
+	Pol res(CoeffType(1));
+	for (const auto& [id, exp]: factors) {
+		if (exp == 1) res *= mPool->get(id);
+		else res *= carl::pow(mPool->get(id), exp);
+	}
+	return res;
+}
+
+template<typename Pol>
+std::size_t DeferredRationalFunction<Pol>::degree(const Factors& factors) const {
+	std::size_t res = 0;
+	for (const auto& [id, exp]: factors) {
+		res += mPool->degree(id) * exp;
+	}
+	return res;
+}
+
+template<typename Pol>
+void DeferredRationalFunction<Pol>::setNumerator(const Pol& p, Factors&& factors) {
+	auto [c, id] = mPool->insert(p);
+	mCoefficient = c;
+	mNumerator = std::move(factors);
+	if (id != 0) mNumerator = merge(mNumerator, Factors({ std::make_pair(id, exponent(1)) }));
+}
+
+template<typename Pol>
+void DeferredRationalFunction<Pol>::cancelIdentical() {
+	Factors common = meet(mNumerator, mDenominator);
+	if (common.empty()) return;
+	mNumerator = merge<true>(mNumerator, common);
+	mDenominator = merge<true>(mDenominator, common);
+}
+
+template<typename Pol>
+void DeferredRationalFunction<Pol>::checkThresholds() {
+	if (mPool == nullptr) return;
+	const auto& settings = mPool->settings();
+	if (mNumerator.size() + mDenominator.size() > settings.max_factors || degree(mNumerator) + degree(mDenominator) > settings.max_degree) {
+		simplify();
+	}
+}
+
+template<typename Pol>
+void DeferredRationalFunction<Pol>::simplify() {
+	if (mPool == nullptr) return;
+	cancelIdentical();
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (std::size_t i = 0; i < mNumerator.size() && !changed; ++i) {
+			for (std::size_t j = 0; j < mDenominator.size() && !changed; ++j) {
+				auto [num, en] = mNumerator[i];
+				auto [den, ed] = mDenominator[j];
+				auto res = mPool->gcd(num, den);
+				if (res.gcd == 0) continue;
+				// Split both factors into the gcd and the remaining quotient, the gcd then cancels.
+				auto split = [&res](std::size_t rest, exponent e) {
+					Factors f({ std::make_pair(res.gcd, e) });
+					if (rest != 0) f = merge(f, Factors({ std::make_pair(rest, e) }));
+					return f;
+				};
+				mNumerator = merge(merge<true>(mNumerator, Factors({ mNumerator[i] })), split(res.restA, en));
+				mDenominator = merge(merge<true>(mDenominator, Factors({ mDenominator[j] })), split(res.restB, ed));
+				cancelIdentical();
+				changed = true;
+			}
+		}
+	}
+}
+
+template<typename Pol>
+typename DeferredRationalFunction<Pol>::CoeffType DeferredRationalFunction<Pol>::evaluate(const std::map<Variable, CoeffType>& substitutions) const {
+	CoeffType res = mCoefficient;
+	for (const auto& [id, exp]: mNumerator) {
+		res *= carl::pow(carl::evaluate(mPool->get(id), substitutions), exp);
+	}
+	for (const auto& [id, exp]: mDenominator) {
+		res /= carl::pow(carl::evaluate(mPool->get(id), substitutions), exp);
+	}
+	return res;
+}
+
+template<typename Pol>
+template<bool byInverse>
+DeferredRationalFunction<Pol>& DeferredRationalFunction<Pol>::add(const DeferredRationalFunction<Pol>& rhs) {
+	if (rhs.is_zero()) return *this;
+	if (is_zero()) {
+		*this = byInverse ? -rhs : rhs;
+		return *this;
+	}
+	mPool = choosePool(mPool, rhs.mPool);
+	if (is_constant() && rhs.is_constant()) {
+		if (byInverse) mCoefficient -= rhs.mCoefficient;
+		else mCoefficient += rhs.mCoefficient;
+		return *this;
+	}
+	// Factors of both numerators are kept, the common denominator is the product of all denominator factors.
+	Factors common = meet(mNumerator, rhs.mNumerator);
+	Factors denominator = join(mDenominator, rhs.mDenominator);
+	Pol lhsPart = expand(merge<true>(mNumerator, common)) * expand(merge<true>(denominator, mDenominator)) * mCoefficient;
+	Pol rhsPart = expand(merge<true>(rhs.mNumerator, common)) * expand(merge<true>(denominator, rhs.mDenominator)) * rhs.mCoefficient;
+	if (byInverse) lhsPart -= rhsPart;
+	else lhsPart += rhsPart;
+	if (carl::is_zero(lhsPart)) {
+		mCoefficient = CoeffType(0);
+		mNumerator.clear();
+		mDenominator.clear();
+		return *this;
+	}
+	mDenominator = std::move(denominator);
+	setNumerator(lhsPart, std::move(common));
+	cancelIdentical();
+	checkThresholds();
+	return *this;
+}
+
+template<typename Pol>
+DeferredRationalFunction<Pol>& DeferredRationalFunction<Pol>::operator*=(const DeferredRationalFunction<Pol>& rhs) {
+	mPool = choosePool(mPool, rhs.mPool);
+	if (is_zero() || rhs.is_zero()) {
+		mCoefficient = CoeffType(0);
+		mNumerator.clear();
+		mDenominator.clear();
+		return *this;
+	}
+	mCoefficient *= rhs.mCoefficient;
+	if (rhs.is_constant()) return *this;
+	mNumerator = merge(mNumerator, rhs.mNumerator);
+	mDenominator = merge(mDenominator, rhs.mDenominator);
+	cancelIdentical();
+	checkThresholds();
+	return *this;
+}
+
+template<typename Pol>
+bool operator==(const DeferredRationalFunction<Pol>& lhs, const DeferredRationalFunction<Pol>& rhs) {
+	if (lhs.mNumerator == rhs.mNumerator && lhs.mDenominator == rhs.mDenominator && (lhs.mPool == rhs.mPool || lhs.is_constant())) {
+		return lhs.mCoefficient == rhs.mCoefficient;
+	}
+	return lhs.nominator() * rhs.denominator() == rhs.nominator() * lhs.denominator();
+}
+
+template<typename Pol>
+std::ostream& operator<<(std::ostream& os, const DeferredRationalFunction<Pol>& rhs) {
+	if (rhs.is_constant()) return os << rhs.mCoefficient;
+	auto print = [&os, &rhs](const auto& factors) {
+		for (const auto& [id, exp]: factors) {
+			os << "*(" << rhs.mPool->get(id) << ")";
+			if (exp > 1) os << "^" << exp;
+		}
+	};
+	os << "(" << rhs.mCoefficient;
+	print(rhs.mNumerator);
+	os << ")/(1";
+	print(rhs.mDenominator);
+	return os << ")";
+}
+
+} // namespace carl
@@ -62,9 +62,8 @@ namespace carl
                 Factorization<P> factorization;
                 PolynomialFactorizationPair<P>* pfPair = new PolynomialFactorizationPair<P>( std::move( factorization), new P(poly) );
                 //Factorization is not set yet
-                auto ret = mpCache->cache( pfPair );//, &carl::canBeUpdated, &carl::update );
+                auto ret = mpCache->cacheAndReg( pfPair );
                 mCacheRef = ret.first;
-                mpCache->reg( mCacheRef );
                 if( ret.second )
                 {
                     assert( content().mFactorization.empty() );
@@ -106,9 +105,8 @@ namespace carl
             for ( auto factor = _factorization.begin(); factor != _factorization.end(); factor++ )
                 assert( carl::is_one(factor->first.coefficient()) );
             PolynomialFactorizationPair<P>* pfPair = new PolynomialFactorizationPair<P>( std::move( _factorization ) );
-            auto ret = mpCache->cache( pfPair );//, &carl::canBeUpdated, &carl::update );
+            auto ret = mpCache->cacheAndReg( pfPair );
             mCacheRef = ret.first;
-            mpCache->reg( mCacheRef );
             if( !ret.second )
             {
                 delete pfPair;
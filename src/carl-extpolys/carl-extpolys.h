@@ -1,4 +1,5 @@
 #pragma once
 
 #include "FactorizedPolynomial.h"
-#include "RationalFunction.h"
\ No newline at end of file
+#include "RationalFunction.h"
+#include "DeferredRationalFunction.h"
\ No newline at end of file
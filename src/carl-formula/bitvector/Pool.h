@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <carl-common/memory/MemoryUsage.h>
 #include <carl-common/util/container_types.h>
 #include <carl-common/memory/Singleton.h>
 
@@ -69,6 +70,29 @@ namespace carl
 
 	public:
 
+		std::size_t size() const
+		{
+			POOL_LOCK_GUARD
+			return mPool.size();
+		}
+
+		/**
+		 * Returns the memory used by the pool and its elements.
+		 * Elements are never removed from the pool, hence the current usage is also the peak usage.
+		 * Data owned by the elements is not included.
+		 */
+		MemoryUsage memory_usage() const
+		{
+			POOL_LOCK_GUARD
+			MemoryUsage res;
+			res.objects = mPool.size();
+			res.object_bytes = mPool.size() * sizeof(Element);
+			res.table_bytes = mPool.bucket_count() * sizeof(void*) + mPool.size() * memory::unordered_node<ElementPtr>;
+			res.id_range = mIdAllocator;
+			res.peak_bytes = res.total_bytes();
+			return res;
+		}
+
 		void print() const
 		{
 			std::cout << "Pool contains:" << std::endl;
@@ -7,9 +7,13 @@
 
 #pragma once
 
+#include <carl-common/memory/Epochs.h>
+#include <carl-common/memory/IDCompaction.h>
+#include <carl-common/memory/MemoryUsage.h>
 #include <carl-common/memory/Singleton.h>
 #include <carl-arith/core/VariablePool.h>
 #include "Formula.h"
+#include <algorithm>
 #include <mutex>
 #include <limits>
 #include <boost/variant.hpp>
@@ -49,6 +53,12 @@ namespace carl
             std::unique_ptr<typename underlying_set::bucket_type[]> mPoolBuckets;
             /// The formula pool.
             underlying_set mPool;
+            /// Memory used by the formulas in the pool.
+            MemoryTracker mMemory;
+            /// Callbacks for data structures that depend on formula ids.
+            CompactionListeners mCompactionListeners;
+            /// Formulas created in the active epochs.
+            EpochStack<Formula<Pol>> mEpochs;
             #ifdef THREAD_SAFE
             /// Mutex to avoid multiple access to the pool
             mutable std::recursive_mutex mMutexPool;
@@ -94,6 +104,110 @@ namespace carl
                 return mPool.size();
             }
 
+            /**
+             * Returns the memory used by the pool and the formulas it contains.
+             * Every object is a formula together with its negation.
+             */
+            MemoryUsage memory_usage() const
+            {
+                FORMULA_POOL_LOCK_GUARD
+                return mMemory.usage(table_bytes(), 0, mIdAllocator);
+            }
+
+            /// Callbacks that are run when compact() renumbers the formulas.
+            CompactionListeners& compaction_listeners()
+            {
+                return mCompactionListeners;
+            }
+
+            /**
+             * Renumbers the formulas in the pool such that their ids form a dense range again.
+             * The relative order of the ids is kept, hence sets of formulas stay sorted, and every negation still has the id following the id of the negated formula.
+             * Afterwards, the compaction listeners are notified.
+             *
+             * It must only be called at a quiescent point, i.e. while no other thread creates or frees formulas.
+             * @return The mapping from the old to the new ids.
+             */
+            IDRemapping compact()
+            {
+                FORMULA_POOL_LOCK_GUARD
+                std::vector<FormulaContent<Pol>*> contents;
+                contents.reserve(mPool.size());
+                for (auto& content: mPool) {
+                    if (&content != mpTrue && &content != mpFalse) contents.push_back(&content);
+                }
+                std::sort(contents.begin(), contents.end(), [](const auto* lhs, const auto* rhs) { return lhs->mId < rhs->mId; });
+
+                IDRemapping remapping(mIdAllocator);
+                remapping.set(mpTrue->mId, mpTrue->mId);
+                remapping.set(mpFalse->mId, mpFalse->mId);
+                unsigned next = 3;
+                for (auto* content: contents) {
+                    auto* negation = const_cast<FormulaContent<Pol>*>(content->mNegation);
+                    assert(negation->mId == content->mId + 1);
+                    remapping.set(content->mId, next);
+                    remapping.set(negation->mId, next + 1);
+                    content->mId = next;
+                    negation->mId = next + 1;
+                    next += 2;
+                }
+                CARL_LOG_DEBUG("carl.formula", "Compacted formula ids from " << mIdAllocator << " to " << next);
+                mIdAllocator = next;
+                mCompactionListeners.notify(remapping);
+                return remapping;
+            }
+
+            /**
+             * Starts a new epoch: all formulas created from now on are kept alive until the epoch is popped.
+             * This avoids freeing short-lived formulas one by one, e.g. within a step of a backtracking search.
+             */
+            void push_epoch()
+            {
+                FORMULA_POOL_LOCK_GUARD
+                mEpochs.push();
+            }
+
+            /**
+             * Ends the innermost epoch and frees all formulas created within it that are not referenced anymore.
+             * Formulas that are still referenced are moved to the enclosing epoch, if there is one.
+             * @return The number of formulas that were not referenced anymore.
+             */
+            std::size_t pop_epoch()
+            {
+                FORMULA_POOL_LOCK_GUARD
+                // A formula that is only referenced by the pool itself and the epoch has two usages.
+                auto formulas = mEpochs.pop([](const Formula<Pol>& f) { return f.mpContent->mUsages > 2; });
+                std::size_t released = std::count_if(formulas.begin(), formulas.end(), [](const Formula<Pol>& f) { return f.mpContent->mUsages <= 2; });
+                formulas.clear();
+                CARL_LOG_DEBUG("carl.formula", "Released " << released << " formulas of the epoch");
+                return released;
+            }
+
+            std::size_t epoch_depth() const
+            {
+                FORMULA_POOL_LOCK_GUARD
+                return mEpochs.depth();
+            }
+
+            /**
+             * Creates a formula of the given type for each list of subformulas, e.g. the clauses of a CNF.
+             * The pool is locked once for the whole batch and the hash table is resized at most once beforehand.
+             * @param _type The type of the formulas, must be AND, OR, XOR or IFF.
+             * @param _batch The subformulas of every formula.
+             * @return The formulas in the order of the batch.
+             */
+            std::vector<Formula<Pol>> create_batch( FormulaType _type, std::vector<Formulas<Pol>>&& _batch )
+            {
+                assert( _type == FormulaType::AND || _type == FormulaType::OR || _type == FormulaType::XOR || _type == FormulaType::IFF );
+                std::vector<Formula<Pol>> res;
+                res.reserve( _batch.size() );
+                FORMULA_POOL_LOCK_GUARD
+                check_rehash( mPool.size() + _batch.size() );
+                for( auto& subformulas: _batch )
+                    res.push_back( Formula<Pol>( createNAry( _type, std::move( subformulas ) ) ) );
+                return res;
+            }
+
             void print() const
             {
                 std::cout << "Formula pool contains:" << std::endl;
@@ -487,8 +601,7 @@ namespace carl
                         auto it = mPool.find(*tmp);
                         assert(it != mPool.end());
                         mPool.erase(it);
-                        delete tmp->mNegation;
-                        delete tmp;
+                        destroy(tmp);
                     }
                 }
             }
@@ -509,8 +622,7 @@ namespace carl
                         mTseitinVarToFormula.erase( tmp );
 						CARL_LOG_TRACE("carl.formula", "Deleting " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " from pool");
                         mPool.erase( *tmp );
-                        delete tmp->mNegation;
-                        delete tmp;
+                        destroy(tmp);
                     }
                     else // the tseitin variable is used, so we cannot delete the formula
                         stillStoredAsTseitinVariable = true;
@@ -531,8 +643,7 @@ namespace carl
                             mTseitinVarToFormula.erase( tmpTVIter );
 							CARL_LOG_TRACE("carl.formula", "Deleting " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " from pool");
                             mPool.erase( *tmp );
-                            delete tmp->mNegation;
-                            delete tmp;
+                            destroy(tmp);
                         }
                         else // the formula is used, so we cannot delete the tseitin variable
                             stillStoredAsTseitinVariable = true;
@@ -598,14 +709,38 @@ namespace carl
             const FormulaContent<Pol>* add( FormulaContent<Pol>&& _formula );
 
             void check_rehash() {
-                auto rehash = mRehashPolicy.needRehash(mPool.bucket_count(), mPool.size());
+                check_rehash(mPool.size());
+            }
+            /// Resizes the hash table if necessary to hold the given number of formulas.
+            void check_rehash(std::size_t _size) {
+                auto rehash = mRehashPolicy.needRehash(mPool.bucket_count(), _size);
                 if (rehash.first) {
                     auto new_buckets = new typename underlying_set::bucket_type[rehash.second];
                     mPool.rehash(typename underlying_set::bucket_traits(new_buckets, rehash.second));
                     mPoolBuckets.reset(new_buckets);
+                    mMemory.resized(table_bytes());
                 }
             }
 
+            /// Bytes used by a formula and its negation, including the list of subformulas.
+            static std::size_t object_bytes(const FormulaContent<Pol>& content) {
+                std::size_t res = 2 * sizeof(FormulaContent<Pol>);
+                if (const auto* subformulas = std::get_if<Formulas<Pol>>(&content.mContent)) res += subformulas->capacity() * sizeof(Formula<Pol>);
+                return res;
+            }
+            /// Bytes used by the bucket array and the maps of Tseitin variables.
+            std::size_t table_bytes() const {
+                return mPool.bucket_count() * sizeof(typename underlying_set::bucket_type)
+                    + mTseitinVars.bucket_count() * sizeof(void*) + mTseitinVars.size() * memory::unordered_node<typename decltype(mTseitinVars)::value_type>
+                    + mTseitinVarToFormula.bucket_count() * sizeof(void*) + mTseitinVarToFormula.size() * memory::unordered_node<typename decltype(mTseitinVarToFormula)::value_type>;
+            }
+            /// Deletes a formula and its negation that were already removed from the pool.
+            void destroy(const FormulaContent<Pol>* content) {
+                mMemory.released(object_bytes(*content));
+                delete content->mNegation;
+                delete content;
+            }
+
     };
 }    // namespace carl
 
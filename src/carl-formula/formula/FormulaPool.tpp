@@ -9,6 +9,8 @@
 
 #include "FormulaPool.h"
 
+#include <carl-statistics/carl-profiling.h>
+
 namespace carl
 {
     template<typename Pol>
@@ -37,6 +39,8 @@ namespace carl
     FormulaPool<Pol>::~FormulaPool()
     {
         // assert( mPool.size() == 2 );
+        while( mEpochs.depth() > 0 )
+            pop_epoch();
         mPool.clear();
         delete mpTrue;
         delete mpFalse;
@@ -46,6 +50,7 @@ namespace carl
     const FormulaContent<Pol>* FormulaPool<Pol>::add( FormulaContent<Pol>&& _element )
     {
         assert( _element.mType != FormulaType::NOT );
+        CARL_PROFILE_ZONE("formula.pool.add");
         FORMULA_POOL_LOCK_GUARD
 
         typename underlying_set::insert_commit_data insert_data;
@@ -69,6 +74,8 @@ namespace carl
             Formula<Pol>::init( *negation );
             ++mIdAllocator;
             assert(mPool.find(*negation) == mPool.end());
+            mMemory.allocated(object_bytes(*cont), table_bytes());
+            if (mEpochs.depth() > 0) mEpochs.record(Formula<Pol>(cont));
 			CARL_LOG_DEBUG("carl.formula", "Added " << cont << " / " << negation << " to pool");
             return cont;
         } else {
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "ModelVariable.h"
+
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * An associative container from ModelVariable to some value that can be used as a drop-in replacement for the `std::map` within a carl::Model.
+	 *
+	 * Arithmetic and Boolean variables are stored in a vector that is indexed by the variable id.
+	 * As the VariablePool hands out consecutive ids for every variable type, this vector stays small and lookups boil down to a single index computation.
+	 * All other model variables (bitvector and uninterpreted variables, uninterpreted functions) as well as variables with a nonzero rank are stored in a hash map.
+	 *
+	 * Iteration first visits the dense part in the order of the variables and afterwards the hash map in an unspecified order.
+	 * Note that, unlike for `std::map`, inserting a new element may invalidate iterators.
+	 */
+	template<typename T>
+	class DenseModelMap {
+	public:
+		using key_type = ModelVariable;
+		using mapped_type = T;
+		using value_type = std::pair<const key_type, mapped_type>;
+		using size_type = std::size_t;
+	private:
+		using Slot = std::optional<value_type>;
+		using Sparse = std::unordered_map<key_type, mapped_type>;
+		static_assert(std::is_same<value_type, typename Sparse::value_type>::value, "Should be the same type");
+
+		/// Number of variable types that are stored in the dense part.
+		static constexpr std::size_t dense_types = 3;
+
+		/// Dense part. Iterators pointing into this part carry mSparse.begin() to continue with the sparse part.
+		std::vector<Slot> mDense;
+		Sparse mSparse;
+		std::size_t mDenseSize = 0;
+
+		/**
+		 * Returns the index into mDense for the given key or the maximal std::size_t if the key belongs to the sparse part.
+		 * The index respects the order of variables with rank zero.
+		 */
+		static std::size_t dense_index(const key_type& key) {
+			if (!key.is_variable()) return std::numeric_limits<std::size_t>::max();
+			Variable v = key.asVariable();
+			if (v.rank() != 0) return std::numeric_limits<std::size_t>::max();
+			auto type = static_cast<std::size_t>(v.type());
+			if (type >= dense_types) return std::numeric_limits<std::size_t>::max();
+			return v.id() * dense_types + type;
+		}
+		static bool is_dense(std::size_t index) {
+			return index != std::numeric_limits<std::size_t>::max();
+		}
+
+		template<bool Const>
+		class Iterator {
+			friend class DenseModelMap;
+			template<bool> friend class Iterator;
+			using Container = std::conditional_t<Const, const DenseModelMap, DenseModelMap>;
+			using SparseIt = std::conditional_t<Const, typename Sparse::const_iterator, typename Sparse::iterator>;
+			Container* mMap = nullptr;
+			std::size_t mIndex = 0;
+			SparseIt mSparse;
+
+			Iterator(Container* map, std::size_t index, SparseIt sparse): mMap(map), mIndex(index), mSparse(sparse) {
+				skip_empty();
+			}
+			void skip_empty() {
+				while (mIndex < mMap->mDense.size() && !mMap->mDense[mIndex]) ++mIndex;
+			}
+			bool in_dense() const {
+				return mIndex < mMap->mDense.size();
+			}
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = DenseModelMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+			Iterator() = default;
+			template<bool C = Const, typename = std::enable_if_t<C>>
+			Iterator(const Iterator<false>& it): mMap(it.mMap), mIndex(it.mIndex), mSparse(it.mSparse) {}
+
+			reference operator*() const {
+				if (in_dense()) return *mMap->mDense[mIndex];
+				return *mSparse;
+			}
+			pointer operator->() const {
+				return &**this;
+			}
+			Iterator& operator++() {
+				if (in_dense()) {
+					++mIndex;
+					skip_empty();
+				} else {
+					++mSparse;
+				}
+				return *this;
+			}
+			Iterator operator++(int) {
+				Iterator res = *this;
+				++(*this);
+				return res;
+			}
+			friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+				assert(lhs.mMap == rhs.mMap);
+				if (lhs.mIndex != rhs.mIndex) return false;
+				if (lhs.in_dense()) return true;
+				return lhs.mSparse == rhs.mSparse;
+			}
+			friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+				return !(lhs == rhs);
+			}
+		};
+	public:
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		// Iterators
+		iterator begin() {
+			return iterator(this, 0, mSparse.begin());
+		}
+		iterator end() {
+			return iterator(this, mDense.size(), mSparse.end());
+		}
+		const_iterator begin() const {
+			return const_iterator(this, 0, mSparse.begin());
+		}
+		const_iterator end() const {
+			return const_iterator(this, mDense.size(), mSparse.end());
+		}
+
+		// Capacity
+		bool empty() const {
+			return size() == 0;
+		}
+		size_type size() const {
+			return mDenseSize + mSparse.size();
+		}
+
+		// Element access
+		const mapped_type& at(const key_type& key) const {
+			auto it = find(key);
+			if (it == end()) throw std::out_of_range("DenseModelMap::at");
+			return it->second;
+		}
+		mapped_type& at(const key_type& key) {
+			auto it = find(key);
+			if (it == end()) throw std::out_of_range("DenseModelMap::at");
+			return it->second;
+		}
+
+		// Lookup
+		iterator find(const key_type& key) {
+			std::size_t index = dense_index(key);
+			if (is_dense(index)) {
+				if (index < mDense.size() && mDense[index]) return iterator(this, index, mSparse.begin());
+				return end();
+			}
+			return iterator(this, mDense.size(), mSparse.find(key));
+		}
+		const_iterator find(const key_type& key) const {
+			std::size_t index = dense_index(key);
+			if (is_dense(index)) {
+				if (index < mDense.size() && mDense[index]) return const_iterator(this, index, mSparse.begin());
+				return end();
+			}
+			return const_iterator(this, mDense.size(), mSparse.find(key));
+		}
+		size_type count(const key_type& key) const {
+			return find(key) == end() ? 0 : 1;
+		}
+
+		// Modifiers
+		void clear() {
+			mDense.clear();
+			mSparse.clear();
+			mDenseSize = 0;
+		}
+		template<typename... Args>
+		std::pair<iterator,bool> emplace(const key_type& key, Args&& ...args) {
+			std::size_t index = dense_index(key);
+			if (is_dense(index)) {
+				if (index >= mDense.size()) mDense.resize(index + 1);
+				if (mDense[index]) return std::make_pair(iterator(this, index, mSparse.begin()), false);
+				mDense[index].emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+				++mDenseSize;
+				return std::make_pair(iterator(this, index, mSparse.begin()), true);
+			}
+			auto res = mSparse.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return std::make_pair(iterator(this, mDense.size(), res.first), res.second);
+		}
+		template<typename... Args>
+		iterator emplace_hint(const_iterator, const key_type& key, Args&& ...args) {
+			return emplace(key, std::forward<Args>(args)...).first;
+		}
+		template<typename P>
+		std::pair<iterator,bool> insert(const P& pair) {
+			return emplace(pair.first, pair.second);
+		}
+		template<typename P>
+		iterator insert(const_iterator, const P& pair) {
+			return insert(pair).first;
+		}
+		iterator erase(const_iterator it) {
+			assert(it.mMap == this);
+			if (it.in_dense()) {
+				assert(mDense[it.mIndex]);
+				mDense[it.mIndex].reset();
+				--mDenseSize;
+				return iterator(this, it.mIndex + 1, mSparse.begin());
+			}
+			return iterator(this, mDense.size(), mSparse.erase(it.mSparse));
+		}
+		iterator erase(iterator it) {
+			return erase(const_iterator(it));
+		}
+		size_type erase(const key_type& key) {
+			auto it = find(key);
+			if (it == end()) return 0;
+			erase(it);
+			return 1;
+		}
+	};
+}
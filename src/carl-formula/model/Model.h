@@ -1,9 +1,13 @@
 #pragma once
 
+#include <carl-common/config.h>
 #include <carl-logging/carl-logging.h>
 
 #include "ModelVariable.h"
 #include "ModelValue.h"
+#ifdef DENSE_MODEL
+#include "DenseModelMap.h"
+#endif
 
 namespace carl
 {
@@ -14,18 +18,25 @@ namespace carl
 	 * for these variables.
 	 * Most notably, a value can be a "carl::ModelSubstitution" whose value depends
 	 * on the values of other variables in the Model.
+	 *
+	 * The assignments are stored in a std::map by default. If DENSE_MODEL is set,
+	 * a carl::DenseModelMap is used instead, which avoids tree lookups for arithmetic
+	 * and Boolean variables.
 	 */
 	template<typename Rational, typename Poly>
 	class Model {
 	public:
 		using key_type = ModelVariable;
 		using mapped_type = ModelValue<Rational,Poly>;
+#ifdef DENSE_MODEL
+		using Map = DenseModelMap<mapped_type>;
+#else
 		using Map = std::map<key_type,mapped_type>;
+#endif
 		static_assert(std::is_same<key_type, typename Map::key_type>::value, "Should be the same type");
 		static_assert(std::is_same<mapped_type, typename Map::mapped_type>::value, "Should be the same type");
 	private:
 		Map mData;
-		std::map<key_type, std::size_t> mUsedInSubstitution;
 		void resetCaches() const {
 			for (const auto& d: mData) {
 				if (d.second.isSubstitution()) {
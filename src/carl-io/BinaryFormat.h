@@ -0,0 +1,64 @@
+#pragma once
+
+#include <gmp.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace carl::io::binary {
+
+/**
+ * Common definitions of the binary format that is written by BinaryWriter and read by BinaryReader.
+ *
+ * A file starts with a header: the magic string "CARLBIN", the format version, the size of a GMP limb in bytes and the endianness of the limbs.
+ * It is followed by a sequence of objects, each consisting of an ObjectKind byte and the object itself.
+ *
+ * - Unsigned numbers (counts, exponents, ids) are stored as varints: seven bits per byte, least significant first, the high bit marks continuation.
+ * - Integers are stored as a varint holding the number of limbs and the sign, followed by zero bytes up to the next limb boundary (relative to the start of the file) and the raw GMP limbs.
+ *   Hence a reader on an aligned buffer, for example a memory mapped file, can use the limbs in place.
+ * - Rationals are stored as numerator and denominator, where a denominator of zero limbs denotes one.
+ * - Variables are referenced by a varint: zero introduces a new variable whose type (byte) and name (varint length and bytes) follow; n > 0 refers to the n-th variable introduced before.
+ * - Formulas are stored as DAGs in the same way: zero introduces a new node whose definition follows, n > 0 refers to the n-th node defined before.
+ *   Nodes are numbered in the order their definitions are completed, i.e. after their subformulas.
+ * Variables and formula nodes are numbered for the whole file, hence later objects refer to the variables and nodes of earlier objects.
+ */
+
+/// Version of the format, increased on every incompatible change.
+inline constexpr std::uint8_t version = 1;
+/// Magic string at the start of every file.
+inline constexpr std::string_view magic = "CARLBIN";
+/// Size of the header in bytes.
+inline constexpr std::size_t header_size = magic.size() + 3;
+/// Endianness marker stored in the header.
+inline constexpr std::uint8_t endianness = std::endian::native == std::endian::little ? 0 : 1;
+
+/// Kinds of objects that are stored at the top level.
+enum class ObjectKind: std::uint8_t {
+	MultivariatePolynomial = 1,
+	UnivariatePolynomial = 2,
+	Formula = 3,
+	Model = 4,
+	RealAlgebraicNumber = 5
+};
+
+/// Kinds of coefficients of univariate polynomials.
+enum class CoefficientKind: std::uint8_t {
+	Number = 0,
+	MultivariatePolynomial = 1
+};
+
+/// Kinds of values in models.
+enum class ValueKind: std::uint8_t {
+	Bool = 0,
+	Rational = 1,
+	RealAlgebraicNumber = 2
+};
+
+/// Number of padding bytes that are needed at the given offset to reach the next limb boundary.
+inline std::size_t limb_padding(std::size_t offset) {
+	return (sizeof(mp_limb_t) - offset % sizeof(mp_limb_t)) % sizeof(mp_limb_t);
+}
+
+}
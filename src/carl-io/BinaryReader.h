@@ -0,0 +1,362 @@
+#pragma once
+
+#include "BinaryFormat.h"
+#include "MappedFile.h"
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/numbers/numbers.h>
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/ran/interval/Ran.h>
+#include <carl-formula/formula/Formula.h>
+#include <carl-formula/model/Model.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carl::io {
+
+/**
+ * Reads objects in the binary format described in BinaryFormat.h, as written by BinaryWriter.
+ *
+ * The reader works directly on the input, for example a memory mapped file, without copying it.
+ * If the input is aligned to limbs, which memory mapped files always are, integers are read from their limbs in place.
+ * Variables are identified by their names: variables registered via addVariable() are reused, all others are created freshly.
+ * Distinct variables of the input that have the same name are read as distinct variables.
+ * Malformed input results in a std::runtime_error.
+ */
+template<typename Pol>
+class BinaryReader {
+	static_assert(std::is_same_v<typename Pol::CoeffType, mpq_class>, "BinaryReader only supports GMP rationals");
+private:
+	std::optional<MappedFile> mFile;
+	const char* mBegin;
+	const char* mCur;
+	const char* mEnd;
+	/// Whether the input is aligned such that the limbs can be read in place.
+	bool mAligned;
+
+	/// Known variables by name.
+	std::unordered_map<std::string, Variable> mNames;
+	/// Variables of the input by their number.
+	std::vector<Variable> mVariables;
+	/// Variables that were already assigned a number of the input.
+	std::unordered_set<Variable> mAssigned;
+	/// Formula nodes of the input by their number.
+	std::vector<Formula<Pol>> mNodes;
+	/// Buffer for limbs if the input is not aligned.
+	std::vector<mp_limb_t> mLimbs;
+
+	[[noreturn]] void error(const std::string& msg) const {
+		throw std::runtime_error("BinaryReader: " + msg + " at offset " + std::to_string(mCur - mBegin));
+	}
+	void require(std::size_t n) const {
+		if (static_cast<std::size_t>(mEnd - mCur) < n) error("unexpected end of input");
+	}
+
+	std::uint8_t byte() {
+		require(1);
+		return static_cast<std::uint8_t>(*mCur++);
+	}
+	std::uint64_t varint() {
+		std::uint64_t res = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			std::uint8_t b = byte();
+			res |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+			if ((b & 0x80) == 0) return res;
+		}
+		error("invalid varint");
+	}
+	std::size_t count() {
+		std::uint64_t n = varint();
+		// Every element takes at least one byte, which bounds the allocations for malformed input.
+		if (n > static_cast<std::uint64_t>(mEnd - mCur)) error("invalid count");
+		return static_cast<std::size_t>(n);
+	}
+
+	/// Reads an integer from its header, i.e. the number of limbs and the sign.
+	void read_integer(std::uint64_t header, mpz_ptr res) {
+		std::size_t limbs = static_cast<std::size_t>(header / 2);
+		mCur += std::min(binary::limb_padding(static_cast<std::size_t>(mCur - mBegin)), static_cast<std::size_t>(mEnd - mCur));
+		if (limbs > static_cast<std::size_t>(mEnd - mCur) / sizeof(mp_limb_t)) error("unexpected end of input");
+		const mp_limb_t* data;
+		if (mAligned) {
+			data = reinterpret_cast<const mp_limb_t*>(mCur);
+		} else {
+			mLimbs.resize(limbs);
+			std::memcpy(mLimbs.data(), mCur, limbs * sizeof(mp_limb_t));
+			data = mLimbs.data();
+		}
+		mCur += limbs * sizeof(mp_limb_t);
+		mpz_t view;
+		mpz_srcptr n = mpz_roinit_n(view, data, static_cast<mp_size_t>(limbs));
+		if (header % 2 == 1) mpz_neg(res, n);
+		else mpz_set(res, n);
+	}
+	mpq_class read_number() {
+		mpq_class res;
+		read_integer(varint(), mpq_numref(res.get_mpq_t()));
+		std::uint64_t header = varint();
+		if (header != 0) {
+			read_integer(header, mpq_denref(res.get_mpq_t()));
+			if (mpz_sgn(mpq_denref(res.get_mpq_t())) == 0) error("zero denominator");
+			mpq_canonicalize(res.get_mpq_t());
+		}
+		return res;
+	}
+
+	Variable read_variable() {
+		std::uint64_t n = varint();
+		if (n > 0) {
+			if (n > mVariables.size()) error("unknown variable");
+			return mVariables[n - 1];
+		}
+		std::uint8_t type = byte();
+		if (type > static_cast<std::uint8_t>(VariableType::MAX_TYPE)) error("invalid variable type");
+		std::size_t size = count();
+		std::string name(mCur, size);
+		mCur += size;
+		auto it = mNames.find(name);
+		if (it == mNames.end() || it->second.type() != static_cast<VariableType>(type)) {
+			it = mNames.insert_or_assign(name, fresh_variable(name, static_cast<VariableType>(type))).first;
+		}
+		Variable res = it->second;
+		// Another variable of the input already has this name.
+		if (!mAssigned.insert(res).second) {
+			res = fresh_variable(name, static_cast<VariableType>(type));
+			mAssigned.insert(res);
+		}
+		mVariables.push_back(res);
+		return res;
+	}
+
+	Pol read_polynomial() {
+		std::size_t terms = count();
+		typename Pol::TermsType res;
+		res.reserve(terms);
+		std::vector<std::pair<Variable, exponent>> exponents;
+		for (std::size_t i = 0; i < terms; ++i) {
+			mpq_class coeff = read_number();
+			std::size_t vars = count();
+			if (vars == 0) {
+				res.emplace_back(std::move(coeff));
+				continue;
+			}
+			exponents.clear();
+			exponent degree = 0;
+			for (std::size_t j = 0; j < vars; ++j) {
+				Variable v = read_variable();
+				exponent e = static_cast<exponent>(varint());
+				if (e == 0) error("zero exponent");
+				exponents.emplace_back(v, e);
+				degree += e;
+			}
+			// The variables of the input may be mapped to variables in a different order.
+			if (!std::is_sorted(exponents.begin(), exponents.end(), [](const auto& a, const auto& b){ return a.first < b.first; })) {
+				std::sort(exponents.begin(), exponents.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+			}
+			res.emplace_back(std::move(coeff), createMonomial(std::vector<std::pair<Variable, exponent>>(exponents), degree));
+		}
+		return Pol(std::move(res), true, false);
+	}
+	template<typename Coeff>
+	UnivariatePolynomial<Coeff> read_univariate() {
+		Variable var = read_variable();
+		auto kind = static_cast<binary::CoefficientKind>(byte());
+		bool expected = std::is_same_v<Coeff, Pol> ? kind == binary::CoefficientKind::MultivariatePolynomial : kind == binary::CoefficientKind::Number;
+		if (!expected) error("unexpected coefficient kind");
+		std::size_t size = count();
+		std::vector<Coeff> coeffs;
+		coeffs.reserve(size);
+		for (std::size_t i = 0; i < size; ++i) {
+			if constexpr (std::is_same_v<Coeff, Pol>) coeffs.push_back(read_polynomial());
+			else coeffs.push_back(read_number());
+		}
+		return UnivariatePolynomial<Coeff>(var, std::move(coeffs));
+	}
+	std::pair<mpq_class, BoundType> read_bound() {
+		std::uint8_t type = byte();
+		if (type > static_cast<std::uint8_t>(BoundType::INFTY)) error("invalid bound type");
+		if (static_cast<BoundType>(type) == BoundType::INFTY) return std::make_pair(mpq_class(0), BoundType::INFTY);
+		return std::make_pair(read_number(), static_cast<BoundType>(type));
+	}
+	IntRepRealAlgebraicNumber<mpq_class> read_ran() {
+		if (byte() == 1) {
+			return IntRepRealAlgebraicNumber<mpq_class>(read_number());
+		}
+		auto p = read_univariate<mpq_class>();
+		auto [lower, ltype] = read_bound();
+		auto [upper, utype] = read_bound();
+		if (p.degree() == 0) error("invalid real algebraic number");
+		return IntRepRealAlgebraicNumber<mpq_class>(p, Interval<mpq_class>(lower, ltype, upper, utype));
+	}
+
+	Formula<Pol> read_node() {
+		std::uint64_t n = varint();
+		if (n > 0) {
+			if (n > mNodes.size()) error("unknown formula node");
+			return mNodes[n - 1];
+		}
+		auto type = static_cast<FormulaType>(byte());
+		Formula<Pol> res;
+		switch (type) {
+			case FormulaType::TRUE:
+			case FormulaType::FALSE:
+				res = Formula<Pol>(type);
+				break;
+			case FormulaType::BOOL: {
+				Variable v = read_variable();
+				if (v.type() != VariableType::VT_BOOL) error("non-Boolean variable in formula");
+				res = Formula<Pol>(v);
+				break;
+			}
+			case FormulaType::CONSTRAINT: {
+				std::uint8_t rel = byte();
+				if (rel > static_cast<std::uint8_t>(Relation::GEQ)) error("invalid relation");
+				res = Formula<Pol>(read_polynomial(), static_cast<Relation>(rel));
+				break;
+			}
+			case FormulaType::NOT:
+				res = Formula<Pol>(FormulaType::NOT, read_node());
+				break;
+			case FormulaType::IMPLIES: {
+				Formula<Pol> premise = read_node();
+				res = Formula<Pol>(FormulaType::IMPLIES, premise, read_node());
+				break;
+			}
+			case FormulaType::ITE: {
+				Formula<Pol> condition = read_node();
+				Formula<Pol> first = read_node();
+				res = Formula<Pol>(FormulaType::ITE, condition, first, read_node());
+				break;
+			}
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::XOR:
+			case FormulaType::IFF: {
+				std::size_t size = count();
+				Formulas<Pol> subformulas;
+				subformulas.reserve(size);
+				for (std::size_t i = 0; i < size; ++i) subformulas.push_back(read_node());
+				res = Formula<Pol>(type, std::move(subformulas));
+				break;
+			}
+			default:
+				error("unsupported formula type");
+		}
+		mNodes.push_back(res);
+		return res;
+	}
+
+	Model<mpq_class, Pol> read_model() {
+		Model<mpq_class, Pol> res;
+		std::size_t size = count();
+		for (std::size_t i = 0; i < size; ++i) {
+			Variable v = read_variable();
+			switch (static_cast<binary::ValueKind>(byte())) {
+				case binary::ValueKind::Bool:
+					res.emplace(v, byte() != 0);
+					break;
+				case binary::ValueKind::Rational:
+					res.emplace(v, read_number());
+					break;
+				case binary::ValueKind::RealAlgebraicNumber:
+					res.emplace(v, read_ran());
+					break;
+				default:
+					error("invalid model value");
+			}
+		}
+		return res;
+	}
+
+	void expect(binary::ObjectKind kind) {
+		if (!hasNext()) error("no further object");
+		if (static_cast<binary::ObjectKind>(byte()) != kind) {
+			--mCur;
+			error("unexpected object kind");
+		}
+	}
+
+	void read_header() {
+		if (static_cast<std::size_t>(mEnd - mCur) < binary::header_size || std::string_view(mCur, binary::magic.size()) != binary::magic) error("invalid header");
+		mCur += binary::magic.size();
+		if (byte() != binary::version) error("unsupported version");
+		if (byte() != sizeof(mp_limb_t) || byte() != binary::endianness) error("incompatible limb format");
+	}
+public:
+	/// Reads from the given data, which must outlive the reader.
+	explicit BinaryReader(std::string_view data):
+		mBegin(data.data()),
+		mCur(data.data()),
+		mEnd(data.data() + data.size()),
+		mAligned(reinterpret_cast<std::uintptr_t>(data.data()) % alignof(mp_limb_t) == 0)
+	{
+		read_header();
+	}
+	/**
+	 * Reads from the given file, which is mapped into memory.
+	 * Throws std::system_error if the file can not be read.
+	 */
+	explicit BinaryReader(const std::string& filename):
+		mFile(std::in_place, filename),
+		mBegin(mFile->data()),
+		mCur(mFile->data()),
+		mEnd(mFile->data() + mFile->size()),
+		mAligned(true)
+	{
+		read_header();
+	}
+
+	/// Registers a variable that is used for variables of the same name and type.
+	void addVariable(Variable::Arg v) {
+		mNames.insert_or_assign(v.name(), v);
+	}
+	/// The variables of the input that were read so far, in the order of the input.
+	const std::vector<Variable>& variables() const {
+		return mVariables;
+	}
+
+	/// Checks if there is another object.
+	bool hasNext() const {
+		return mCur < mEnd;
+	}
+	/// Returns the kind of the next object.
+	binary::ObjectKind peek() const {
+		if (!hasNext()) error("no further object");
+		return static_cast<binary::ObjectKind>(*mCur);
+	}
+
+	/**
+	 * Reads the next object, which must be of the given type.
+	 * Supported are Pol, UnivariatePolynomial over rationals or Pol, Formula<Pol>, IntRepRealAlgebraicNumber<mpq_class> and Model<mpq_class, Pol>.
+	 */
+	template<typename T>
+	T read() {
+		if constexpr (std::is_same_v<T, Pol>) {
+			expect(binary::ObjectKind::MultivariatePolynomial);
+			return read_polynomial();
+		} else if constexpr (std::is_same_v<T, UnivariatePolynomial<mpq_class>> || std::is_same_v<T, UnivariatePolynomial<Pol>>) {
+			expect(binary::ObjectKind::UnivariatePolynomial);
+			return read_univariate<typename T::CoeffType>();
+		} else if constexpr (std::is_same_v<T, Formula<Pol>>) {
+			expect(binary::ObjectKind::Formula);
+			return read_node();
+		} else if constexpr (std::is_same_v<T, IntRepRealAlgebraicNumber<mpq_class>>) {
+			expect(binary::ObjectKind::RealAlgebraicNumber);
+			return read_ran();
+		} else {
+			static_assert(std::is_same_v<T, Model<mpq_class, Pol>>, "BinaryReader can not read this type");
+			expect(binary::ObjectKind::Model);
+			return read_model();
+		}
+	}
+};
+
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "BinaryFormat.h"
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/numbers/numbers.h>
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/ran/interval/Ran.h>
+#include <carl-formula/formula/Formula.h>
+#include <carl-formula/model/Model.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace carl::io {
+
+/**
+ * Writes polynomials, formulas, models and real algebraic numbers in the binary format described in BinaryFormat.h.
+ *
+ * The objects are collected in memory and can be obtained via data() or written to a file via save().
+ * Variables and formula nodes are written only once, later occurrences refer to them by their number.
+ * Only rational numbers (i.e. GMP) are supported as coefficients.
+ */
+template<typename Pol>
+class BinaryWriter {
+	static_assert(std::is_same_v<typename Pol::CoeffType, mpq_class>, "BinaryWriter only supports GMP rationals");
+private:
+	std::vector<char> mBuffer;
+	/// Numbers of the variables that were written so far.
+	std::unordered_map<Variable, std::size_t> mVariables;
+	/// Numbers of the formula nodes that were written so far. The formulas are kept alive such that their ids are not reused.
+	std::unordered_map<Formula<Pol>, std::size_t> mNodes;
+
+	void byte(std::uint8_t b) {
+		mBuffer.push_back(static_cast<char>(b));
+	}
+	void varint(std::uint64_t n) {
+		while (n >= 0x80) {
+			byte(static_cast<std::uint8_t>(n | 0x80));
+			n >>= 7;
+		}
+		byte(static_cast<std::uint8_t>(n));
+	}
+	void bytes(const void* data, std::size_t size) {
+		const char* c = static_cast<const char*>(data);
+		mBuffer.insert(mBuffer.end(), c, c + size);
+	}
+
+	void write_integer(mpz_srcptr n) {
+		std::size_t limbs = mpz_size(n);
+		varint(limbs * 2 + (mpz_sgn(n) < 0 ? 1 : 0));
+		mBuffer.resize(mBuffer.size() + binary::limb_padding(mBuffer.size()), '\0');
+		bytes(mpz_limbs_read(n), limbs * sizeof(mp_limb_t));
+	}
+	void write_number(const mpq_class& n) {
+		write_integer(mpq_numref(n.get_mpq_t()));
+		if (mpz_cmp_ui(mpq_denref(n.get_mpq_t()), 1) == 0) {
+			varint(0);
+		} else {
+			write_integer(mpq_denref(n.get_mpq_t()));
+		}
+	}
+
+	void write_variable(Variable v) {
+		auto it = mVariables.find(v);
+		if (it != mVariables.end()) {
+			varint(it->second);
+			return;
+		}
+		varint(0);
+		byte(static_cast<std::uint8_t>(v.type()));
+		std::string name = v.name();
+		varint(name.size());
+		bytes(name.data(), name.size());
+		mVariables.emplace(v, mVariables.size() + 1);
+	}
+
+	void write_polynomial(const Pol& p) {
+		varint(p.nr_terms());
+		for (const auto& term: p) {
+			write_number(term.coeff());
+			if (!term.monomial()) {
+				varint(0);
+				continue;
+			}
+			varint(term.monomial()->num_variables());
+			for (const auto& [var, exp]: *term.monomial()) {
+				write_variable(var);
+				varint(exp);
+			}
+		}
+	}
+	template<typename Coeff>
+	void write_univariate(const UnivariatePolynomial<Coeff>& p) {
+		write_variable(p.main_var());
+		if constexpr (std::is_same_v<Coeff, Pol>) {
+			byte(static_cast<std::uint8_t>(binary::CoefficientKind::MultivariatePolynomial));
+		} else {
+			static_assert(std::is_same_v<Coeff, mpq_class>, "BinaryWriter only supports rational or polynomial coefficients");
+			byte(static_cast<std::uint8_t>(binary::CoefficientKind::Number));
+		}
+		varint(p.coefficients().size());
+		for (const auto& c: p.coefficients()) {
+			if constexpr (std::is_same_v<Coeff, Pol>) write_polynomial(c);
+			else write_number(c);
+		}
+	}
+	template<typename Number>
+	void write_bound(const Number& n, BoundType type) {
+		byte(static_cast<std::uint8_t>(type));
+		if (type != BoundType::INFTY) write_number(n);
+	}
+	template<typename Number>
+	void write_ran(const IntRepRealAlgebraicNumber<Number>& ran) {
+		if (ran.is_numeric()) {
+			byte(1);
+			write_number(ran.value());
+			return;
+		}
+		byte(0);
+		write_univariate(ran.polynomial());
+		write_bound(ran.interval().lower(), ran.interval().lower_bound_type());
+		write_bound(ran.interval().upper(), ran.interval().upper_bound_type());
+	}
+
+	void write_node(const Formula<Pol>& f) {
+		auto it = mNodes.find(f);
+		if (it != mNodes.end()) {
+			varint(it->second);
+			return;
+		}
+		varint(0);
+		byte(static_cast<std::uint8_t>(f.type()));
+		switch (f.type()) {
+			case FormulaType::TRUE:
+			case FormulaType::FALSE:
+				break;
+			case FormulaType::BOOL:
+				write_variable(f.boolean());
+				break;
+			case FormulaType::CONSTRAINT:
+				byte(static_cast<std::uint8_t>(f.constraint().relation()));
+				write_polynomial(f.constraint().lhs());
+				break;
+			case FormulaType::NOT:
+				write_node(f.subformula());
+				break;
+			case FormulaType::IMPLIES:
+				write_node(f.premise());
+				write_node(f.conclusion());
+				break;
+			case FormulaType::ITE:
+				write_node(f.condition());
+				write_node(f.first_case());
+				write_node(f.second_case());
+				break;
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::XOR:
+			case FormulaType::IFF:
+				varint(f.subformulas().size());
+				for (const auto& sub: f.subformulas()) write_node(sub);
+				break;
+			default:
+				throw std::invalid_argument("BinaryWriter: unsupported formula type " + formulaTypeToString(f.type()));
+		}
+		mNodes.emplace(f, mNodes.size() + 1);
+	}
+
+	void object(binary::ObjectKind kind) {
+		byte(static_cast<std::uint8_t>(kind));
+	}
+	/// Writes an object such that nothing of it remains if writing it throws.
+	template<typename F>
+	void transaction(F&& f) {
+		std::size_t size = mBuffer.size();
+		std::size_t variables = mVariables.size();
+		std::size_t nodes = mNodes.size();
+		try {
+			f();
+		} catch (...) {
+			mBuffer.resize(size);
+			std::erase_if(mVariables, [variables](const auto& v){ return v.second > variables; });
+			std::erase_if(mNodes, [nodes](const auto& n){ return n.second > nodes; });
+			throw;
+		}
+	}
+public:
+	BinaryWriter() {
+		bytes(binary::magic.data(), binary::magic.size());
+		byte(binary::version);
+		byte(sizeof(mp_limb_t));
+		byte(binary::endianness);
+	}
+
+	/// Returns the data that was written so far.
+	std::string_view data() const {
+		return std::string_view(mBuffer.data(), mBuffer.size());
+	}
+
+	/**
+	 * Writes the data to the given file.
+	 * Throws std::system_error if the file can not be written.
+	 */
+	void save(const std::string& filename) const {
+		int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0) throw std::system_error(errno, std::generic_category(), "Could not open " + filename);
+		const char* pos = mBuffer.data();
+		const char* end = pos + mBuffer.size();
+		while (pos < end) {
+			auto n = ::write(fd, pos, static_cast<std::size_t>(end - pos));
+			if (n < 0) {
+				if (errno == EINTR) continue;
+				int error = errno;
+				::close(fd);
+				throw std::system_error(error, std::generic_category(), "Could not write " + filename);
+			}
+			pos += n;
+		}
+		::close(fd);
+	}
+
+	void write(const Pol& p) {
+		transaction([&](){
+			object(binary::ObjectKind::MultivariatePolynomial);
+			write_polynomial(p);
+		});
+	}
+	template<typename Coeff>
+	void write(const UnivariatePolynomial<Coeff>& p) {
+		transaction([&](){
+			object(binary::ObjectKind::UnivariatePolynomial);
+			write_univariate(p);
+		});
+	}
+	/**
+	 * Writes a formula.
+	 * Throws std::invalid_argument if it contains unsupported formula types, in which case nothing is written.
+	 */
+	void write(const Formula<Pol>& f) {
+		transaction([&](){
+			object(binary::ObjectKind::Formula);
+			write_node(f);
+		});
+	}
+	template<typename Number>
+	void write(const IntRepRealAlgebraicNumber<Number>& ran) {
+		transaction([&](){
+			object(binary::ObjectKind::RealAlgebraicNumber);
+			write_ran(ran);
+		});
+	}
+	/**
+	 * Writes a model.
+	 * Only assignments of variables to Booleans, rationals and real algebraic numbers are supported.
+	 * Otherwise std::invalid_argument is thrown and nothing is written.
+	 */
+	template<typename Rational>
+	void write(const Model<Rational, Pol>& model) {
+		transaction([&](){
+			object(binary::ObjectKind::Model);
+			varint(model.size());
+			for (const auto& [var, value]: model) {
+				if (!var.is_variable()) throw std::invalid_argument("BinaryWriter: unsupported model variable");
+				write_variable(var.asVariable());
+				if (value.isBool()) {
+					byte(static_cast<std::uint8_t>(binary::ValueKind::Bool));
+					byte(value.asBool() ? 1 : 0);
+				} else if (value.isRational()) {
+					byte(static_cast<std::uint8_t>(binary::ValueKind::Rational));
+					write_number(value.asRational());
+				} else if (value.isRAN()) {
+					byte(static_cast<std::uint8_t>(binary::ValueKind::RealAlgebraicNumber));
+					write_ran(value.asRAN());
+				} else {
+					throw std::invalid_argument("BinaryWriter: unsupported model value");
+				}
+			}
+		});
+	}
+};
+
+}
@@ -1,81 +1,223 @@
 #pragma once
 
-#include <fstream>
-#include <iostream>
-#include <regex>
-#include <sstream>
-#include <string>
+#include "MappedFile.h"
 
 #include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/FormulaPool.h>
 #include <carl-logging/carl-logging.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace carl::io {
 
 /**
  * Parser for the DIMACS format.
- * 
+ *
  * Allows for solving multiple formulas from one file by adding lines that only contain "reset".
+ *
+ * The file is mapped into memory and tokenized in a single pass.
+ * Large formulas can be tokenized by several threads, each of which handles a contiguous chunk of lines.
+ * The clauses are then created in batches via FormulaPool::create_batch().
  */
 template<typename Pol>
 class DIMACSImporter {
 private:
-	std::ifstream in;
+	/// Number of clauses that are passed to the formula pool at once.
+	static constexpr std::size_t batch_size = 4096;
+	/// Formulas smaller than this are tokenized by a single thread.
+	static constexpr std::size_t min_parallel_size = 1 << 18;
+
+	/// The literals of a chunk of lines, every clause is terminated by zero.
+	struct Chunk {
+		std::vector<int> literals;
+		/// Number of variables announced by a header, or zero.
+		std::size_t variables = 0;
+		/// Number of clauses announced by a header, or zero.
+		std::size_t clauses = 0;
+	};
+
+	MappedFile mFile;
+	const char* mPos;
+	const char* mEnd;
+	std::size_t mThreads;
 	std::vector<Formula<Pol>> variables;
-	std::regex headerRegex;
-	
-	Formula<Pol> parseLine(const std::string& line) const {
-		std::vector<Formula<Pol>> vars;
-		const char* begin = line.c_str();
-		char* end = nullptr;
-		long long id;
-		while (true) {
-			id = std::strtoll(begin, &end, 10);
-			begin = end;
-			if (id == 0) break;
-			Formula<Pol> v = variables.at(std::size_t(std::abs(id)-1));
-			if (id > 0) vars.emplace_back(v);
-			else vars.emplace_back(NOT, v);
+
+	/// Returns the end of the line starting at pos, excluding the newline.
+	static const char* line_end(const char* pos, const char* end) {
+		const char* res = static_cast<const char*>(std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+		return res == nullptr ? end : res;
+	}
+	static bool is_space(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+	static std::string_view trimmed(const char* begin, const char* end) {
+		while (begin != end && is_space(*begin)) ++begin;
+		while (begin != end && is_space(*(end - 1))) --end;
+		return std::string_view(begin, static_cast<std::size_t>(end - begin));
+	}
+
+	/// Parses the header "p cnf <variables> <clauses>".
+	static void parse_header(std::string_view line, Chunk& chunk) {
+		unsigned long long vars = 0;
+		unsigned long long clauses = 0;
+		std::string header(line);
+		if (std::sscanf(header.c_str(), "p cnf %llu %llu", &vars, &clauses) != 2) {
+			CARL_LOG_ERROR("carl.formula", "DIMACS line starting with \"p\" does not match header format: \"" << line << "\".");
+			return;
 		}
-		return std::move(Formula<Pol>(OR, std::move(vars)));
+		chunk.variables = std::max(chunk.variables, static_cast<std::size_t>(vars));
+		chunk.clauses = std::max(chunk.clauses, static_cast<std::size_t>(clauses));
 	}
-	
+
+	/// Tokenizes the lines between begin and end.
+	static Chunk tokenize(const char* begin, const char* end) {
+		Chunk res;
+		res.literals.reserve(static_cast<std::size_t>(end - begin) / 3);
+		const char* pos = begin;
+		while (pos < end) {
+			while (pos < end && is_space(*pos) && *pos != '\n') ++pos;
+			if (pos == end) break;
+			if (*pos == '\n') {
+				++pos;
+				continue;
+			}
+			if (*pos == 'c' || *pos == '%') {
+				pos = line_end(pos, end);
+				continue;
+			}
+			if (*pos == 'p') {
+				const char* eol = line_end(pos, end);
+				parse_header(std::string_view(pos, static_cast<std::size_t>(eol - pos)), res);
+				pos = eol;
+				continue;
+			}
+			// A line of literals, the terminating zero may be on a later line.
+			const char* eol = line_end(pos, end);
+			while (pos < eol) {
+				bool negative = false;
+				if (*pos == '-') {
+					negative = true;
+					++pos;
+				}
+				if (pos == eol || *pos < '0' || *pos > '9') {
+					CARL_LOG_ERROR("carl.formula", "Unexpected character in DIMACS clause: \"" << std::string_view(pos, static_cast<std::size_t>(eol - pos)) << "\".");
+					break;
+				}
+				int lit = 0;
+				while (pos < eol && *pos >= '0' && *pos <= '9') {
+					lit = lit * 10 + (*pos - '0');
+					++pos;
+				}
+				res.literals.push_back(negative ? -lit : lit);
+				while (pos < eol && is_space(*pos)) ++pos;
+			}
+			pos = eol;
+		}
+		return res;
+	}
+
+	/// Finds the end of the current formula, i.e. the next "reset" line, and the position after it.
+	std::pair<const char*, const char*> formula_end() const {
+		const char* pos = mPos;
+		while (pos < mEnd) {
+			const char* eol = line_end(pos, mEnd);
+			if (trimmed(pos, eol) == "reset") return std::make_pair(pos, eol == mEnd ? mEnd : eol + 1);
+			pos = eol == mEnd ? mEnd : eol + 1;
+		}
+		return std::make_pair(mEnd, mEnd);
+	}
+
+	/// Tokenizes the lines between begin and end, using several threads for large inputs.
+	std::vector<Chunk> tokenize_parallel(const char* begin, const char* end) const {
+		std::size_t size = static_cast<std::size_t>(end - begin);
+		std::size_t threads = std::max<std::size_t>(1, std::min(mThreads, size / min_parallel_size));
+		if (threads == 1) return { tokenize(begin, end) };
+		std::vector<std::future<Chunk>> futures;
+		const char* chunk_begin = begin;
+		for (std::size_t i = 1; i <= threads && chunk_begin < end; ++i) {
+			const char* chunk_end = i == threads ? end : line_end(std::max(chunk_begin, begin + size * i / threads), end);
+			if (chunk_end != end) ++chunk_end;
+			futures.push_back(std::async(std::launch::async, &DIMACSImporter::tokenize, chunk_begin, chunk_end));
+			chunk_begin = chunk_end;
+		}
+		std::vector<Chunk> res;
+		for (auto& f: futures) res.push_back(f.get());
+		return res;
+	}
+
+	void ensure_variables(std::size_t count) {
+		while (variables.size() < count) {
+			variables.emplace_back(fresh_boolean_variable());
+		}
+	}
+
 	Formula<Pol> parseFormula() {
-		std::string line;
+		auto [end, next] = formula_end();
+		std::vector<Chunk> chunks = tokenize_parallel(mPos, end);
+		mPos = next;
+
+		std::size_t clauses = 0;
+		for (const auto& chunk: chunks) {
+			ensure_variables(chunk.variables);
+			clauses = std::max(clauses, chunk.clauses);
+		}
 		std::vector<Formula<Pol>> formulas;
-		while (!in.eof()) {
-			std::getline(in, line);
-			if (line == "") continue;
-			if (line == "reset") break;
-			if (line.front() == 'c') continue;
-			if (line.front() == 'p') {
-				std::smatch m;
-				if (!std::regex_match(line, m, headerRegex)) {
-					CARL_LOG_ERROR("carl.formula", "DIMACS line starting with \"p\" does not match header format: \"" << line << "\".");
+		formulas.reserve(clauses);
+		std::vector<Formulas<Pol>> batch;
+		Formulas<Pol> clause;
+		auto flush = [&]() {
+			auto created = FormulaPool<Pol>::getInstance().create_batch(OR, std::move(batch));
+			formulas.insert(formulas.end(), std::make_move_iterator(created.begin()), std::make_move_iterator(created.end()));
+			batch.clear();
+		};
+		for (const auto& chunk: chunks) {
+			for (int lit: chunk.literals) {
+				if (lit == 0) {
+					batch.push_back(std::move(clause));
+					clause = Formulas<Pol>();
+					if (batch.size() == batch_size) flush();
+					continue;
 				}
-				std::size_t varCount = std::stoull(m[1]);
-				variables.reserve(varCount);
-				while (variables.size() < varCount) {
-					variables.emplace_back(fresh_boolean_variable());
+				std::size_t var = static_cast<std::size_t>(std::abs(lit));
+				if (var > variables.size()) {
+					CARL_LOG_WARN("carl.formula", "DIMACS variable " << var << " exceeds the number of variables in the header.");
+					ensure_variables(var);
 				}
-				continue;
+				const Formula<Pol>& v = variables[var - 1];
+				clause.push_back(lit > 0 ? v : v.negated());
 			}
-			formulas.push_back(parseLine(line));
 		}
+		if (!clause.empty()) batch.push_back(std::move(clause));
+		if (!batch.empty()) flush();
 		return Formula<Pol>(AND, std::move(formulas));
 	}
-	
+
 public:
-	/// Load the given file.
-	DIMACSImporter(const std::string& filename):
-		in(filename),
-		headerRegex("p cnf (\\d+) (\\d+)")
+	/**
+	 * Load the given file.
+	 * Throws std::system_error if the file can not be read.
+	 * @param filename The file to read.
+	 * @param threads The maximal number of threads that tokenize a formula.
+	 */
+	explicit DIMACSImporter(const std::string& filename, std::size_t threads = 1):
+		mFile(filename),
+		mPos(mFile.data()),
+		mEnd(mFile.data() + mFile.size()),
+		mThreads(std::max<std::size_t>(threads, 1))
 	{}
-	
+
 	/// Checks if there is another formula to parse.
 	bool hasNext() const {
-		return !in.eof();
+		return mPos < mEnd;
 	}
-	
+
 	/// Parses and returns the next formula (until the next reset line).
 	Formula<Pol> next() {
 		return parseFormula();
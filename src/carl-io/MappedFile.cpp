@@ -0,0 +1,63 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace carl::io {
+
+MappedFile::MappedFile(const std::string& filename) {
+	int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) throw std::system_error(errno, std::generic_category(), "Could not open " + filename);
+	struct stat st;
+	if (::fstat(fd, &st) != 0) {
+		int error = errno;
+		::close(fd);
+		throw std::system_error(error, std::generic_category(), "Could not stat " + filename);
+	}
+	mSize = static_cast<std::size_t>(st.st_size);
+	if (mSize > 0) {
+		void* data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			int error = errno;
+			::close(fd);
+			throw std::system_error(error, std::generic_category(), "Could not map " + filename);
+		}
+		::madvise(data, mSize, MADV_SEQUENTIAL);
+		mData = static_cast<const char*>(data);
+	}
+	::close(fd);
+}
+
+MappedFile::~MappedFile() {
+	unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+	mData(std::exchange(other.mData, nullptr)),
+	mSize(std::exchange(other.mSize, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		unmap();
+		mData = std::exchange(other.mData, nullptr);
+		mSize = std::exchange(other.mSize, 0);
+	}
+	return *this;
+}
+
+void MappedFile::unmap() {
+	if (mData != nullptr) {
+		::munmap(const_cast<char*>(mData), mSize);
+		mData = nullptr;
+		mSize = 0;
+	}
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace carl::io {
+
+/**
+ * A file that is mapped into memory read-only.
+ *
+ * The whole file is available as one contiguous range of characters without copying it,
+ * and the operating system reads the pages lazily while the file is processed sequentially.
+ */
+class MappedFile {
+private:
+	const char* mData = nullptr;
+	std::size_t mSize = 0;
+
+	void unmap();
+public:
+	/**
+	 * Maps the given file.
+	 * Throws std::system_error if the file can not be opened or mapped.
+	 */
+	explicit MappedFile(const std::string& filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	const char* data() const {
+		return mData;
+	}
+	std::size_t size() const {
+		return mSize;
+	}
+	/// The contents of the file, valid as long as this object is.
+	std::string_view view() const {
+		return std::string_view(mData, mSize);
+	}
+};
+
+}
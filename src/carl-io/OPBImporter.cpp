@@ -1,100 +1,135 @@
 #include "OPBImporter.h"
 
-#include "SpiritHelper.h"
-
-#include <tuple>
-#include <vector>
-
-#define BOOST_SPIRIT_USE_PHOENIX_V3
-#include <boost/fusion/adapted/std_tuple.hpp>
-#include <boost/fusion/include/std_pair.hpp>
-#include <boost/spirit/include/phoenix.hpp>
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/include/qi_parse.hpp>
-#include <boost/spirit/include/support_line_pos_iterator.hpp>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
 
 namespace carl::io {
-	namespace spirit = boost::spirit;
-	namespace qi = boost::spirit::qi;
-	namespace px = boost::phoenix;
 
-	using BaseIteratorType = spirit::istream_iterator;
-	using PositionIteratorType = spirit::line_pos_iterator<BaseIteratorType>;
-	using Iterator = PositionIteratorType;
-	using ErrorHandler = carl::io::helper::ErrorHandler;
-	
-	struct Skipper: public qi::grammar<Iterator> {
-		Skipper(): Skipper::base_type(main, "skipper") {
-			main = (qi::space | (qi::lit("*") > *(qi::char_ - qi::eol) > qi::eol));
-		};
-		qi::rule<Iterator> main;
-	};
-	
-	struct OPBParser: public qi::grammar<Iterator, OPBFile(), Skipper> {
-		OPBParser(): OPBParser::base_type(mMain, "OPBFile") {
-			mRelation.add
-				("=", Relation::EQ)
-				("!=", Relation::NEQ)
-				("<", Relation::LESS)
-				("<=", Relation::LEQ)
-				(">", Relation::GREATER)
-				(">=", Relation::GEQ)
-			;
-			mVarname = qi::lexeme[ qi::alpha > *(qi::alnum | qi::char_("_"))];
-			mNewVarWrapper = mVarname[qi::_val = px::bind(&OPBParser::addVariable, px::ref(*this), qi::_1)];
-			mTerm = qi::int_ >> (qi::lexeme[mVariables >> !(qi::alnum | qi::char_("_"))] | mNewVarWrapper);
-			mPolynomial = +mTerm;
-			mConstraint = mPolynomial > mRelation > qi::int_;
-			mObjective = -(qi::lit("min:") > mPolynomial > qi::lit(";"));
-			mMain = (mObjective >> *(mConstraint > ";"))[qi::_val = px::bind(&OPBParser::createFile, px::ref(*this), qi::_1, qi::_2)];
-			qi::on_error<qi::fail>(mMain, errorHandler(qi::_1, qi::_2, qi::_3, qi::_4));
+	/**
+	 * Hand-written parser for OPB files that works on the whole file in memory.
+	 * Comments start with "*" and extend to the end of the line.
+	 */
+	class OPBParser {
+	private:
+		const char* mBegin;
+		const char* mCur;
+		const char* mEnd;
+		/// Variables by name. The names refer to the input, which outlives the parser.
+		std::unordered_map<std::string_view, Variable> mVariables;
+
+		static bool is_space(char c) {
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
 		}
-		std::optional<OPBFile> parse(std::istream& in) {
-			in.unsetf(std::ios::skipws);
-			Skipper skipper;
-			BaseIteratorType basebegin(in);
-			Iterator begin(basebegin);
-			Iterator end;
-			OPBFile res;
-			if (qi::phrase_parse(begin, end, *this, skipper, res)) {
-				if (begin != end) {
-					std::cout << "Failed to parse:" << std::endl;
-					std::cout << "\"" << std::string(begin, end) << "\"" << std::endl;
-					return std::nullopt;
+		static bool is_digit(char c) {
+			return c >= '0' && c <= '9';
+		}
+		static bool is_alpha(char c) {
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+		}
+
+		/// Skips whitespace and comments and returns the next character, or zero at the end of the input.
+		char peek() {
+			while (mCur != mEnd) {
+				if (is_space(*mCur)) {
+					++mCur;
+				} else if (*mCur == '*') {
+					while (mCur != mEnd && *mCur != '\n') ++mCur;
+				} else {
+					return *mCur;
 				}
-				return res;
-			} else {
-				std::cout << "Failed to parse:" << std::endl;
-				std::cout << "\"" << std::string(begin, end) << "\"" << std::endl;
-				return std::nullopt;
 			}
+			return '\0';
 		}
-		
-	private:
-		Variable addVariable(const std::string& s) {
-			carl::Variable var = fresh_integer_variable(s);
-			mVariables.add(s, var);
-			return var;
+		bool accept(std::string_view s) {
+			peek();
+			if (static_cast<std::size_t>(mEnd - mCur) < s.size() || std::string_view(mCur, s.size()) != s) return false;
+			mCur += s.size();
+			return true;
 		}
-		OPBFile createFile(const OPBPolynomial& obj, const std::vector<OPBConstraint>& constraints) {
-			return OPBFile(obj, constraints);
+		bool integer(int& res) {
+			char c = peek();
+			bool negative = c == '-';
+			if (c == '-' || c == '+') ++mCur;
+			if (mCur == mEnd || !is_digit(*mCur)) return false;
+			res = 0;
+			while (mCur != mEnd && is_digit(*mCur)) {
+				res = res * 10 + (*mCur - '0');
+				++mCur;
+			}
+			if (negative) res = -res;
+			return true;
 		}
+		bool variable(Variable& res) {
+			if (!is_alpha(peek())) return false;
+			const char* start = mCur;
+			while (mCur != mEnd && (is_alpha(*mCur) || is_digit(*mCur) || *mCur == '_')) ++mCur;
+			std::string_view name(start, static_cast<std::size_t>(mCur - start));
+			auto it = mVariables.find(name);
+			if (it == mVariables.end()) {
+				it = mVariables.emplace(name, fresh_integer_variable(std::string(name))).first;
+			}
+			res = it->second;
+			return true;
+		}
+		/// Reads a sequence of terms, i.e. integers followed by variables.
+		bool polynomial(OPBPolynomial& res) {
+			while (true) {
+				char c = peek();
+				if (!is_digit(c) && c != '-' && c != '+') return !res.empty();
+				int coeff;
+				Variable var;
+				if (!integer(coeff) || !variable(var)) return false;
+				res.emplace_back(coeff, var);
+			}
+		}
+		bool relation(Relation& res) {
+			if (accept(">=")) res = Relation::GEQ;
+			else if (accept("<=")) res = Relation::LEQ;
+			else if (accept("!=")) res = Relation::NEQ;
+			else if (accept("=")) res = Relation::EQ;
+			else if (accept(">")) res = Relation::GREATER;
+			else if (accept("<")) res = Relation::LESS;
+			else return false;
+			return true;
+		}
+		std::nullopt_t error() const {
+			std::size_t line = 1 + static_cast<std::size_t>(std::count(mBegin, mCur, '\n'));
+			const char* lineEnd = mCur;
+			while (lineEnd != mEnd && *lineEnd != '\n') ++lineEnd;
+			CARL_LOG_ERROR("carl.io", "Failed to parse OPB file in line " << line << " at \"" << std::string_view(mCur, static_cast<std::size_t>(lineEnd - mCur)) << "\"");
+			return std::nullopt;
+		}
+	public:
+		explicit OPBParser(std::string_view input):
+			mBegin(input.data()), mCur(input.data()), mEnd(input.data() + input.size())
+		{}
 
-		qi::symbols<char, Relation> mRelation;
-		qi::symbols<char, Variable> mVariables;
-		qi::rule<Iterator, std::string(), Skipper> mVarname;
-		qi::rule<Iterator, Variable(), Skipper> mNewVarWrapper;
-		qi::rule<Iterator, std::pair<int,Variable>(), Skipper> mTerm;
-		qi::rule<Iterator, OPBPolynomial(), Skipper> mPolynomial;
-		qi::rule<Iterator, OPBConstraint(), Skipper> mConstraint;
-		qi::rule<Iterator, OPBPolynomial(), Skipper> mObjective;
-		qi::rule<Iterator, OPBFile(), Skipper> mMain;
-		px::function<ErrorHandler> errorHandler;
+		std::optional<OPBFile> parse() {
+			OPBFile res;
+			if (accept("min:")) {
+				if (!polynomial(res.objective) || !accept(";")) return error();
+			}
+			while (peek() != '\0') {
+				OPBConstraint constraint;
+				if (!polynomial(std::get<0>(constraint))) return error();
+				if (!relation(std::get<1>(constraint))) return error();
+				if (!integer(std::get<2>(constraint))) return error();
+				if (!accept(";")) return error();
+				res.constraints.push_back(std::move(constraint));
+			}
+			return res;
+		}
 	};
 
+	std::optional<OPBFile> parseOPBFile(std::string_view input) {
+		return OPBParser(input).parse();
+	}
+
 	std::optional<OPBFile> parseOPBFile(std::ifstream& in) {
-		OPBParser parser;
-		return parser.parse(in);
+		std::string input(std::istreambuf_iterator<char>(in), {});
+		return parseOPBFile(input);
 	}
 
 }
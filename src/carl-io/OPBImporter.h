@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MappedFile.h"
+
 #include <carl-logging/carl-logging.h>
 #include <carl-arith/core/Relation.h>
 #include <carl-formula/formula/Formula.h>
@@ -8,6 +10,8 @@
 #include <fstream>
 #include <map>
 #include <optional>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <vector>
 
@@ -26,17 +30,20 @@ struct OPBFile {
 };
 
 std::optional<OPBFile> parseOPBFile(std::ifstream& in);
+/// Parses an OPB file that is given as a whole, e.g. as a MappedFile.
+std::optional<OPBFile> parseOPBFile(std::string_view input);
 
 template<typename Pol>
 class OPBImporter {
 private:
 	using Number = typename UnderlyingNumberType<Pol>::type;
-	std::ifstream mIn;
+	std::string mFilename;
 
 	std::map<carl::Variable, carl::Variable> variableCache; // maps old int variables to bool
 
 	carl::MultivariatePolynomial<Number> convert(const std::vector<std::pair<int,carl::Variable>>& poly) {
-		Pol lhs;
+		typename Pol::TermsType terms;
+		terms.reserve(poly.size());
 		for (const auto& term: poly) {
 			auto it = variableCache.find(term.second);
 			if (it == variableCache.end()) {
@@ -46,21 +53,26 @@ private:
 			}
 
 			const carl::Variable& booleanVariable = variableCache[term.second];
-			lhs += Pol(Number(term.first)) * Pol(booleanVariable);
+			terms.emplace_back(Number(term.first), booleanVariable, 1);
 		}
 
-		return lhs;
+		return Pol(std::move(terms));
 	}
 
 public:
 	explicit OPBImporter(const std::string& filename):
-		mIn(filename)
+		mFilename(filename)
 	{}
 	
 	std::optional<std::pair<Formula<Pol>,Pol>> parse() {
-		if (!mIn.is_open()) return std::nullopt;
-
-		auto file = parseOPBFile(mIn);
+		std::optional<OPBFile> file;
+		try {
+			MappedFile in(mFilename);
+			file = parseOPBFile(in.view());
+		} catch (const std::system_error& e) {
+			CARL_LOG_ERROR("carl.io", e.what());
+			return std::nullopt;
+		}
 		if (!file) return std::nullopt;
 		Formulas<Pol> constraints;
 		for (const auto& cons: file->constraints) {
@@ -0,0 +1,407 @@
+#pragma once
+
+#include "SMTLIBStream.h"
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/core/Variables.h>
+#include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/Logic.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <unistd.h>
+
+namespace carl::io {
+
+/**
+ * Writes SMTLIB scripts directly to a file descriptor or into a memory region, for example a memory mapped file.
+ *
+ * In contrast to SMTLIBStream, the script is not collected in memory.
+ * The output goes through a fixed size buffer, and numbers and names are formatted directly into this buffer.
+ * Formulas are written as DAGs: a subformula that occurs more than once in an assertion is defined via `define-fun` before the assertion and referenced by its name.
+ * Definitions are kept for the whole script, hence later assertions reuse them as well.
+ * The defined names consist of a prefix (`_f` by default) and a number and must not clash with other names in the script.
+ *
+ * Atoms other than Boolean variables and constraints are written using SMTLIBStream.
+ */
+template<typename Pol>
+class SMTLIBWriter {
+private:
+	/// File descriptor to write to, or -1 if writing into a memory region.
+	int mFD = -1;
+	std::vector<char> mBuffer;
+	char* mBegin;
+	char* mCur;
+	char* mEnd;
+	/// Number of bytes that were already written to the file descriptor.
+	std::size_t mFlushed = 0;
+
+	std::string mPrefix = "_f";
+	/// Names of the shared subformulas that were defined so far. The formulas are kept alive such that their ids are not reused.
+	std::unordered_map<Formula<Pol>, std::size_t> mDefinitions;
+	/// Names of variables by their id and type, ids are only unique per type.
+	std::vector<std::string> mNames;
+
+	void flush_buffer() {
+		if (mFD < 0) {
+			throw std::length_error("SMTLIBWriter: the output region is full");
+		}
+		const char* pos = mBegin;
+		while (pos < mCur) {
+			auto n = ::write(mFD, pos, static_cast<std::size_t>(mCur - pos));
+			if (n < 0) {
+				if (errno == EINTR) continue;
+				throw std::system_error(errno, std::generic_category(), "SMTLIBWriter");
+			}
+			pos += n;
+		}
+		mFlushed += static_cast<std::size_t>(mCur - mBegin);
+		mCur = mBegin;
+	}
+	/// Returns a position where at least n bytes can be written, or nullptr if there is no such position.
+	char* reserve(std::size_t n) {
+		if (static_cast<std::size_t>(mEnd - mCur) < n) {
+			if (mFD < 0 || static_cast<std::size_t>(mEnd - mBegin) < n) return nullptr;
+			flush_buffer();
+		}
+		return mCur;
+	}
+
+	void put(char c) {
+		if (mCur == mEnd) flush_buffer();
+		*mCur++ = c;
+	}
+	void put(std::string_view s) {
+		while (!s.empty()) {
+			if (mCur == mEnd) flush_buffer();
+			std::size_t n = std::min(s.size(), static_cast<std::size_t>(mEnd - mCur));
+			std::memcpy(mCur, s.data(), n);
+			mCur += n;
+			s.remove_prefix(n);
+		}
+	}
+	void put(std::size_t n) {
+		char tmp[24];
+		auto res = std::to_chars(tmp, tmp + sizeof(tmp), n);
+		put(std::string_view(tmp, static_cast<std::size_t>(res.ptr - tmp)));
+	}
+	/// Writes the absolute value of an integer.
+	void put_abs(mpz_srcptr n) {
+		std::size_t size = mpz_sizeinbase(n, 10) + 2;
+		char* pos = reserve(size);
+		if (pos == nullptr) {
+			std::string tmp(size, '\0');
+			mpz_get_str(tmp.data(), 10, n);
+			put(std::string_view(tmp.c_str() + (mpz_sgn(n) < 0 ? 1 : 0)));
+			return;
+		}
+		mpz_get_str(pos, 10, n);
+		std::size_t len = std::strlen(pos);
+		if (mpz_sgn(n) < 0) {
+			std::memmove(pos, pos + 1, len - 1);
+			--len;
+		}
+		mCur += len;
+	}
+
+	void write(const mpz_class& n) {
+		if (sgn(n) < 0) put("(- ");
+		put_abs(n.get_mpz_t());
+		if (sgn(n) < 0) put(')');
+	}
+	void write(const mpq_class& n) {
+		if (sgn(n) < 0) put("(- ");
+		if (mpz_cmp_ui(mpq_denref(n.get_mpq_t()), 1) == 0) {
+			put_abs(mpq_numref(n.get_mpq_t()));
+		} else {
+			put("(/ ");
+			put_abs(mpq_numref(n.get_mpq_t()));
+			put(' ');
+			put_abs(mpq_denref(n.get_mpq_t()));
+			put(')');
+		}
+		if (sgn(n) < 0) put(')');
+	}
+	template<typename Number>
+	void write(const Number& n) {
+		put(carl::toString(n, false));
+	}
+
+	void write(Variable v) {
+		std::size_t index = v.dense_index();
+		if (index >= mNames.size()) mNames.resize(index + 1);
+		auto& name = mNames[index];
+		if (name.empty()) name = v.name();
+		put(name);
+	}
+	void write(const Monomial::Arg& m) {
+		if (m->exponents().size() == 1 && m->exponents().front().second == 1) {
+			write(m->exponents().front().first);
+			return;
+		}
+		put("(*");
+		for (const auto& [var, exp]: *m) {
+			for (std::size_t i = 0; i < exp; ++i) {
+				put(' ');
+				write(var);
+			}
+		}
+		put(')');
+	}
+	void write(const typename Pol::TermType& t) {
+		if (!t.monomial()) {
+			write(t.coeff());
+		} else if (carl::is_one(t.coeff())) {
+			write(t.monomial());
+		} else {
+			put("(* ");
+			write(t.coeff());
+			put(' ');
+			write(t.monomial());
+			put(')');
+		}
+	}
+	void write(const Pol& p) {
+		if (is_zero(p)) {
+			put('0');
+		} else if (p.nr_terms() == 1) {
+			write(p.lterm());
+		} else {
+			put("(+");
+			for (auto it = p.rbegin(); it != p.rend(); ++it) {
+				put(' ');
+				write(*it);
+			}
+			put(')');
+		}
+	}
+	void write(const Constraint<Pol>& c) {
+		switch (c.relation()) {
+			case Relation::EQ: put("(= "); break;
+			case Relation::NEQ: put("(not (= "); break;
+			case Relation::LESS: put("(< "); break;
+			case Relation::LEQ: put("(<= "); break;
+			case Relation::GREATER: put("(> "); break;
+			case Relation::GEQ: put("(>= "); break;
+		}
+		write(c.lhs());
+		put(c.relation() == Relation::NEQ ? " 0))" : " 0)");
+	}
+
+	/// Whether a formula is defined by name if it occurs more than once.
+	static bool shareable(const Formula<Pol>& f) {
+		switch (f.type()) {
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::IFF:
+			case FormulaType::XOR:
+			case FormulaType::IMPLIES:
+			case FormulaType::ITE:
+				return true;
+			case FormulaType::CONSTRAINT:
+				return f.constraint().lhs().nr_terms() > 1;
+			default:
+				return false;
+		}
+	}
+	static bool has_subformulas(const Formula<Pol>& f) {
+		return shareable(f) && f.type() != FormulaType::CONSTRAINT;
+	}
+	/// Counts how often every shareable subformula occurs, without descending into subformulas that were seen before.
+	void count_references(const Formula<Pol>& f, std::unordered_map<std::size_t, std::size_t>& refs) const {
+		if (f.type() == FormulaType::NOT) {
+			count_references(f.subformula(), refs);
+			return;
+		}
+		if (!shareable(f) || mDefinitions.find(f) != mDefinitions.end()) return;
+		if (refs[f.id()]++ > 0) return;
+		if (has_subformulas(f)) {
+			for (const auto& sub: f.subformulas()) count_references(sub, refs);
+		}
+	}
+	/// Defines all subformulas that occur more than once, children before parents.
+	void define_shared(const Formula<Pol>& f, const std::unordered_map<std::size_t, std::size_t>& refs, std::unordered_set<std::size_t>& visited) {
+		if (f.type() == FormulaType::NOT) {
+			define_shared(f.subformula(), refs, visited);
+			return;
+		}
+		if (!shareable(f) || mDefinitions.find(f) != mDefinitions.end()) return;
+		if (!visited.insert(f.id()).second) return;
+		if (has_subformulas(f)) {
+			for (const auto& sub: f.subformulas()) define_shared(sub, refs, visited);
+		}
+		auto it = refs.find(f.id());
+		if (it == refs.end() || it->second < 2) return;
+		std::size_t index = mDefinitions.size();
+		put("(define-fun ");
+		put(mPrefix);
+		put(index);
+		put(" () Bool ");
+		write(f);
+		put(")\n");
+		mDefinitions.emplace(f, index);
+	}
+	void write(const Formula<Pol>& f) {
+		auto it = mDefinitions.find(f);
+		if (it != mDefinitions.end()) {
+			put(mPrefix);
+			put(it->second);
+			return;
+		}
+		switch (f.type()) {
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::IFF:
+			case FormulaType::XOR:
+			case FormulaType::IMPLIES:
+			case FormulaType::ITE:
+				put('(');
+				put(formulaTypeToString(f.type()));
+				for (const auto& sub: f.subformulas()) {
+					put(' ');
+					write(sub);
+				}
+				put(')');
+				break;
+			case FormulaType::NOT:
+				put("(not ");
+				write(f.subformula());
+				put(')');
+				break;
+			case FormulaType::BOOL:
+				write(f.boolean());
+				break;
+			case FormulaType::CONSTRAINT:
+				write(f.constraint());
+				break;
+			case FormulaType::TRUE:
+				put("true");
+				break;
+			case FormulaType::FALSE:
+				put("false");
+				break;
+			default: {
+				SMTLIBStream sls;
+				sls << f;
+				put(sls.str());
+			}
+		}
+	}
+
+public:
+	/**
+	 * Writes to the given file descriptor, which is not closed by the writer.
+	 * @param fd File descriptor to write to.
+	 * @param buffer_size Size of the output buffer.
+	 */
+	explicit SMTLIBWriter(int fd, std::size_t buffer_size = 1 << 16)
+		: mFD(fd), mBuffer(std::max<std::size_t>(buffer_size, 64)), mBegin(mBuffer.data()), mCur(mBegin), mEnd(mBegin + mBuffer.size())
+	{}
+	/**
+	 * Writes into the given memory region, for example a memory mapped file.
+	 * Throws std::length_error if the script does not fit into the region.
+	 */
+	SMTLIBWriter(char* begin, std::size_t size)
+		: mBegin(begin), mCur(begin), mEnd(begin + size)
+	{}
+	/// Flushes the buffer, errors are ignored.
+	~SMTLIBWriter() {
+		if (mFD < 0) return;
+		try {
+			flush_buffer();
+		} catch (const std::exception&) {}
+	}
+	SMTLIBWriter(const SMTLIBWriter&) = delete;
+	SMTLIBWriter& operator=(const SMTLIBWriter&) = delete;
+
+	/// Writes the buffer to the file descriptor.
+	void flush() {
+		if (mFD >= 0) flush_buffer();
+	}
+	/// Number of bytes written so far, including the buffered bytes.
+	std::size_t written() const {
+		return mFlushed + static_cast<std::size_t>(mCur - mBegin);
+	}
+	/// Sets the prefix for the names of shared subformulas.
+	void set_definition_prefix(const std::string& prefix) {
+		mPrefix = prefix;
+	}
+	/// Number of shared subformulas that were defined so far.
+	std::size_t definitions() const {
+		return mDefinitions.size();
+	}
+
+	/// Writes a comment.
+	void comment(std::string_view c) {
+		put("; ");
+		put(c);
+		put('\n');
+	}
+	/// Declare a logic via `set-logic`.
+	void declare(Logic l) {
+		std::stringstream ss;
+		ss << l;
+		put("(set-logic ");
+		put(ss.str());
+		put(")\n");
+	}
+	/// Declare a fresh variable via `declare-fun`.
+	void declare(Variable v) {
+		put("(declare-fun ");
+		write(v);
+		switch (v.type()) {
+			case VariableType::VT_BOOL: put(" () Bool)\n"); break;
+			case VariableType::VT_INT: put(" () Int)\n"); break;
+			default: put(" () Real)\n"); break;
+		}
+	}
+	/// Declare a set of variables.
+	void declare(const carlVariables& vars) {
+		for (const auto& v: vars) {
+			declare(v);
+		}
+	}
+	/// Initializer including the logic and the arithmetic and Boolean variables.
+	void initialize(Logic l, const carlVariables& vars) {
+		declare(l);
+		declare(vars.filter(carl::variable_type_filter::excluding({VariableType::VT_BITVECTOR, VariableType::VT_UNINTERPRETED})));
+	}
+	/// Set information via `set-info`.
+	void setInfo(std::string_view name, std::string_view value) {
+		put("(set-info :");
+		put(name);
+		put(' ');
+		put(value);
+		put(")\n");
+	}
+	/// Assert a formula via `assert`, defining shared subformulas before.
+	void assertFormula(const Formula<Pol>& formula) {
+		std::unordered_map<std::size_t, std::size_t> refs;
+		count_references(formula, refs);
+		std::unordered_set<std::size_t> visited;
+		define_shared(formula, refs, visited);
+		put("(assert ");
+		write(formula);
+		put(")\n");
+	}
+	/// Check satisfiability via `check-sat`.
+	void checkSat() {
+		put("(check-sat)\n");
+	}
+	/// Exit via `exit`.
+	void exit() {
+		put("(exit)\n");
+	}
+};
+
+}
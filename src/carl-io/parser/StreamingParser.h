@@ -0,0 +1,608 @@
+/**
+ * @file StreamingParser.h
+ */
+
+#pragma once
+
+#include "../MappedFile.h"
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/numbers/numbers.h>
+#include <carl-arith/poly/umvpoly/MonomialPool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/Power.h>
+#include <carl-formula/formula/Formula.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace carl::io {
+namespace parser {
+
+/**
+ * A hand-written parser for large inputs, as an alternative to the Spirit based Parser.
+ *
+ * It reads polynomials in infix notation (like PolynomialParser) and SMT-LIB scripts over real, integer and Boolean variables.
+ * The input is a contiguous range of characters, for example a MappedFile, and is read in a single pass without copying it.
+ * Names are interned in hash maps that are searched without creating a std::string.
+ * Sums are collected term by term and the polynomial is created once, such that all terms are merged in a single batch.
+ *
+ * Supported SMT-LIB commands are `declare-fun` and `declare-const` for constants, `define-fun` for constants and `assert`;
+ * all other commands are skipped.
+ * Errors are reported by throwing std::runtime_error with the line and column of the error.
+ */
+template<typename Pol>
+class StreamingParser {
+public:
+	using Coeff = typename Pol::CoeffType;
+	/// An SMT-LIB term is either arithmetic or Boolean.
+	using Value = std::variant<Pol, Formula<Pol>>;
+private:
+	using Terms = typename Pol::TermsType;
+	struct StringHash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view s) const {
+			return std::hash<std::string_view>()(s);
+		}
+	};
+	template<typename T>
+	using NameMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+	NameMap<Variable> mVariables;
+	/// Values of defined constants and let bindings, the innermost binding is the last one.
+	NameMap<std::vector<Value>> mBindings;
+
+	const char* mBegin = nullptr;
+	const char* mCur = nullptr;
+	const char* mEnd = nullptr;
+	/// Buffer for numbers that do not fit into a machine integer.
+	std::string mDigits;
+
+	[[noreturn]] void error(const std::string& msg) const {
+		std::size_t line = 1 + static_cast<std::size_t>(std::count(mBegin, mCur, '\n'));
+		const char* lineStart = mCur;
+		while (lineStart != mBegin && *(lineStart - 1) != '\n') --lineStart;
+		throw std::runtime_error("Parse error at " + std::to_string(line) + ":" + std::to_string(mCur - lineStart + 1) + ": " + msg);
+	}
+	void reset(std::string_view input) {
+		mBegin = input.data();
+		mCur = mBegin;
+		mEnd = mBegin + input.size();
+	}
+
+	static bool is_space(char c) {
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+	}
+	static bool is_digit(char c) {
+		return c >= '0' && c <= '9';
+	}
+	static bool is_alpha(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+	/// Characters of simple symbols in SMT-LIB.
+	static bool is_smtlib_symbol(char c) {
+		if (is_alpha(c) || is_digit(c)) return true;
+		switch (c) {
+			case '~': case '!': case '@': case '$': case '%': case '^': case '&': case '*': case '_':
+			case '-': case '+': case '=': case '<': case '>': case '.': case '?': case '/':
+				return true;
+			default:
+				return false;
+		}
+	}
+	/// Characters of variable names in infix polynomials, excluding the operators.
+	static bool is_infix_symbol(char c) {
+		if (is_alpha(c) || is_digit(c)) return true;
+		switch (c) {
+			case '~': case '!': case '@': case '$': case '%': case '&': case '_': case '.': case '?': case '\'':
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/// Skips whitespace and comments and returns the next character, or zero at the end of the input.
+	char peek() {
+		while (mCur != mEnd) {
+			if (is_space(*mCur)) {
+				++mCur;
+			} else if (*mCur == ';') {
+				while (mCur != mEnd && *mCur != '\n') ++mCur;
+			} else {
+				return *mCur;
+			}
+		}
+		return '\0';
+	}
+	void expect(char c) {
+		if (peek() != c) error(std::string("expected '") + c + "'");
+		++mCur;
+	}
+	bool accept(char c) {
+		if (peek() != c) return false;
+		++mCur;
+		return true;
+	}
+
+	/// Reads a simple or quoted SMT-LIB symbol or keyword.
+	std::string_view smtlib_symbol() {
+		char c = peek();
+		if (c == '|') {
+			const char* start = ++mCur;
+			while (mCur != mEnd && *mCur != '|') ++mCur;
+			if (mCur == mEnd) error("unterminated quoted symbol");
+			return std::string_view(start, static_cast<std::size_t>(mCur++ - start));
+		}
+		const char* start = mCur;
+		if (c == ':') ++mCur;
+		while (mCur != mEnd && is_smtlib_symbol(*mCur)) ++mCur;
+		if (start == mCur) error("expected a symbol");
+		return std::string_view(start, static_cast<std::size_t>(mCur - start));
+	}
+	/// Skips an s-expression, including strings and quoted symbols.
+	void skip_sexpr() {
+		std::size_t depth = 0;
+		do {
+			char c = peek();
+			if (c == '\0') error("unexpected end of input");
+			if (c == '(') {
+				++depth;
+				++mCur;
+			} else if (c == ')') {
+				if (depth == 0) error("unexpected ')'");
+				--depth;
+				++mCur;
+			} else if (c == '"') {
+				for (++mCur; mCur != mEnd; ++mCur) {
+					if (*mCur == '"') {
+						// Two quotes are an escaped quote.
+						if (mCur + 1 != mEnd && *(mCur + 1) == '"') ++mCur;
+						else break;
+					}
+				}
+				if (mCur == mEnd) error("unterminated string");
+				++mCur;
+			} else if (c == '|') {
+				smtlib_symbol();
+			} else {
+				while (mCur != mEnd && !is_space(*mCur) && *mCur != '(' && *mCur != ')' && *mCur != ';') ++mCur;
+			}
+		} while (depth > 0);
+	}
+	/// Skips everything up to and including the closing parenthesis of the current s-expression.
+	void skip_rest() {
+		while (peek() != ')') skip_sexpr();
+		++mCur;
+	}
+
+	/// Reads a decimal number, i.e. digits with an optional fractional part.
+	Coeff number() {
+		const char* start = mCur;
+		std::size_t fraction = 0;
+		bool dot = false;
+		while (mCur != mEnd && (is_digit(*mCur) || (*mCur == '.' && !dot))) {
+			if (*mCur == '.') dot = true;
+			else if (dot) ++fraction;
+			++mCur;
+		}
+		if (mCur == start) error("expected a number");
+		std::size_t digits = static_cast<std::size_t>(mCur - start) - (dot ? 1 : 0);
+		if constexpr (std::is_same<Coeff, mpq_class>::value) {
+			mpz_class num;
+			if (digits <= 19) {
+				std::uint64_t n = 0;
+				for (const char* c = start; c != mCur; ++c) {
+					if (*c != '.') n = n * 10 + static_cast<std::uint64_t>(*c - '0');
+				}
+				num = static_cast<unsigned long>(n);
+			} else {
+				mDigits.clear();
+				for (const char* c = start; c != mCur; ++c) {
+					if (*c != '.') mDigits.push_back(*c);
+				}
+				mpz_set_str(num.get_mpz_t(), mDigits.c_str(), 10);
+			}
+			if (fraction == 0) return mpq_class(num);
+			mpz_class den;
+			mpz_ui_pow_ui(den.get_mpz_t(), 10, fraction);
+			mpq_class res(num, den);
+			res.canonicalize();
+			return res;
+		} else {
+			return carl::parse<Coeff>(std::string(start, static_cast<std::size_t>(mCur - start)));
+		}
+	}
+	exponent natural() {
+		peek();
+		const char* start = mCur;
+		exponent res = 0;
+		while (mCur != mEnd && is_digit(*mCur)) {
+			auto digit = static_cast<exponent>(*mCur - '0');
+			if (res > (std::numeric_limits<exponent>::max() - digit) / 10) error("exponent is too large");
+			res = res * 10 + digit;
+			++mCur;
+		}
+		if (mCur == start) error("expected an exponent");
+		return res;
+	}
+
+	Variable new_variable(std::string_view name, VariableType type) {
+		Variable v = fresh_variable(std::string(name), type);
+		mVariables.insert_or_assign(std::string(name), v);
+		return v;
+	}
+
+	/// Creates a monomial from an unsorted list of variables and exponents.
+	static Monomial::Arg monomial(std::vector<std::pair<Variable, exponent>>& vars) {
+		if (vars.empty()) return nullptr;
+		std::sort(vars.begin(), vars.end(), [](const auto& lhs, const auto& rhs){ return lhs.first < rhs.first; });
+		std::vector<std::pair<Variable, exponent>> content;
+		content.reserve(vars.size());
+		exponent degree = 0;
+		for (const auto& ve: vars) {
+			if (!content.empty() && content.back().first == ve.first) content.back().second += ve.second;
+			else content.push_back(ve);
+			degree += ve.second;
+		}
+		return createMonomial(std::move(content), degree);
+	}
+	/// Appends the terms of p to terms, negated if requested.
+	static void append(Terms& terms, const Pol& p, bool negate) {
+		for (const auto& t: p) {
+			terms.push_back(negate ? -t : t);
+		}
+	}
+
+	// Infix polynomials
+
+	/**
+	 * Reads a product of numbers, variables with exponents and parenthesized sums, and appends its terms.
+	 * The product may start with signs and may be divided by numbers, as in the output of operator<<.
+	 */
+	void infix_product(Terms& terms, bool negate, std::vector<std::pair<Variable, exponent>>& vars) {
+		while (true) {
+			if (accept('-')) negate = !negate;
+			else if (!accept('+')) break;
+		}
+		Coeff coeff = negate ? Coeff(-1) : Coeff(1);
+		std::optional<Pol> factor;
+		vars.clear();
+		do {
+			char c = peek();
+			if (c == '(') {
+				++mCur;
+				Pol p = infix_sum();
+				expect(')');
+				if (accept('^')) p = carl::pow(p, natural());
+				factor = factor ? *factor * p : p;
+			} else if (is_digit(c)) {
+				coeff *= number();
+			} else if (is_infix_symbol(c)) {
+				const char* start = mCur;
+				while (mCur != mEnd && is_infix_symbol(*mCur)) ++mCur;
+				std::string_view name(start, static_cast<std::size_t>(mCur - start));
+				auto it = mVariables.find(name);
+				Variable v = it == mVariables.end() ? new_variable(name, VariableType::VT_REAL) : it->second;
+				vars.emplace_back(v, accept('^') ? natural() : exponent(1));
+			} else {
+				error("expected a number, a variable or '('");
+			}
+			while (accept('/')) {
+				if (!is_digit(peek())) error("expected a number");
+				Coeff den = number();
+				if (carl::is_zero(den)) error("division by zero");
+				coeff /= den;
+			}
+		} while (accept('*'));
+		if (carl::is_zero(coeff)) return;
+		typename Pol::TermType term(coeff, monomial(vars));
+		if (factor) append(terms, *factor * term, false);
+		else terms.push_back(std::move(term));
+	}
+	Pol infix_sum() {
+		Terms terms;
+		std::vector<std::pair<Variable, exponent>> vars;
+		infix_product(terms, false, vars);
+		while (true) {
+			if (accept('+')) infix_product(terms, false, vars);
+			else if (accept('-')) infix_product(terms, true, vars);
+			else break;
+		}
+		return Pol(std::move(terms));
+	}
+
+	// SMT-LIB terms
+
+	Pol arithmetic(Value&& v) {
+		if (!std::holds_alternative<Pol>(v)) error("expected an arithmetic term");
+		return std::get<Pol>(std::move(v));
+	}
+	Formula<Pol> boolean(Value&& v) {
+		if (!std::holds_alternative<Formula<Pol>>(v)) error("expected a Boolean term");
+		return std::get<Formula<Pol>>(std::move(v));
+	}
+	/// Reads the arguments of an application up to the closing parenthesis.
+	std::vector<Value> arguments() {
+		std::vector<Value> res;
+		while (peek() != ')') res.push_back(term());
+		++mCur;
+		return res;
+	}
+	Formulas<Pol> boolean_arguments() {
+		Formulas<Pol> res;
+		while (peek() != ')') res.push_back(boolean(term()));
+		++mCur;
+		return res;
+	}
+	/// Creates the relation between consecutive arguments, or between all pairs of arguments for distinct (NEQ).
+	Formula<Pol> relation(Relation rel, std::vector<Value>&& args) {
+		if (args.size() < 2) error("a relation needs at least two arguments");
+		if (std::holds_alternative<Formula<Pol>>(args.front())) {
+			Formulas<Pol> subs;
+			for (auto& a: args) subs.push_back(boolean(std::move(a)));
+			if (rel == Relation::NEQ) {
+				// At most two Boolean values are pairwise distinct.
+				if (subs.size() > 2) return Formula<Pol>(FormulaType::FALSE);
+				return Formula<Pol>(FormulaType::XOR, std::move(subs));
+			}
+			if (rel != Relation::EQ) error("expected arithmetic arguments");
+			return Formula<Pol>(FormulaType::IFF, std::move(subs));
+		}
+		auto compare = [this, rel](const Value& lhs, const Value& rhs) {
+			Terms terms;
+			append(terms, arithmetic(Value(lhs)), false);
+			append(terms, arithmetic(Value(rhs)), true);
+			return Formula<Pol>(Pol(std::move(terms)), rel);
+		};
+		Formulas<Pol> res;
+		for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+			if (rel == Relation::NEQ) {
+				for (std::size_t j = i + 1; j < args.size(); ++j) res.push_back(compare(args[i], args[j]));
+			} else {
+				res.push_back(compare(args[i], args[i + 1]));
+			}
+		}
+		if (res.size() == 1) return res.front();
+		return Formula<Pol>(FormulaType::AND, std::move(res));
+	}
+	/// Reads let bindings, which are all evaluated before any of them is visible.
+	/// Removes the bindings of a let when its body was parsed or parsing it failed.
+	struct LetScope {
+		NameMap<std::vector<Value>>& bindings;
+		std::vector<std::string_view> names;
+		~LetScope() {
+			for (const auto& name: names) bindings.find(name)->second.pop_back();
+		}
+	};
+	std::vector<std::string_view> let_bindings() {
+		std::vector<std::pair<std::string_view, Value>> bindings;
+		expect('(');
+		while (accept('(')) {
+			std::string_view name = smtlib_symbol();
+			bindings.emplace_back(name, term());
+			expect(')');
+		}
+		expect(')');
+		std::vector<std::string_view> names;
+		for (auto& b: bindings) {
+			auto it = mBindings.find(b.first);
+			if (it == mBindings.end()) it = mBindings.emplace(std::string(b.first), std::vector<Value>()).first;
+			it->second.push_back(std::move(b.second));
+			names.push_back(b.first);
+		}
+		return names;
+	}
+	Value application() {
+		std::string_view op = smtlib_symbol();
+		if (op == "let") {
+			LetScope scope{ mBindings, let_bindings() };
+			Value res = term();
+			expect(')');
+			return res;
+		} else if (op == "!") {
+			Value res = term();
+			skip_rest();
+			return res;
+		} else if (op == "+") {
+			Terms terms;
+			while (peek() != ')') append(terms, arithmetic(term()), false);
+			++mCur;
+			return Pol(std::move(terms));
+		} else if (op == "-") {
+			Terms terms;
+			append(terms, arithmetic(term()), false);
+			if (accept(')')) {
+				for (auto& t: terms) t.negate();
+				return Pol(std::move(terms));
+			}
+			while (peek() != ')') append(terms, arithmetic(term()), true);
+			++mCur;
+			return Pol(std::move(terms));
+		} else if (op == "*") {
+			Pol res = arithmetic(term());
+			while (peek() != ')') res *= arithmetic(term());
+			++mCur;
+			return res;
+		} else if (op == "/") {
+			Pol res = arithmetic(term());
+			while (peek() != ')') {
+				Pol den = arithmetic(term());
+				if (!den.is_constant() || carl::is_zero(den)) error("only division by non-zero constants is supported");
+				res *= Coeff(1) / den.constant_part();
+			}
+			++mCur;
+			return res;
+		} else if (op == "to_real") {
+			Value res = term();
+			expect(')');
+			return res;
+		} else if (op == "=") {
+			return relation(Relation::EQ, arguments());
+		} else if (op == "distinct") {
+			return relation(Relation::NEQ, arguments());
+		} else if (op == "<") {
+			return relation(Relation::LESS, arguments());
+		} else if (op == "<=") {
+			return relation(Relation::LEQ, arguments());
+		} else if (op == ">") {
+			return relation(Relation::GREATER, arguments());
+		} else if (op == ">=") {
+			return relation(Relation::GEQ, arguments());
+		} else if (op == "not") {
+			Formula<Pol> res = boolean(term());
+			expect(')');
+			return res.negated();
+		} else if (op == "and") {
+			return Formula<Pol>(FormulaType::AND, boolean_arguments());
+		} else if (op == "or") {
+			return Formula<Pol>(FormulaType::OR, boolean_arguments());
+		} else if (op == "xor") {
+			return Formula<Pol>(FormulaType::XOR, boolean_arguments());
+		} else if (op == "=>") {
+			Formulas<Pol> args = boolean_arguments();
+			if (args.size() < 2) error("=> needs at least two arguments");
+			Formula<Pol> res = args.back();
+			for (std::size_t i = args.size() - 1; i > 0; --i) {
+				res = Formula<Pol>(FormulaType::IMPLIES, args[i - 1], res);
+			}
+			return res;
+		} else if (op == "ite") {
+			Formula<Pol> cond = boolean(term());
+			Value first = term();
+			Value second = term();
+			expect(')');
+			if (std::holds_alternative<Pol>(first)) error("only Boolean ite is supported");
+			return Formula<Pol>(FormulaType::ITE, cond, boolean(std::move(first)), boolean(std::move(second)));
+		}
+		error("unsupported function " + std::string(op));
+	}
+	Value term() {
+		char c = peek();
+		if (c == '(') {
+			++mCur;
+			if (peek() == '(') error("unsupported term");
+			return application();
+		}
+		if (is_digit(c)) return Pol(number());
+		std::string_view name = smtlib_symbol();
+		auto bit = mBindings.find(name);
+		if (bit != mBindings.end() && !bit->second.empty()) return bit->second.back();
+		auto vit = mVariables.find(name);
+		if (vit != mVariables.end()) {
+			if (vit->second.type() == VariableType::VT_BOOL) return Formula<Pol>(vit->second);
+			return Pol(vit->second);
+		}
+		if (name == "true") return Formula<Pol>(FormulaType::TRUE);
+		if (name == "false") return Formula<Pol>(FormulaType::FALSE);
+		error("undeclared symbol " + std::string(name));
+	}
+	VariableType sort() {
+		std::string_view s = smtlib_symbol();
+		if (s == "Real") return VariableType::VT_REAL;
+		if (s == "Int") return VariableType::VT_INT;
+		if (s == "Bool") return VariableType::VT_BOOL;
+		error("unsupported sort " + std::string(s));
+	}
+	void declare(std::string_view name, VariableType type) {
+		auto it = mVariables.find(name);
+		if (it == mVariables.end() || it->second.type() != type) new_variable(name, type);
+	}
+
+public:
+	/// Makes a variable known under its name, such that it is used instead of creating a new one.
+	void addVariable(Variable::Arg v) {
+		mVariables.insert_or_assign(v.name(), v);
+	}
+
+	/**
+	 * Parses a polynomial in infix notation, for example `3/2*x^2*y - (x+1)^2`.
+	 * Unknown variables are created as real variables.
+	 */
+	Pol polynomial(std::string_view input) {
+		reset(input);
+		Pol res = infix_sum();
+		if (peek() != '\0') error("unexpected input after the polynomial");
+		return res;
+	}
+
+	/// Parses a single SMT-LIB term of sort Bool over declared or added variables.
+	Formula<Pol> formula(std::string_view input) {
+		reset(input);
+		Formula<Pol> res = boolean(term());
+		if (peek() != '\0') error("unexpected input after the formula");
+		return res;
+	}
+
+	/**
+	 * Parses an SMT-LIB script and calls the callback for every assertion, in order.
+	 * @return The number of assertions.
+	 */
+	template<typename Callback>
+	std::size_t script(std::string_view input, Callback&& callback) {
+		reset(input);
+		std::size_t count = 0;
+		while (peek() != '\0') {
+			expect('(');
+			std::string_view command = smtlib_symbol();
+			if (command == "assert") {
+				Formula<Pol> f = boolean(term());
+				expect(')');
+				callback(std::move(f));
+				++count;
+			} else if (command == "declare-fun") {
+				std::string_view name = smtlib_symbol();
+				expect('(');
+				if (peek() != ')') error("only constants can be declared");
+				++mCur;
+				declare(name, sort());
+				expect(')');
+			} else if (command == "declare-const") {
+				std::string_view name = smtlib_symbol();
+				declare(name, sort());
+				expect(')');
+			} else if (command == "define-fun") {
+				std::string_view name = smtlib_symbol();
+				expect('(');
+				if (peek() != ')') error("only constants can be defined");
+				++mCur;
+				VariableType type = sort();
+				Value value = term();
+				if ((type == VariableType::VT_BOOL) != std::holds_alternative<Formula<Pol>>(value)) error("the definition does not match its sort");
+				expect(')');
+				auto& values = mBindings[std::string(name)];
+				values.clear();
+				values.push_back(std::move(value));
+			} else {
+				skip_rest();
+			}
+		}
+		return count;
+	}
+
+	/// Parses an SMT-LIB script and returns all assertions.
+	std::vector<Formula<Pol>> script(std::string_view input) {
+		std::vector<Formula<Pol>> res;
+		script(input, [&res](Formula<Pol>&& f){ res.push_back(std::move(f)); });
+		return res;
+	}
+
+	/// Parses an SMT-LIB script from a file that is mapped into memory and returns all assertions.
+	std::vector<Formula<Pol>> script_file(const std::string& filename) {
+		MappedFile file(filename);
+		return script(file.view());
+	}
+};
+
+}
+}
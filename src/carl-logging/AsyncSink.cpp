@@ -0,0 +1,149 @@
+#include "AsyncSink.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+namespace carl::logging {
+
+namespace {
+	std::size_t next_sink_id() {
+		static std::atomic<std::size_t> id = 1;
+		return id++;
+	}
+	std::size_t round_to_power_of_two(std::size_t n) {
+		std::size_t res = 1;
+		while (res < n) res <<= 1;
+		return res;
+	}
+}
+
+AsyncSink::Ring::Ring(std::size_t capacity):
+	mEntries(round_to_power_of_two(std::max<std::size_t>(capacity, 2))),
+	mMask(mEntries.size() - 1)
+{}
+
+bool AsyncSink::Ring::push(Entry&& e) {
+	std::size_t tail = mTail.load(std::memory_order_relaxed);
+	if (tail - mHead.load(std::memory_order_acquire) >= mEntries.size()) return false;
+	mEntries[tail & mMask] = std::move(e);
+	mTail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+bool AsyncSink::Ring::pop(Entry& e) {
+	std::size_t head = mHead.load(std::memory_order_relaxed);
+	if (head == mTail.load(std::memory_order_acquire)) return false;
+	e = std::move(mEntries[head & mMask]);
+	mHead.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+AsyncSink::AsyncSink(std::shared_ptr<Sink> target, std::size_t capacity, OverflowPolicy policy, std::chrono::microseconds idle):
+	mTarget(std::move(target)),
+	mCapacity(capacity),
+	mPolicy(policy),
+	mID(next_sink_id()),
+	mIdleInterval(idle),
+	mWriter(&AsyncSink::run, this)
+{}
+
+AsyncSink::~AsyncSink() {
+	{
+		// Taking the mutex ensures that threads waiting in push() or flush() either see the stop or are woken up.
+		std::lock_guard<std::mutex> lock(mProgressMutex);
+		mStop.store(true, std::memory_order_release);
+	}
+	mProgress.notify_all();
+	mWriter.join();
+	drain();
+	mTarget->log().flush();
+	std::lock_guard<std::mutex> lock(mRingMutex);
+	for (const auto& r: mRings) r->close();
+}
+
+AsyncSink::Ring& AsyncSink::ring() {
+	// Rings of the calling thread, identified by the id of their sink.
+	// The rings are shared with the sinks such that pending messages survive the thread.
+	thread_local std::vector<std::pair<std::size_t, std::shared_ptr<Ring>>> rings;
+	for (const auto& r: rings) {
+		if (r.first == mID) return *r.second;
+	}
+	// Release the rings of sinks that were destroyed.
+	rings.erase(std::remove_if(rings.begin(), rings.end(),
+		[](const auto& r){ return r.second->closed(); }
+	), rings.end());
+	auto r = std::make_shared<Ring>(mCapacity);
+	{
+		std::lock_guard<std::mutex> lock(mRingMutex);
+		mRings.push_back(r);
+	}
+	rings.emplace_back(mID, r);
+	return *r;
+}
+
+bool AsyncSink::push(Entry&& e) {
+	Ring& r = ring();
+	while (!r.push(std::move(e))) {
+		if (mPolicy == OverflowPolicy::Drop || mStop.load(std::memory_order_acquire)) {
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		std::unique_lock<std::mutex> lock(mProgressMutex);
+		mProgress.wait(lock, [this, &r](){ return !r.full() || mStop.load(std::memory_order_acquire); });
+	}
+	return true;
+}
+
+std::size_t AsyncSink::drain() {
+	std::vector<std::shared_ptr<Ring>> rings;
+	{
+		std::lock_guard<std::mutex> lock(mRingMutex);
+		// Only the sink refers to rings of finished threads, remove them once they are empty.
+		mRings.erase(std::remove_if(mRings.begin(), mRings.end(),
+			[](const auto& r){ return r.use_count() == 1 && r->empty(); }
+		), mRings.end());
+		rings = mRings;
+	}
+	std::stringstream batch;
+	std::size_t count = 0;
+	Entry e;
+	for (const auto& r: rings) {
+		while (r->pop(e)) {
+			e.formatter->prefix(batch, e.channel, e.level, e.info);
+			batch << e.message;
+			e.formatter->suffix(batch);
+			++count;
+		}
+	}
+	if (count > 0) {
+		mTarget->log() << batch.rdbuf();
+		mTarget->log().flush();
+	}
+	{
+		// Taking the mutex ensures that waiting threads either see the progress or are woken up.
+		std::lock_guard<std::mutex> lock(mProgressMutex);
+		mCycles.fetch_add(1, std::memory_order_release);
+	}
+	mProgress.notify_all();
+	return count;
+}
+
+void AsyncSink::run() {
+	while (!mStop.load(std::memory_order_acquire)) {
+		if (drain() == 0) {
+			std::this_thread::sleep_for(mIdleInterval);
+		}
+	}
+}
+
+void AsyncSink::flush() {
+	Ring& r = ring();
+	std::unique_lock<std::mutex> lock(mProgressMutex);
+	mProgress.wait(lock, [this, &r](){ return r.empty() || mStop.load(std::memory_order_acquire); });
+	// The messages may have been taken by a drain that is still running.
+	std::size_t cycles = mCycles.load(std::memory_order_acquire);
+	mProgress.wait(lock, [this, cycles](){ return mCycles.load(std::memory_order_acquire) != cycles || mStop.load(std::memory_order_acquire); });
+}
+
+}
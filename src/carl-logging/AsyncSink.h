@@ -0,0 +1,148 @@
+#pragma once
+
+#include "logging.h"
+#include "Formatter.h"
+#include "Sink.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace carl::logging {
+
+/**
+ * Specifies what happens if a thread logs to an AsyncSink whose buffer is full.
+ */
+enum class OverflowPolicy {
+	/// Discard the message and count it as dropped.
+	Drop,
+	/// Wait until the background writer has made room.
+	Block
+};
+
+/**
+ * Logging sink that decouples the logging threads from the actual output.
+ *
+ * Every thread that logs to this sink gets its own lock-free single-producer single-consumer ring buffer.
+ * A ring is released once its thread has finished or the sink is destroyed.
+ * A background thread drains all buffers, formats the messages and writes them to the wrapped Sink in batches.
+ * Thus, the logging threads neither wait for each other nor for the output, except if a buffer is full and OverflowPolicy::Block is used.
+ * Messages of a single thread keep their order, messages of different threads may be interleaved arbitrarily.
+ *
+ * The Logger recognizes this sink and pushes messages to it after releasing its mutex:
+ * @code{.cpp}
+ * carl::logging::logger().configure("logfile", std::make_shared<carl::logging::AsyncSink>(std::make_shared<carl::logging::FileSink>("carl.log")));
+ * @endcode
+ */
+class AsyncSink final: public Sink {
+public:
+	/// A log message that waits to be written.
+	struct Entry {
+		LogLevel level = LogLevel::LVL_ALL;
+		std::string channel;
+		std::string message;
+		RecordInfo info;
+		/// Formatter for this message, which must not be modified while the message is pending.
+		std::shared_ptr<const Formatter> formatter;
+	};
+private:
+	/// Lock-free ring buffer with a single producer and a single consumer.
+	class Ring {
+		std::vector<Entry> mEntries;
+		std::size_t mMask;
+		/// Index of the next entry to be read, only modified by the consumer.
+		std::atomic<std::size_t> mHead = 0;
+		/// Index of the next entry to be written, only modified by the producer.
+		std::atomic<std::size_t> mTail = 0;
+		/// Set once the sink is destroyed, such that the producer thread can release the ring.
+		std::atomic<bool> mClosed = false;
+	public:
+		/// Creates a ring whose capacity is the given capacity rounded up to the next power of two.
+		explicit Ring(std::size_t capacity);
+		bool push(Entry&& e);
+		bool pop(Entry& e);
+		bool empty() const {
+			return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+		}
+		bool full() const {
+			return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire) >= mEntries.size();
+		}
+		void close() {
+			mClosed.store(true, std::memory_order_release);
+		}
+		bool closed() const {
+			return mClosed.load(std::memory_order_acquire);
+		}
+	};
+
+	/// Sink the messages are finally written to.
+	std::shared_ptr<Sink> mTarget;
+	std::size_t mCapacity;
+	OverflowPolicy mPolicy;
+	/// Unique identifier to find the rings of this sink in thread local storage.
+	std::size_t mID;
+	/// Rings of all threads. Rings of finished threads are removed once they are drained.
+	std::vector<std::shared_ptr<Ring>> mRings;
+	/// Protects mRings. Only taken when a thread logs to this sink for the first time and by the writer.
+	std::mutex mRingMutex;
+	/// Number of finished drains.
+	std::atomic<std::size_t> mCycles = 0;
+	/// Signals finished drains to threads that wait in push() or flush().
+	std::condition_variable mProgress;
+	std::mutex mProgressMutex;
+	std::atomic<std::size_t> mDropped = 0;
+	std::atomic<bool> mStop = false;
+	std::chrono::microseconds mIdleInterval;
+	std::thread mWriter;
+
+	/// Returns the ring of the calling thread.
+	Ring& ring();
+	/// Moves all pending messages to the target and returns the number of messages written.
+	std::size_t drain();
+	void run();
+public:
+	/**
+	 * Creates an asynchronous sink that writes to the given sink.
+	 * @param target Sink the messages are written to.
+	 * @param capacity Number of messages that can be buffered per thread.
+	 * @param policy What to do if the buffer of a thread is full.
+	 * @param idle Time the writer sleeps if there are no messages.
+	 */
+	explicit AsyncSink(std::shared_ptr<Sink> target, std::size_t capacity = 4096, OverflowPolicy policy = OverflowPolicy::Drop, std::chrono::microseconds idle = std::chrono::microseconds(500));
+	/**
+	 * Stops the background writer after writing all pending messages.
+	 */
+	~AsyncSink() override;
+	AsyncSink(const AsyncSink&) = delete;
+	AsyncSink& operator=(const AsyncSink&) = delete;
+
+	/**
+	 * Returns the stream of the wrapped sink.
+	 * Note that writing to this stream directly races with the background writer.
+	 */
+	std::ostream& log() noexcept override {
+		return mTarget->log();
+	}
+	/**
+	 * Enqueues a message, which is formatted and written by the background writer.
+	 * If the buffer is full and the writer has stopped, the message is dropped regardless of the OverflowPolicy.
+	 * @param e Message.
+	 * @return If the message was enqueued, i.e. was not dropped.
+	 */
+	bool push(Entry&& e);
+	/**
+	 * Waits until all messages that the calling thread has enqueued so far are written, or the writer has stopped.
+	 */
+	void flush();
+	/// Number of messages that were discarded because a buffer was full.
+	std::size_t dropped() const noexcept {
+		return mDropped.load(std::memory_order_relaxed);
+	}
+};
+
+}
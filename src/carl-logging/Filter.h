@@ -3,9 +3,11 @@
 #include "LogLevel.h"
 
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 
 namespace carl::logging {
 
@@ -17,6 +19,8 @@ class Filter {
 	std::map<std::string, LogLevel> mData = {
 		std::make_pair(std::string(""), LogLevel::LVL_DEFAULT)
 	};
+	/// Applies changes of the rules, see onChange().
+	std::function<void(const std::function<void()>&)> mOnChange;
 public:
 	/**
 	 * Returns the internal filter data.
@@ -32,16 +36,25 @@ public:
 	 * @return This object.
 	 */
 	Filter& operator()(const std::string& channel, LogLevel level) {
-		mData[channel] = level;
+		auto change = [this, &channel, level](){ mData[channel] = level; };
+		if (mOnChange) mOnChange(change);
+		else change();
 		return *this;
 	}
 	/**
-	 * Checks if the given log level is sufficient for the log message to be forwarded.
+	 * Installs a callback that applies every change of a rule, given as a function, instead of the filter.
+	 * The Logger uses this to change rules under its mutex and to keep its cached channel levels up to date.
+	 * @param f Callback.
+	 */
+	void onChange(std::function<void(const std::function<void()>&)> f) {
+		mOnChange = std::move(f);
+	}
+	/**
+	 * Returns the minimum log level for some channel, taking the rules for the parent channels into account.
 	 * @param channel Channel name.
-	 * @param level LogLevel.
-	 * @return If the message shall be forwarded.
+	 * @return Minimum LogLevel.
 	 */
-	bool check(const std::string& channel, LogLevel level) const noexcept {
+	LogLevel level(const std::string& channel) const noexcept {
 		auto tmp = channel;
 		auto it = mData.find(tmp);
 		while (!tmp.empty() && it == mData.end()) {
@@ -51,10 +64,19 @@ public:
 		}
 		if (it == mData.end()) {
 			std::cout << "Did not find something for \"" << channel << "\"" << std::endl;
-			return true;
+			return LogLevel::LVL_ALL;
 		}
 		assert(it != mData.end());
-		return level >= it->second;
+		return it->second;
+	}
+	/**
+	 * Checks if the given log level is sufficient for the log message to be forwarded.
+	 * @param channel Channel name.
+	 * @param level LogLevel.
+	 * @return If the message shall be forwarded.
+	 */
+	bool check(const std::string& channel, LogLevel level) const noexcept {
+		return level >= this->level(channel);
 	}
 	/**
 	 * Streaming operator for a Filter.
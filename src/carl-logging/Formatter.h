@@ -2,9 +2,12 @@
 
 #include "Filter.h"
 #include "LogLevel.h"
+#include "logging.h"
+#include "logging_utils.h"
 
 #include <iomanip>
 #include <iosfwd>
+#include <memory>
 #ifdef THREAD_SAFE
 #include <thread>
 #endif
@@ -23,6 +26,15 @@ public:
 
 	virtual ~Formatter() noexcept = default;
 
+	/**
+	 * Returns a copy of this Formatter.
+	 * The Logger formats messages with copies, such that the Formatter can be reconfigured while other threads are logging.
+	 * Subclasses with additional state should override this method.
+	 */
+	virtual std::shared_ptr<const Formatter> clone() const {
+		return std::make_shared<const Formatter>(*this);
+	}
+
 	/**
 	 * Extracts the maximum width of a channel to optimize the formatting.
 	 * @param f Filter.
@@ -39,7 +51,7 @@ public:
 	 * @param level LogLevel.
 	 * @param info Auxiliary information.
 	 */
-	virtual void prefix(std::ostream& os, const std::string& channel, LogLevel level, const RecordInfo& info) {
+	virtual void prefix(std::ostream& os, const std::string& channel, LogLevel level, const RecordInfo& info) const {
 		if (!printInformation) return;
 		os.fill(' ');
 #ifdef THREAD_SAFE
@@ -64,7 +76,7 @@ public:
 	 * Usually, this is only a newline.
 	 * @param os Output stream.
 	 */
-	virtual void suffix(std::ostream& os) {
+	virtual void suffix(std::ostream& os) const {
 		os << std::endl;
 	}
 };
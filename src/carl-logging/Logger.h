@@ -5,10 +5,13 @@
 #include "logging_utils.h"
 #include "config.h"
 
+#include "AsyncSink.h"
 #include "Filter.h"
 #include "Formatter.h"
+#include "logging.h"
 #include "Sink.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <fstream>
@@ -16,8 +19,10 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 
 namespace carl {
@@ -65,6 +70,13 @@ namespace carl {
  * <li>`CARLLOG_ASSERT(channel, condition, msg)` checks the condition and if it fails calls `CARLLOG_FATAL(channel, msg)` and asserts the condition.</li>
  * </ul>
  * Any message (`msg` or `args`) can be an arbitrary expression that one would stream to an `std::ostream` like `stream << (msg);`. No final newline is needed.
+ *
+ * The macros register their channel during static initialization and obtain an integer id.
+ * The Logger caches the minimum LogLevel that is visible on any Sink for every registered channel in `channel_levels`.
+ * Hence checking whether a message is visible amounts to a single atomic load and does not involve any string operations.
+ *
+ * Logging does not take the mutex of the Logger: every change of the configuration publishes an immutable copy of all Sinks, Filters and Formatters, which is used by `log()` and `visible()`.
+ * Messages for an AsyncSink are formatted and written by a background thread, all other messages are written under a mutex of their Sink.
  */
 namespace logging {
 
@@ -73,18 +85,79 @@ namespace logging {
  */
 class Logger: public carl::Singleton<Logger> {
 	friend carl::Singleton<Logger>;
-	/// Mapping from channels to associated logging classes.
-	std::map<std::string, std::tuple<std::shared_ptr<Sink>, Filter, std::shared_ptr<Formatter>>> mData;
-	/// Logging mutex to ensure thread-safe logging.
+	/// A Sink with copies of its Filter and Formatter, as used for logging.
+	struct Target {
+		std::shared_ptr<Sink> sink;
+		/// The sink as AsyncSink, if it is one.
+		AsyncSink* async;
+		Filter filter;
+		std::shared_ptr<const Formatter> formatter;
+		/// Serializes messages that are written to a synchronous sink.
+		std::shared_ptr<std::mutex> mutex;
+	};
+	using Config = std::vector<Target>;
+
+	/// Mapping from channels to associated logging classes and the mutex used to write to the sink.
+	std::map<std::string, std::tuple<std::shared_ptr<Sink>, Filter, std::shared_ptr<Formatter>, std::shared_ptr<std::mutex>>> mData;
+	/// The configuration used for logging, replaced whenever mData changes.
+	std::shared_ptr<const Config> mConfig = std::make_shared<const Config>();
+	/// Protects mConfig, which is only held to copy or replace the pointer.
+	mutable std::shared_mutex mConfigMutex;
+	/// Registered channels, indexed by their id. Id zero is reserved for channels that could not be registered.
+	std::vector<std::string> mChannels = { "" };
+	/// Mapping from channels to their ids.
+	std::map<std::string, std::size_t> mChannelIds;
+	/// Protects the configuration, i.e. mData and the registered channels.
 	std::mutex mMutex;
 
+	/**
+	 * Computes the minimum LogLevel that is visible on any Sink for some channel.
+	 * @param channel Channel name.
+	 */
+	LogLevel minimumLevel(const std::string& channel) const noexcept {
+		LogLevel res = LogLevel::LVL_OFF;
+		for (const auto& t: mData) {
+			res = std::min(res, std::get<1>(t.second).level(channel));
+		}
+		return res;
+	}
+	/**
+	 * Recomputes the cached levels of all registered channels.
+	 * Assumes that mMutex is held.
+	 */
+	void updateLevels() noexcept {
+		for (std::size_t id = 1; id < mChannels.size(); ++id) {
+			channel_levels[id].store(minimumLevel(mChannels[id]), std::memory_order_relaxed);
+		}
+	}
+	/**
+	 * Publishes a copy of the current configuration for logging.
+	 * Assumes that mMutex is held.
+	 */
+	void publish() {
+		auto config = std::make_shared<Config>();
+		config->reserve(mData.size());
+		for (const auto& t: mData) {
+			const auto& sink = std::get<0>(t.second);
+			config->push_back(Target{ sink, dynamic_cast<AsyncSink*>(sink.get()), std::get<1>(t.second), std::get<2>(t.second)->clone(), std::get<3>(t.second) });
+		}
+		std::unique_lock<std::shared_mutex> lock(mConfigMutex);
+		mConfig = std::move(config);
+	}
+	/// Returns the configuration for logging.
+	std::shared_ptr<const Config> config() const {
+		std::shared_lock<std::shared_mutex> lock(mConfigMutex);
+		return mConfig;
+	}
+
 public:
 	/**
 	 * Check if a Sink with the given id has been installed.
 	 * @param id Sink identifier.
 	 * @return If a Sink with this id is present.
 	 */
-	bool has(const std::string& id) const noexcept {
+	bool has(const std::string& id) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
 		return mData.find(id) != mData.end();
 	}
 	/**
@@ -95,7 +168,16 @@ public:
 	 */
 	void configure(const std::string& id, std::shared_ptr<Sink> sink) {
 		std::lock_guard<std::mutex> lock(mMutex);
-		mData[id] = std::make_tuple(std::move(sink), Filter(), std::make_shared<Formatter>());
+		auto& data = mData[id];
+		data = std::make_tuple(std::move(sink), Filter(), std::make_shared<Formatter>(), std::make_shared<std::mutex>());
+		std::get<1>(data).onChange([this](const std::function<void()>& change){
+			std::lock_guard<std::mutex> lock(mMutex);
+			change();
+			updateLevels();
+			publish();
+		});
+		updateLevels();
+		publish();
 	}
 	/**
 	 * Installs a FileSink.
@@ -119,16 +201,19 @@ public:
 	 * @return Filter.
 	 */
 	Filter& filter(const std::string& id) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
 		auto it = mData.find(id);
 		assert(it != mData.end());
 		return std::get<1>(it->second);
 	}
 	/**
 	 * Retrieves the Formatter for some Sink.
+	 * Changes of the Formatter take effect once resetFormatter() is called.
 	 * @param id Sink identifier.
 	 * @return Formatter.
 	 */
 	const std::shared_ptr<Formatter>& formatter(const std::string& id) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
 		auto it = mData.find(id);
 		assert(it != mData.end());
 		return std::get<2>(it->second);
@@ -139,19 +224,42 @@ public:
 	 * @param fmt New Formatter.
 	 */
 	void formatter(const std::string& id, std::shared_ptr<Formatter> fmt) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
 		auto it = mData.find(id);
 		assert(it != mData.end());
 		std::get<2>(it->second) = std::move(fmt);
 		std::get<2>(it->second)->configure(std::get<1>(it->second));
+		publish();
 	}
 	/**
 	 * Reconfigures all Formatter objects.
 	 * This should be done once after all configuration is finished.
 	 */
 	void resetFormatter() noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
 		for (auto& t: mData) {
 			std::get<2>(t.second)->configure(std::get<1>(t.second));
 		}
+		updateLevels();
+		publish();
+	}
+	/**
+	 * Registers a channel and returns its id.
+	 * Registering the same channel multiple times yields the same id.
+	 * If too many channels are registered, the reserved id zero is returned, for which every message is considered visible by `channel_levels`.
+	 * @param channel Channel name.
+	 * @return Channel id.
+	 */
+	std::size_t registerChannel(const std::string& channel) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mChannelIds.find(channel);
+		if (it != mChannelIds.end()) return it->second;
+		if (mChannels.size() >= max_channels) return 0;
+		std::size_t id = mChannels.size();
+		mChannels.emplace_back(channel);
+		mChannelIds.emplace(channel, id);
+		channel_levels[id].store(minimumLevel(channel), std::memory_order_relaxed);
+		return id;
 	}
 	/**
 	 * Checks whether a log message would be visible for some sink.
@@ -160,8 +268,9 @@ public:
 	 * @param channel Channel name.
 	 */
 	bool visible(LogLevel level, const std::string& channel) const noexcept {
-		for (const auto& t: mData) {
-			if (std::get<1>(t.second).check(channel, level)) {
+		auto config = this->config();
+		for (const auto& t: *config) {
+			if (t.filter.check(channel, level)) {
 				return true;
 			}
 		}
@@ -175,12 +284,17 @@ public:
 	 * @param info Auxiliary information.
 	 */
 	void log(LogLevel level, const std::string& channel, const std::stringstream& ss, const RecordInfo& info) {
-		std::lock_guard<std::mutex> lock(mMutex);
-		for (auto& t: mData) {
-			if (!std::get<1>(t.second).check(channel, level)) continue;
-			std::get<2>(t.second)->prefix(std::get<0>(t.second)->log(), channel, level, info);
-			std::get<0>(t.second)->log() << ss.str();
-			std::get<2>(t.second)->suffix(std::get<0>(t.second)->log());
+		auto config = this->config();
+		for (const auto& t: *config) {
+			if (!t.filter.check(channel, level)) continue;
+			if (t.async != nullptr) {
+				t.async->push(AsyncSink::Entry{ level, channel, ss.str(), info, t.formatter });
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(*t.mutex);
+			t.formatter->prefix(t.sink->log(), channel, level, info);
+			t.sink->log() << ss.str();
+			t.formatter->suffix(t.sink->log());
 		}
 	}
 };
@@ -10,6 +10,7 @@ namespace carl::logging {
  */
 class Sink {
 public:
+	virtual ~Sink() = default;
 	/**
 	 * Abstract logging interface.
 	 * The intended usage is to write any log output to the output stream returned by this function.
@@ -4,6 +4,8 @@
 
 namespace carl::logging {
 
+std::array<std::atomic<LogLevel>, max_channels> channel_levels;
+
 bool visible(LogLevel level, const std::string& channel) noexcept {
 	return Logger::getInstance().visible(level, channel);
 }
@@ -12,4 +14,8 @@ void log(LogLevel level, const std::string& channel, const std::stringstream& ss
 	Logger::getInstance().log(level, channel, ss, info);
 }
 
+std::size_t register_channel(const std::string& channel) {
+	return Logger::getInstance().registerChannel(channel);
+}
+
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "LogLevel.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <sstream>
 #include <string>
 
@@ -19,8 +22,48 @@ struct RecordInfo {
 	std::size_t line;
 };
 
+/// Maximum number of channels that can be registered.
+constexpr std::size_t max_channels = 1024;
+
+/**
+ * Minimum LogLevel that is visible on any sink, indexed by channel id.
+ * It is maintained by the Logger whenever sinks or filters change.
+ * The reserved id zero is used for channels that could not be registered and always stays at LVL_ALL.
+ */
+extern std::array<std::atomic<LogLevel>, max_channels> channel_levels;
+
 bool visible(LogLevel level, const std::string& channel) noexcept;
 void log(LogLevel level, const std::string& channel, const std::stringstream& ss, const RecordInfo& info);
+std::size_t register_channel(const std::string& channel);
+
+/**
+ * Checks whether a log message for some registered channel would be visible for some sink.
+ * @param level LogLevel.
+ * @param channel Channel id.
+ */
+inline bool visible(LogLevel level, std::size_t channel) noexcept {
+	return level >= channel_levels[channel].load(std::memory_order_relaxed);
+}
+
+/**
+ * A string literal that can be used as a template argument.
+ */
+template<std::size_t N>
+struct ChannelName {
+	char name[N];
+	constexpr ChannelName(const char (&n)[N]) {
+		std::copy_n(n, N, name);
+	}
+};
+
+/**
+ * Registers a channel during static initialization.
+ * The logging macros use the id to check the visibility of messages.
+ */
+template<ChannelName Name>
+struct Channel {
+	static inline const std::size_t id = register_channel(Name.name);
+};
 
 }
 
@@ -32,15 +75,17 @@ void log(LogLevel level, const std::string& channel, const std::stringstream& ss
 #define __CARL_LOG_RECORD ::carl::logging::RecordInfo{__FILE__, __func__, __LINE__}
 /// Create a record info without function name.
 #define __CARL_LOG_RECORD_NOFUNC ::carl::logging::RecordInfo{__FILE__, "", __LINE__}
+/// Id of a channel, which has to be a string literal.
+#define __CARL_LOG_CHANNEL(channel) ::carl::logging::Channel<channel>::id
 /// Basic logging macro.
 #define __CARL_LOG(level, channel, expr) { \
-	if (::carl::logging::visible(level, channel)) { \
+	if (::carl::logging::visible(level, __CARL_LOG_CHANNEL(channel))) { \
 		std::stringstream __ss; __ss << expr; ::carl::logging::log(level, channel, __ss, __CARL_LOG_RECORD); \
 	}}
 
 /// Basic logging macro without function name.
 #define __CARL_LOG_NOFUNC(level, channel, expr) { \
-	if (::carl::logging::visible(level, channel)) { \
+	if (::carl::logging::visible(level, __CARL_LOG_CHANNEL(channel))) { \
 		std::stringstream __ss; __ss << expr; ::carl::logging::log(level, channel, __ss, __CARL_LOG_RECORD_NOFUNC); \
 	}}
 
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Timing.h"
+#include "Value.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace carl::statistics {
+
+/**
+ * A log-linear histogram in the spirit of HDR histograms, meant to record latencies in nanoseconds.
+ *
+ * Values below 2^precision_bits are counted exactly.
+ * Every larger power of two range is split into 2^precision_bits buckets of equal width, hence the relative error of a reported percentile is at most 2^-precision_bits.
+ * Buckets are allocated lazily up to the largest value that was recorded.
+ */
+class Histogram {
+public:
+    static constexpr std::size_t precision_bits = 5;
+private:
+    static constexpr std::uint64_t sub_buckets = std::uint64_t(1) << precision_bits;
+
+    std::vector<std::uint64_t> m_buckets;
+    std::size_t m_count = 0;
+    std::uint64_t m_sum = 0;
+    std::uint64_t m_min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t m_max = 0;
+
+    static std::size_t bucket(std::uint64_t value) {
+        if (value < sub_buckets) return static_cast<std::size_t>(value);
+        std::size_t shift = static_cast<std::size_t>(std::bit_width(value)) - 1 - precision_bits;
+        return static_cast<std::size_t>(sub_buckets * (shift + 1) + ((value >> shift) - sub_buckets));
+    }
+    /// Largest value that falls into the given bucket.
+    static std::uint64_t upper_bound(std::size_t bucket) {
+        if (bucket < sub_buckets) return bucket;
+        std::size_t shift = bucket / sub_buckets - 1;
+        std::uint64_t mantissa = sub_buckets + bucket % sub_buckets;
+        return ((mantissa + 1) << shift) - 1;
+    }
+public:
+    void add(std::uint64_t value) {
+        std::size_t b = bucket(value);
+        if (b >= m_buckets.size()) m_buckets.resize(b + 1);
+        ++m_buckets[b];
+        ++m_count;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    /// Records the time since the given start in nanoseconds.
+    void finish(timing::time_point start) {
+        add(static_cast<std::uint64_t>(timing::since_ns(start).count()));
+    }
+    /// Adds all values recorded by another histogram.
+    void merge(const Histogram& h) {
+        if (h.m_buckets.size() > m_buckets.size()) m_buckets.resize(h.m_buckets.size());
+        for (std::size_t i = 0; i < h.m_buckets.size(); ++i) {
+            m_buckets[i] += h.m_buckets[i];
+        }
+        m_count += h.m_count;
+        m_sum += h.m_sum;
+        m_min = std::min(m_min, h.m_min);
+        m_max = std::max(m_max, h.m_max);
+    }
+
+    auto count() const {
+        return m_count;
+    }
+    auto sum() const {
+        return m_sum;
+    }
+    std::uint64_t min() const {
+        return m_count == 0 ? 0 : m_min;
+    }
+    std::uint64_t max() const {
+        return m_max;
+    }
+    double avg() const {
+        return m_count == 0 ? 0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+    /**
+     * Returns a value such that (approximately) the given fraction of all recorded values is at most this value.
+     * Uses the nearest-rank method, i.e. returns the (approximation of the) ceil(p * count)-th smallest value.
+     * @param p Fraction between zero and one, e.g. 0.99 for the 99th percentile.
+     */
+    std::uint64_t percentile(double p) const {
+        if (m_count == 0) return 0;
+        auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(m_count)));
+        rank = std::clamp<std::size_t>(rank, 1, m_count);
+        std::size_t seen = 0;
+        for (std::size_t i = 0; i < m_buckets.size(); ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) return std::clamp(upper_bound(i), min(), max());
+        }
+        return m_max;
+    }
+
+    void collect(std::map<std::string, Value>& data, const std::string& key) const {
+        data.insert_or_assign(key+".count", count());
+        data.insert_or_assign(key+".sum", sum());
+        data.insert_or_assign(key+".min", min());
+        data.insert_or_assign(key+".max", max());
+        data.insert_or_assign(key+".avg", avg());
+        data.insert_or_assign(key+".p50", percentile(0.5));
+        data.insert_or_assign(key+".p90", percentile(0.9));
+        data.insert_or_assign(key+".p99", percentile(0.99));
+        data.insert_or_assign(key+".p999", percentile(0.999));
+    }
+};
+
+}
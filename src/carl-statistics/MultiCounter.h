@@ -1,7 +1,14 @@
 #pragma once
 
+#include "Serialization.h"
+#include "Value.h"
+
 #include <boost/container/flat_map.hpp>
 
+#include <map>
+#include <sstream>
+#include <string>
+
 namespace carl::statistics {
 
 template<typename T>
@@ -15,14 +22,14 @@ public:
         m_total += inc;
     }
 
-    void collect(std::map<std::string, std::string>& data, const std::string& key) const {
+    void collect(std::map<std::string, Value>& data, const std::string& key) const {
         std::stringstream ss;
 		for (const auto& [k,v] : m_data) {
             serialize(ss, k);
 			ss << "=" << v << ";";
 		}
-        data.emplace(key, ss.str());
-        data.emplace(key + ".total", std::to_string(m_total));
+        data.insert_or_assign(key, ss.str());
+        data.insert_or_assign(key + ".total", m_total);
     }
 };
 
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <carl-common/memory/Singleton.h>
+
+#include "Histogram.h"
+#include "Sharded.h"
+#include "Statistics.h"
+#include "Timing.h"
+#include "Value.h"
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace carl::statistics {
+
+/**
+ * A named region of code whose executions are measured by the Profiler.
+ */
+struct ProfilerZone {
+    explicit ProfilerZone(std::string n): name(std::move(n)) {}
+    std::string name;
+    /// Durations of all executions in nanoseconds.
+    Sharded<Histogram> times;
+};
+
+/**
+ * Collects the time spent in profiler zones.
+ *
+ * The durations of every zone are recorded in a per-thread latency histogram and reported through the statistics module as the statistics object `profiler`.
+ * Additionally, if tracing is enabled, every single execution of a zone is stored and can be written as a Chrome trace (that can be opened in chrome://tracing or Perfetto).
+ *
+ * Zones are usually created using the `CARL_PROFILE_ZONE` macro from carl-profiling.h, which is disabled unless CARL_DEVOPTION_Profiling is set.
+ * The Profiler is header-only, hence it can be used from all carl libraries without linking carl-statistics.
+ */
+class Profiler : public carl::Singleton<Profiler> {
+    friend carl::Singleton<Profiler>;
+
+    /// A single execution of a zone.
+    struct Event {
+        const ProfilerZone* zone;
+        std::uint64_t start_ns;
+        std::uint64_t duration_ns;
+        std::size_t thread;
+    };
+    struct Trace {
+        std::vector<Event> events;
+        void merge(const Trace& t) {
+            events.insert(events.end(), t.events.begin(), t.events.end());
+        }
+    };
+    /// Reports all zones to the statistics module.
+    class ProfilerStatistics : public Statistics {
+    public:
+        bool collect_concurrently() const override {
+            return true;
+        }
+        void collect() override {
+            for (const auto& zone: Profiler::getInstance().zones()) {
+                addKeyValuePair(zone->name, zone->times);
+            }
+        }
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ProfilerZone>> m_zones;
+    std::atomic<bool> m_tracing = false;
+    Sharded<Trace> m_trace;
+    timing::time_point m_start = timing::now();
+
+    Profiler() {
+        carl::statistics::get<ProfilerStatistics>("profiler");
+    }
+
+    /// Small consecutive number of the calling thread, used as thread id in traces.
+    static std::size_t thread_index() {
+        static std::atomic<std::size_t> next = 0;
+        thread_local std::size_t id = next++;
+        return id;
+    }
+public:
+    /**
+     * Returns the zone with the given name, creating it if necessary.
+     * The reference stays valid for the lifetime of the Profiler.
+     */
+    ProfilerZone& zone(const std::string& name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& z: m_zones) {
+            if (z->name == name) return *z;
+        }
+        return *m_zones.emplace_back(std::make_unique<ProfilerZone>(name));
+    }
+    /**
+     * Returns a copy of the list of all zones.
+     */
+    std::vector<const ProfilerZone*> zones() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<const ProfilerZone*> res;
+        for (const auto& z: m_zones) res.push_back(z.get());
+        return res;
+    }
+
+    /**
+     * Records an execution of a zone.
+     */
+    void record(ProfilerZone& zone, timing::time_point start, timing::time_point end) {
+        auto duration = static_cast<std::uint64_t>(std::chrono::duration_cast<timing::duration_ns>(end - start).count());
+        zone.times.add(duration);
+        if (m_tracing.load(std::memory_order_relaxed)) {
+            auto offset = static_cast<std::uint64_t>(std::chrono::duration_cast<timing::duration_ns>(start - m_start).count());
+            m_trace.update([&](Trace& t) {
+                t.events.push_back(Event{ &zone, offset, duration, thread_index() });
+            });
+        }
+    }
+
+    /**
+     * Enables or disables the recording of individual executions for traces.
+     * Note that the trace grows with every execution of a zone while tracing is enabled.
+     */
+    void set_tracing(bool tracing) {
+        m_tracing.store(tracing, std::memory_order_relaxed);
+    }
+    bool tracing() const {
+        return m_tracing.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Writes all recorded executions in the Chrome trace event format.
+     */
+    void write_trace(std::ostream& os) const {
+        auto trace = m_trace.merged();
+        os << "{\"traceEvents\": [";
+        bool first = true;
+        for (const auto& e: trace.events) {
+            if (!first) os << ",";
+            first = false;
+            os << "\n{\"name\": ";
+            write_json(os, e.zone->name);
+            os << ", \"cat\": \"carl\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.thread;
+            os << ", \"ts\": ";
+            write_json(os, static_cast<double>(e.start_ns) / 1000);
+            os << ", \"dur\": ";
+            write_json(os, static_cast<double>(e.duration_ns) / 1000);
+            os << "}";
+        }
+        os << "\n], \"displayTimeUnit\": \"ns\"}" << std::endl;
+    }
+    /**
+     * Writes all recorded executions to a file in the Chrome trace event format.
+     */
+    void write_trace(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::out);
+        write_trace(file);
+    }
+};
+
+namespace detail {
+    /**
+     * Creates the Profiler, and thereby registers its statistics, during static initialization.
+     * Otherwise, the first profiled call would register them, which may happen within StatisticsCollector while it holds its mutex.
+     */
+    inline Profiler& profiler = Profiler::getInstance();
+}
+
+/**
+ * Measures the lifetime of a scope as an execution of a ProfilerZone.
+ */
+class ProfilerScope {
+    ProfilerZone& m_zone;
+    timing::time_point m_start = timing::now();
+public:
+    explicit ProfilerScope(ProfilerZone& zone): m_zone(zone) {}
+    ~ProfilerScope() {
+        Profiler::getInstance().record(m_zone, m_start, timing::now());
+    }
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+};
+
+}
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "Value.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
 namespace carl::statistics {
 
 class Series {
@@ -16,12 +22,12 @@ public:
         m_count++;
     }
 
-    void collect(std::map<std::string, std::string>& data, const std::string& key) const {
-        data.emplace(key+".count", std::to_string(m_count));
-        data.emplace(key+".sum",   std::to_string(m_sum));
-        data.emplace(key+".min",   std::to_string(m_min));
-        data.emplace(key+".max",   std::to_string(m_max));
-        data.emplace(key+".avg",   std::to_string((float)m_sum/(float)m_count));
+    void collect(std::map<std::string, Value>& data, const std::string& key) const {
+        data.insert_or_assign(key+".count", m_count);
+        data.insert_or_assign(key+".sum",   m_sum);
+        data.insert_or_assign(key+".min",   m_min);
+        data.insert_or_assign(key+".max",   m_max);
+        data.insert_or_assign(key+".avg",   (double)m_sum/(double)m_count);
     }
 };
 
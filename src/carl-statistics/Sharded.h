@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Value.h"
+
+#include <carl-common/memory/IDPool.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace carl::statistics {
+
+namespace detail {
+    /**
+     * Identifiers of the living Sharded objects.
+     * The ids are reused such that the thread local storage stays as small as the number of objects.
+     * The generation is never reused and tells apart objects that had the same id.
+     */
+    struct ShardIDs {
+        std::mutex mutex;
+        IDPool pool;
+        std::atomic<std::size_t> generation = 1;
+
+        std::pair<std::size_t, std::size_t> get() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return std::make_pair(pool.get(), generation++);
+        }
+        void free(std::size_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            pool.free(id);
+        }
+    };
+    inline ShardIDs& shard_ids() {
+        static ShardIDs ids;
+        return ids;
+    }
+}
+
+/**
+ * Makes a statistics value like a Timer or a Histogram usable from multiple threads.
+ *
+ * Every thread records into its own shard, so threads do not contend with each other.
+ * The shards are merged (using `T::merge`) whenever the value is collected.
+ * Each shard is protected by a mutex that is only ever contended by a concurrent collect().
+ */
+template<typename T>
+class Sharded {
+    struct Shard {
+        std::mutex mutex;
+        T data;
+    };
+    /// A shard in thread local storage, which is only valid if its generation is the one of this object.
+    struct Local {
+        std::size_t generation = 0;
+        Shard* shard = nullptr;
+    };
+    /// Identifier (used as index of the shard in thread local storage) and generation of this object.
+    std::pair<std::size_t, std::size_t> m_id = detail::shard_ids().get();
+    mutable std::mutex m_mutex;
+    /// The shards are owned by the object, the thread local storage only refers to them.
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    Shard& local() {
+        thread_local std::vector<Local> shards;
+        if (m_id.first >= shards.size()) shards.resize(m_id.first + 1);
+        auto& l = shards[m_id.first];
+        if (l.generation != m_id.second) {
+            auto s = std::make_unique<Shard>();
+            l = Local{ m_id.second, s.get() };
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shards.push_back(std::move(s));
+        }
+        return *l.shard;
+    }
+public:
+    Sharded() = default;
+    ~Sharded() {
+        detail::shard_ids().free(m_id.first);
+    }
+    Sharded(const Sharded&) = delete;
+    Sharded& operator=(const Sharded&) = delete;
+
+    /// Calls f on the shard of the calling thread.
+    template<typename F>
+    void update(F&& f) {
+        Shard& s = local();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        f(s.data);
+    }
+    template<typename... Args>
+    void add(Args&&... args) {
+        update([&](T& t){ t.add(std::forward<Args>(args)...); });
+    }
+    template<typename... Args>
+    void finish(Args&&... args) {
+        update([&](T& t){ t.finish(std::forward<Args>(args)...); });
+    }
+
+    /// Returns the combination of all shards.
+    T merged() const {
+        T res;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& s: m_shards) {
+            std::lock_guard<std::mutex> shard_lock(s->mutex);
+            res.merge(s->data);
+        }
+        return res;
+    }
+
+    void collect(std::map<std::string, Value>& data, const std::string& key) const {
+        merged().collect(data, key);
+    }
+};
+
+}
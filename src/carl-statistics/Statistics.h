@@ -4,20 +4,29 @@
 #include <sstream>
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
 
 #include "StatisticsCollector.h"
 #include "Serialization.h"
 #include "Timing.h"
+#include "Value.h"
 #include "Series.h"
+#include "Histogram.h"
+#include "Sharded.h"
 #include "MultiCounter.h"
 
 namespace carl {
 namespace statistics {
 
 class Statistics {
+	friend class StatisticsCollector;
 private:
 	std::string mName;
-	std::map<std::string, std::string> mCollected;
+	std::map<std::string, Value> mCollected;
+	/// Where collect() stores the values, which is mCollected unless a snapshot is taken.
+	std::map<std::string, Value>* mTarget = &mCollected;
+	/// Whether the current collection is the final one or only an intermediate snapshot.
+	bool mFinal = true;
 	bool has_illegal_chars(const std::string& val) const {
 		return std::find_if(val.begin(), val.end(), [](char c) {
 				return c == ':' || c == '(' || c == ')' || std::isspace(static_cast<unsigned char>(c));
@@ -29,27 +38,40 @@ protected:
 		if (has_illegal_chars(key)) return;
 		assert(!has_illegal_chars(static_cast<std::string>(value)) && "spaces, (, ), : are not allowed here");
 		if (has_illegal_chars(value)) return;
-		mCollected.emplace(key, value);
+		(*mTarget).insert_or_assign(key, value);
 	}
 
 	void addKeyValuePair(const std::string& key, Timer& value) {
-		value.collect(mCollected, key);
+		value.collect((*mTarget), key, mFinal);
 	}
 
 	void addKeyValuePair(const std::string& key, const Series& value) {
-		value.collect(mCollected, key);
+		value.collect((*mTarget), key);
+	}
+
+	void addKeyValuePair(const std::string& key, const Histogram& value) {
+		value.collect((*mTarget), key);
+	}
+
+	template<typename T>
+	void addKeyValuePair(const std::string& key, const Sharded<T>& value) {
+		value.collect((*mTarget), key);
 	}
 
 	template<typename T>
 	void addKeyValuePair(const std::string& key, const MultiCounter<T>& value) {
-		value.collect(mCollected, key);
+		value.collect((*mTarget), key);
 	}
 
 	template<typename T>
 	void addKeyValuePair(const std::string& key, const T& value) {
-		std::stringstream ss;
-		serialize(ss, value);
-		mCollected.emplace(key, ss.str());
+		if constexpr (std::is_arithmetic_v<T>) {
+			(*mTarget).insert_or_assign(key, value);
+		} else {
+			std::stringstream ss;
+			serialize(ss, value);
+			(*mTarget).insert_or_assign(key, ss.str());
+		}
 	}
 
 public:
@@ -67,12 +89,32 @@ public:
 	virtual bool enabled() const {
 		return true;
 	}
+	/**
+	 * Whether collect() may be called while other threads record values, i.e. all values are kept in Sharded or atomic objects.
+	 * Only such statistics are included in the snapshots that StatisticsSnapshotter takes from its background thread.
+	 */
+	virtual bool collect_concurrently() const {
+		return false;
+	}
+	/**
+	 * Adds the current values to the collected data using addKeyValuePair().
+	 * This may be called multiple times, for example to take intermediate snapshots; later values overwrite earlier ones.
+	 */
 	virtual void collect() {}
 
 	const auto& name() const {
 		return mName;
 	}
-	const auto& collected() const {
+	/// The collected values, formatted as strings.
+	std::map<std::string, std::string> collected() const {
+		std::map<std::string, std::string> res;
+		for (const auto& [key, value]: mCollected) {
+			res.emplace_hint(res.end(), key, value.to_string());
+		}
+		return res;
+	}
+	/// The collected values with their types.
+	const auto& collected_values() const {
 		return mCollected;
 	}
 };
@@ -5,13 +5,36 @@
 namespace carl {
 namespace statistics {
 
-void StatisticsCollector::collect() {
+void StatisticsCollector::collect(bool final) {
+	std::lock_guard<std::mutex> lock(mMutex);
 	for (auto& s: mStatistics) {
 		if (s->enabled()) {
+			s->mFinal = final;
 			s->collect();
+			s->mFinal = true;
 		}
 	}
 }
 
+std::map<std::string, std::map<std::string, Value>> StatisticsCollector::snapshot(bool concurrent_only) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::map<std::string, std::map<std::string, Value>> res;
+	for (auto& s: mStatistics) {
+		if (!s->enabled() || (concurrent_only && !s->collect_concurrently())) continue;
+		std::map<std::string, Value> data;
+		s->mTarget = &data;
+		s->mFinal = false;
+		s->collect();
+		s->mFinal = true;
+		s->mTarget = &s->mCollected;
+		if (data.empty()) continue;
+		auto& values = res[s->name()];
+		for (auto& kv: data) {
+			values.insert_or_assign(kv.first, std::move(kv.second));
+		}
+	}
+	return res;
+}
+
 }
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include <carl-common/memory/Singleton.h>
 
+#include "Value.h"
+
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,15 +18,33 @@ class Statistics;
 class StatisticsCollector: public carl::Singleton<StatisticsCollector> {
 private:
 	std::vector<std::unique_ptr<Statistics>> mStatistics;
+	std::mutex mMutex;
 public:
+	/**
+	 * Creates a new statistics object of the given type.
+	 * This method may be called from multiple threads.
+	 */
 	template<typename T>
 	T& get(const std::string& name) {
+		std::lock_guard<std::mutex> lock(mMutex);
 		auto& ptr = mStatistics.emplace_back(std::make_unique<T>());
 		ptr->set_name(name);
 		return static_cast<T&>(*ptr);
 	}
 
-	void collect();
+	/**
+	 * Collects all enabled statistics objects.
+	 * Values that are recorded in per-thread shards (see Sharded) are merged at this point.
+	 * @param final Whether this is the final collection. Otherwise, running timers are not stopped.
+	 */
+	void collect(bool final = true);
+
+	/**
+	 * Collects all enabled statistics objects as an intermediate snapshot and returns the data, indexed by the names of the statistics objects.
+	 * The snapshot does not change the collected values of the statistics objects.
+	 * @param concurrent_only Whether to collect only statistics that support collect_concurrently(), which is required if other threads may record values.
+	 */
+	std::map<std::string, std::map<std::string, Value>> snapshot(bool concurrent_only = false);
 
 	const auto& statistics() const {
 		return mStatistics;
@@ -6,13 +6,16 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 namespace carl {
 namespace statistics {
 
 enum class StatisticsOutputFormat {
 	SMTLIB,
-	XML
+	XML,
+	JSON,
+	CSV
 };
 
 template<StatisticsOutputFormat SOF>
@@ -24,13 +27,14 @@ std::ostream& operator<<(std::ostream& os, StatisticsPrinter<SOF>);
 template<>
 std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFormat::SMTLIB>) {
 	for (const auto& s: StatisticsCollector::getInstance().statistics()) {
-		if (s->collected().empty()) continue;
+		auto collected = s->collected();
+		if (collected.empty()) continue;
 		os << "(:" << s->name() << " (" << std::endl;
 		std::size_t max_width = 0;
-		for (const auto& kv: s->collected()) {
+		for (const auto& kv: collected) {
 			max_width = std::max(max_width, kv.first.size());
 		}
-		for (const auto& kv: s->collected()) {
+		for (const auto& kv: collected) {
 			os << "\t:" << std::setw(static_cast<int>(max_width)) << std::left << kv.first << " " << kv.second << std::endl;
 		}
 		os << "))" << std::endl;
@@ -41,12 +45,13 @@ std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFor
 template<>
 std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFormat::XML>) {
 	for (const auto& s: StatisticsCollector::getInstance().statistics()) {
-		if (s->collected().empty()) continue;
+		auto collected = s->collected();
+		if (collected.empty()) continue;
 		std::string name = s->name();
 		std::replace(name.begin(), name.end(), '<', '(');
 		std::replace(name.begin(), name.end(), '>', ')');
 		os << "\t<module name=\"" << name << "\">\n"; 
-		for (const auto& kv: s->collected()) {
+		for (const auto& kv: collected) {
 			os << "\t\t<stat name=\"" << kv.first << "\" value=\"" << kv.second << "\" />\n";
 		}
 		os << "\t</module>\n"; 
@@ -54,12 +59,82 @@ std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFor
 	return os;
 }
 
+/**
+ * Prints all statistics as a single JSON object that maps the name of every statistics object to an object of its values.
+ * Numbers and Booleans are written as such, everything else as strings.
+ */
+template<>
+inline std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFormat::JSON>) {
+	os << "{";
+	bool first = true;
+	for (const auto& s: StatisticsCollector::getInstance().statistics()) {
+		if (s->collected_values().empty()) continue;
+		if (!first) os << ",";
+		first = false;
+		os << "\n\t";
+		write_json(os, s->name());
+		os << ": {";
+		bool first_value = true;
+		for (const auto& kv: s->collected_values()) {
+			if (!first_value) os << ",";
+			first_value = false;
+			os << "\n\t\t";
+			write_json(os, kv.first);
+			os << ": ";
+			write_json(os, kv.second);
+		}
+		os << "\n\t}";
+	}
+	os << "\n}" << std::endl;
+	return os;
+}
+
+/**
+ * Prints all statistics as CSV with the columns statistics, key and value.
+ */
+template<>
+inline std::ostream& operator<<(std::ostream& os, StatisticsPrinter<StatisticsOutputFormat::CSV>) {
+	auto field = [&os](const auto& v) {
+		std::stringstream ss;
+		ss << v;
+		std::string str = ss.str();
+		if (str.find_first_of(",\"\n") == std::string::npos) {
+			os << str;
+			return;
+		}
+		os << '"';
+		for (char c: str) {
+			if (c == '"') os << '"';
+			os << c;
+		}
+		os << '"';
+	};
+	os << "statistics,key,value\n";
+	for (const auto& s: StatisticsCollector::getInstance().statistics()) {
+		for (const auto& kv: s->collected_values()) {
+			field(s->name());
+			os << ",";
+			field(kv.first);
+			os << ",";
+			field(kv.second);
+			os << "\n";
+		}
+	}
+	return os;
+}
+
 auto statistics_as_smtlib() {
 	return StatisticsPrinter<StatisticsOutputFormat::SMTLIB>();
 }
 auto statistics_as_xml() {
 	return StatisticsPrinter<StatisticsOutputFormat::XML>();
 }
+inline auto statistics_as_json() {
+	return StatisticsPrinter<StatisticsOutputFormat::JSON>();
+}
+inline auto statistics_as_csv() {
+	return StatisticsPrinter<StatisticsOutputFormat::CSV>();
+}
 
 void statistics_to_xml_file(const std::string& filename) {
 	std::ofstream file;
@@ -70,6 +145,16 @@ void statistics_to_xml_file(const std::string& filename) {
 	file.close();
 }
 
+inline void statistics_to_json_file(const std::string& filename) {
+	std::ofstream file(filename, std::ios::out);
+	file << statistics_as_json();
+}
+
+inline void statistics_to_csv_file(const std::string& filename) {
+	std::ofstream file(filename, std::ios::out);
+	file << statistics_as_csv();
+}
+
 
 }
 }
\ No newline at end of file
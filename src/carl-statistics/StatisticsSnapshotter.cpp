@@ -0,0 +1,79 @@
+#include "StatisticsSnapshotter.h"
+
+#include "Statistics.h"
+#include "StatisticsCollector.h"
+
+namespace carl {
+namespace statistics {
+
+StatisticsSnapshotter::StatisticsSnapshotter(std::ostream& os, std::chrono::milliseconds interval):
+	mOut(os),
+	mInterval(interval),
+	mThread(&StatisticsSnapshotter::run, this)
+{}
+
+StatisticsSnapshotter::StatisticsSnapshotter(const std::string& filename, std::chrono::milliseconds interval):
+	mFile(filename, std::ios::out),
+	mOut(mFile),
+	mInterval(interval),
+	mThread(&StatisticsSnapshotter::run, this)
+{}
+
+StatisticsSnapshotter::~StatisticsSnapshotter() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mCondition.notify_all();
+	mThread.join();
+	snapshot();
+}
+
+void StatisticsSnapshotter::run() {
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (!mCondition.wait_for(lock, mInterval, [this](){ return mStop; })) {
+		lock.unlock();
+		write(true);
+		lock.lock();
+	}
+}
+
+void StatisticsSnapshotter::snapshot() {
+	write(false);
+}
+
+void StatisticsSnapshotter::write(bool concurrent_only) {
+	Data current = StatisticsCollector::getInstance().snapshot(concurrent_only);
+	auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStart);
+	std::lock_guard<std::mutex> lock(mMutex);
+	mOut << "{\"time_ms\": " << time.count() << ", \"delta\": {";
+	bool first = true;
+	for (const auto& [name, values]: current) {
+		const auto& previous = mPrevious[name];
+		bool first_value = true;
+		for (const auto& [key, value]: values) {
+			auto it = previous.find(key);
+			if (it != previous.end() && it->second == value) continue;
+			if (first_value) {
+				if (!first) mOut << ", ";
+				first = false;
+				write_json(mOut, name);
+				mOut << ": {";
+			} else {
+				mOut << ", ";
+			}
+			first_value = false;
+			write_json(mOut, key);
+			mOut << ": ";
+			write_json(mOut, it == previous.end() ? value : value.delta(it->second));
+		}
+		if (!first_value) mOut << "}";
+	}
+	mOut << "}}" << std::endl;
+	for (auto& [name, values]: current) {
+		mPrevious[name] = std::move(values);
+	}
+}
+
+}
+}
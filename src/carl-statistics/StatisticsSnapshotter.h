@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Value.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace carl {
+namespace statistics {
+
+/**
+ * Periodically writes the changes of statistics to an output stream from a background thread.
+ *
+ * The background thread only collects statistics that support Statistics::collect_concurrently(), as other statistics may be modified by the threads that record them.
+ * All statistics are included in snapshots that are taken explicitly via snapshot() and in the last snapshot upon destruction.
+ *
+ * Every snapshot is a single line containing a JSON object of the form
+ * `{"time_ms": <milliseconds since start>, "delta": {<statistics>: {<key>: <value>, ...}, ...}}`.
+ * For numbers, the difference to the previous snapshot is reported, other values are reported if they changed.
+ * Values that did not change are omitted.
+ * The first snapshot reports all values.
+ */
+class StatisticsSnapshotter {
+	using Data = std::map<std::string, std::map<std::string, Value>>;
+
+	std::ofstream mFile;
+	std::ostream& mOut;
+	std::chrono::milliseconds mInterval;
+	std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+	Data mPrevious;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	bool mStop = false;
+	std::thread mThread;
+
+	void run();
+	/// Takes a snapshot and writes the changes.
+	void write(bool concurrent_only);
+public:
+	/**
+	 * Starts writing snapshots to the given stream.
+	 * @param os Output stream.
+	 * @param interval Time between two snapshots.
+	 */
+	StatisticsSnapshotter(std::ostream& os, std::chrono::milliseconds interval);
+	/**
+	 * Starts writing snapshots to the given file.
+	 * @param filename Output file, truncated upon construction.
+	 * @param interval Time between two snapshots.
+	 */
+	StatisticsSnapshotter(const std::string& filename, std::chrono::milliseconds interval);
+	/**
+	 * Stops the background thread and writes a last snapshot of all statistics.
+	 */
+	~StatisticsSnapshotter();
+	StatisticsSnapshotter(const StatisticsSnapshotter&) = delete;
+	StatisticsSnapshotter& operator=(const StatisticsSnapshotter&) = delete;
+
+	/**
+	 * Writes a snapshot of all statistics immediately.
+	 * This must be called from a thread that may read all statistics, i.e. while no other thread records values into statistics that can not be collected concurrently.
+	 */
+	void snapshot();
+};
+
+}
+}
@@ -1,15 +1,21 @@
 #pragma once
 
+#include "Value.h"
+
 #include <chrono>
+#include <map>
+#include <string>
 
 namespace carl {
 namespace statistics {
 
 namespace timing {
-    /// The clock type used here.
-    using clock = std::chrono::high_resolution_clock;
+    /// The clock type used here. It is monotonic and, on common platforms, backed by the TSC.
+    using clock = std::chrono::steady_clock;
     /// The duration type used here.
     using duration = std::chrono::duration<std::size_t,std::milli>;
+    /// The duration type used for precise measurements.
+    using duration_ns = std::chrono::duration<std::size_t,std::nano>;
     /// The type of a time point.
     using time_point = clock::time_point;
 
@@ -21,15 +27,22 @@ namespace timing {
     inline auto since(time_point start) {
         return std::chrono::duration_cast<duration>(clock::now() - start);
     }
+    /// Return the duration since the given start time point in nanoseconds.
+    inline auto since_ns(time_point start) {
+        return std::chrono::duration_cast<duration_ns>(clock::now() - start);
+    }
     /// Return a zero duration.
     inline auto zero() {
         return duration::zero();
     }
 }
 
+/**
+ * Accumulates the time spent in some operation with nanosecond resolution.
+ */
 class Timer {
     std::size_t m_count = 0;
-    timing::duration m_overall = timing::zero();
+    timing::duration_ns m_overall = timing::duration_ns::zero();
     timing::time_point m_current_start = timing::time_point::min();
 
 public:
@@ -38,8 +51,13 @@ public:
 	}
     void finish(timing::time_point start) {
 		++m_count;
-		m_overall += timing::since(start);
+		m_overall += timing::since_ns(start);
 	}
+    /// Adds the measurements of another timer.
+    void merge(const Timer& t) {
+        m_count += t.m_count;
+        m_overall += t.m_overall;
+    }
     void start_this() {
 		m_current_start = start();
 	}
@@ -58,15 +76,40 @@ public:
         return m_count;
     }
     auto overall_ms() const {
+        return std::chrono::duration_cast<timing::duration>(m_overall).count();
+    }
+    auto overall_ns() const {
         return m_overall.count();
     }
 
-    void collect(std::map<std::string, std::string>& data, const std::string& key) {
-        bool active_at_timeout = check_finish();
-        data.emplace(key+".count", std::to_string(count()));
-        data.emplace(key+".overall_ms",   std::to_string(overall_ms()));
-        data.emplace(key+".active_at_timeout", active_at_timeout ? "1" : "0");
+    /**
+     * Collects the values of this timer.
+     * If the timer is currently running and finish_active is set, the timer is stopped and reported as active at timeout.
+     * Otherwise, a running timer is left untouched, which is used for intermediate snapshots.
+     */
+    void collect(std::map<std::string, Value>& data, const std::string& key, bool finish_active = true) {
+        bool active = finish_active ? check_finish() : m_current_start != timing::time_point::min();
+        data.insert_or_assign(key+".count", count());
+        data.insert_or_assign(key+".overall_ms", overall_ms());
+        data.insert_or_assign(key+".overall_ns", overall_ns());
+        data.insert_or_assign(key+".active_at_timeout", active);
+    }
+};
+
+/**
+ * Measures the lifetime of a scope and reports it to a Timer, a Histogram or anything else that provides `finish(timing::time_point)`.
+ */
+template<typename T>
+class ScopeTimer {
+    T& m_target;
+    timing::time_point m_start = timing::now();
+public:
+    explicit ScopeTimer(T& target): m_target(target) {}
+    ~ScopeTimer() {
+        m_target.finish(m_start);
     }
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
 };
 
 }
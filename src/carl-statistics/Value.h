@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace carl::statistics {
+
+/**
+ * A single collected statistics value.
+ *
+ * Values keep their type such that exporters can write numbers as numbers.
+ * Everything that is not a number or a Boolean is stored as its string representation.
+ */
+class Value {
+public:
+    using Variant = std::variant<bool, std::int64_t, std::uint64_t, double, std::string>;
+private:
+    Variant m_value;
+public:
+    Value(): m_value(std::string()) {}
+    Value(bool b): m_value(b) {}
+    Value(const char* s): m_value(std::string(s)) {}
+    Value(std::string s): m_value(std::move(s)) {}
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    Value(T t) {
+        if constexpr (std::is_signed_v<T>) m_value = static_cast<std::int64_t>(t);
+        else m_value = static_cast<std::uint64_t>(t);
+    }
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    Value(T t): m_value(static_cast<double>(t)) {}
+
+    const Variant& value() const {
+        return m_value;
+    }
+    bool is_integer() const {
+        return std::holds_alternative<std::int64_t>(m_value) || std::holds_alternative<std::uint64_t>(m_value);
+    }
+    bool is_number() const {
+        return is_integer() || std::holds_alternative<double>(m_value);
+    }
+    /// Converts a number to a double.
+    double as_double() const {
+        return std::visit([](const auto& v) -> double {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) return 0;
+            else return static_cast<double>(v);
+        }, m_value);
+    }
+
+    /**
+     * Returns the difference between this value and an older value of the same statistic.
+     * Differences of integers are integers, differences of other numbers are doubles.
+     * Values that are no numbers are returned as they are.
+     */
+    Value delta(const Value& old) const {
+        if (std::holds_alternative<std::uint64_t>(m_value) && std::holds_alternative<std::uint64_t>(old.m_value)) {
+            return static_cast<std::int64_t>(std::get<std::uint64_t>(m_value) - std::get<std::uint64_t>(old.m_value));
+        }
+        if (is_integer() && old.is_integer()) {
+            return static_cast<std::int64_t>(as_double() - old.as_double());
+        }
+        if (is_number() && old.is_number()) {
+            return as_double() - old.as_double();
+        }
+        return *this;
+    }
+
+    /// Compares two values, where two NaNs are considered equal.
+    friend bool operator==(const Value& lhs, const Value& rhs) {
+        if (std::holds_alternative<double>(lhs.m_value) && std::holds_alternative<double>(rhs.m_value)) {
+            double l = std::get<double>(lhs.m_value);
+            double r = std::get<double>(rhs.m_value);
+            return l == r || (std::isnan(l) && std::isnan(r));
+        }
+        return lhs.m_value == rhs.m_value;
+    }
+    friend bool operator!=(const Value& lhs, const Value& rhs) {
+        return !(lhs == rhs);
+    }
+    /**
+     * Formats the value as statistics were formatted before they kept their types.
+     * Numbers and Booleans are streamed, e.g. 1.5 as 1.5 and true as 1.
+     */
+    std::string to_string() const {
+        if (const auto* s = std::get_if<std::string>(&m_value)) return *s;
+        std::ostringstream ss;
+        ss << *this;
+        return ss.str();
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Value& v) {
+        std::visit([&os](const auto& val) { os << val; }, v.m_value);
+        return os;
+    }
+};
+
+/**
+ * Writes a string as a JSON string literal.
+ */
+inline void write_json(std::ostream& os, const std::string& s) {
+    os << '"';
+    for (char c: s) {
+        switch (c) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\r': os << "\\r"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+/**
+ * Writes a Value as JSON. Numbers that are not finite are written as null.
+ */
+inline void write_json(std::ostream& os, const Value& v) {
+    std::visit([&os](const auto& val) {
+        using T = std::decay_t<decltype(val)>;
+        if constexpr (std::is_same_v<T, bool>) os << (val ? "true" : "false");
+        else if constexpr (std::is_same_v<T, std::string>) write_json(os, val);
+        else if constexpr (std::is_same_v<T, double>) {
+            if (!std::isfinite(val)) {
+                os << "null";
+                return;
+            }
+            auto precision = os.precision(17);
+            os << val;
+            os.precision(precision);
+        }
+        else os << val;
+    }, v.value());
+}
+
+}
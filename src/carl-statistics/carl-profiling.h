@@ -0,0 +1,24 @@
+/**
+ * @file
+ *
+ * Macros to mark profiler zones within carl.
+ *
+ * If CARL_DEVOPTION_Profiling is not set, all macros are empty and this header does not pull in anything else.
+ * Otherwise, `CARL_PROFILE_ZONE(name)` measures the remaining lifetime of the current scope and reports it to the zone with the given name, see Profiler.
+ */
+
+#pragma once
+
+#include "config.h"
+
+#ifdef CARL_DEVOPTION_Profiling
+    #include "Profiler.h"
+
+    #define __CARL_PROFILE_CONCAT(a, b) a ## b
+    #define __CARL_PROFILE_ZONE(name, line) \
+        static carl::statistics::ProfilerZone& __CARL_PROFILE_CONCAT(__carl_profile_zone_, line) = carl::statistics::Profiler::getInstance().zone(name); \
+        carl::statistics::ProfilerScope __CARL_PROFILE_CONCAT(__carl_profile_scope_, line)(__CARL_PROFILE_CONCAT(__carl_profile_zone_, line))
+    #define CARL_PROFILE_ZONE(name) __CARL_PROFILE_ZONE(name, __LINE__)
+#else
+    #define CARL_PROFILE_ZONE(name)
+#endif
@@ -23,11 +23,15 @@ namespace statistics {
     #define CARL_CALL_STATISTICS(function) function
     #define CARL_TIME_START(variable) auto variable = carl::statistics::Timer::start()
     #define CARL_TIME_FINISH(timer, variable) timer.finish(variable)
+    #define __CARL_TIME_SCOPE_NAME(line) __carl_scope_timer_ ## line
+    #define __CARL_TIME_SCOPE(timer, line) carl::statistics::ScopeTimer __CARL_TIME_SCOPE_NAME(line)(timer)
+    #define CARL_TIME_SCOPE(timer) __CARL_TIME_SCOPE(timer, __LINE__)
 #else
     #define CARL_INIT_STATISTICS(class, variable, name)
     #define CARL_CALL_STATISTICS(function)
     #define CARL_TIME_START(variable)
     #define CARL_TIME_FINISH(timer, start)
+    #define CARL_TIME_SCOPE(timer)
 #endif
 
 
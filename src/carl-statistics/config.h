@@ -0,0 +1,7 @@
+/**
+ * Auto generated file config.h from config.h.in.
+ */ 
+#pragma once
+
+/* #undef CARL_DEVOPTION_Statistics */
+/* #undef CARL_DEVOPTION_Profiling */
@@ -0,0 +1,118 @@
+/**
+ * @file
+ *
+ * Replays a trace that was recorded with CARL_DEVOPTION_Recording and reports the time spent for each type of operation.
+ *
+ * Usage: replayTrace <trace> [repetitions]
+ *
+ * Every operation is executed the given number of times (one by default).
+ * For each type of operation, the number of calls, the total time of the original calls (times the number of repetitions) and of the replay as well as the median and the 99th percentile of the replay are printed.
+ */
+
+#include <carl-arith/poly/umvpoly/functions/Factorization.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
+#include <carl-arith/poly/umvpoly/functions/Resultant.h>
+#include <carl-arith/ran/ran.h>
+#include <carl-arith/trace/TraceReader.h>
+#include <carl-statistics/Histogram.h>
+
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using Rational = mpq_class;
+using Poly = carl::MultivariatePolynomial<Rational>;
+using UPoly = carl::UnivariatePolynomial<Rational>;
+using UMPoly = carl::UnivariatePolynomial<Poly>;
+
+struct OperationStatistics {
+	std::uint64_t recorded_ns = 0;
+	carl::statistics::Histogram replayed;
+};
+
+/// Decodes the operands of the record and executes the operation.
+void replay(carl::trace::TraceReader::Record& record, std::size_t repetitions, OperationStatistics& stats) {
+	using carl::trace::Operation;
+	auto& d = record.operands;
+	auto run = [&](auto&& f) {
+		for (std::size_t i = 0; i < repetitions; ++i) {
+			auto start = carl::statistics::timing::now();
+			f();
+			stats.replayed.finish(start);
+		}
+	};
+	switch (record.operation) {
+		case Operation::Multiply: {
+			auto p = carl::trace::read_polynomial<Poly>(d);
+			auto q = carl::trace::read_polynomial<Poly>(d);
+			run([&]{ return p * q; });
+			break;
+		}
+		case Operation::GCD: {
+			auto p = carl::trace::read_polynomial<Poly>(d);
+			auto q = carl::trace::read_polynomial<Poly>(d);
+			run([&]{ return carl::gcd(p, q); });
+			break;
+		}
+		case Operation::Resultant: {
+			auto p = carl::trace::read_univariate<Poly>(d);
+			auto q = carl::trace::read_univariate<Poly>(d);
+			run([&]{ return carl::resultant(p, q); });
+			break;
+		}
+		case Operation::Factorization: {
+			auto p = carl::trace::read_polynomial<Poly>(d);
+			run([&]{ return carl::factorization(p); });
+			break;
+		}
+		case Operation::RealRoots: {
+			auto p = carl::trace::read_univariate<Rational>(d);
+			run([&]{ return carl::real_roots(p); });
+			break;
+		}
+	}
+	stats.recorded_ns += record.duration_ns * repetitions;
+}
+
+double ms(std::uint64_t ns) {
+	return static_cast<double>(ns) / 1e6;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2 || argc > 3) {
+		std::cerr << "Usage: " << argv[0] << " <trace> [repetitions]" << std::endl;
+		return 1;
+	}
+	std::size_t repetitions = argc == 3 ? std::stoul(argv[2]) : 1;
+
+	std::map<carl::trace::Operation, OperationStatistics> stats;
+	try {
+		carl::trace::TraceReader reader(argv[1]);
+		while (auto record = reader.next()) {
+			replay(*record, repetitions, stats[record->operation]);
+		}
+	} catch (const std::runtime_error& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(16) << "operation" << std::right
+		<< std::setw(10) << "calls"
+		<< std::setw(16) << "recorded ms"
+		<< std::setw(16) << "replayed ms"
+		<< std::setw(14) << "p50 us"
+		<< std::setw(14) << "p99 us" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	for (const auto& [op, s]: stats) {
+		std::cout << std::left << std::setw(16) << carl::trace::name(op) << std::right
+			<< std::setw(10) << s.replayed.count()
+			<< std::setw(16) << ms(s.recorded_ns)
+			<< std::setw(16) << ms(s.replayed.sum())
+			<< std::setw(14) << static_cast<double>(s.replayed.percentile(0.5)) / 1e3
+			<< std::setw(14) << static_cast<double>(s.replayed.percentile(0.99)) / 1e3 << std::endl;
+	}
+	return 0;
+}
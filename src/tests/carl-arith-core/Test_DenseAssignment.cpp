@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/DenseAssignment.h>
+#include <carl-arith/core/VariablePool.h>
+
+#include <vector>
+
+TEST(DenseAssignment, Basic)
+{
+	carl::Variable x = carl::fresh_real_variable("x");
+	carl::Variable y = carl::fresh_integer_variable("y");
+	carl::Variable z = carl::fresh_real_variable("z");
+
+	carl::DenseAssignment<int> a;
+	EXPECT_TRUE(a.empty());
+	a.assign(x, 1);
+	a.assign(y, 2);
+	EXPECT_EQ(a.size(), 2);
+	EXPECT_TRUE(a.contains(x));
+	EXPECT_FALSE(a.contains(z));
+	EXPECT_EQ(a.get(z), nullptr);
+	EXPECT_EQ(a.at(y), 2);
+	a.assign(x, 3);
+	EXPECT_EQ(a.size(), 2);
+	EXPECT_EQ(a.at(x), 3);
+	EXPECT_TRUE(a.erase(x));
+	EXPECT_FALSE(a.erase(x));
+	EXPECT_EQ(a.size(), 1);
+
+	carl::Assignment<int> map = a.to_map();
+	EXPECT_EQ(map, (carl::Assignment<int>({{y, 2}})));
+	EXPECT_EQ(carl::DenseAssignment<int>(map).to_map(), map);
+}
+
+TEST(DenseAssignment, Versioning)
+{
+	carl::Variable x = carl::fresh_real_variable("x");
+	carl::Variable y = carl::fresh_real_variable("y");
+	carl::Variable z = carl::fresh_real_variable("z");
+
+	carl::DenseAssignment<int> a;
+	a.assign(x, 1);
+	a.assign(y, 2);
+	std::size_t version = a.version();
+	a.assign(z, 3);
+	a.erase(x);
+
+	std::vector<std::pair<carl::Variable, const int*>> changes;
+	a.for_each_changed_since(version, [&](carl::Variable v, const int* value) { changes.emplace_back(v, value); });
+	ASSERT_EQ(changes.size(), 2);
+	EXPECT_EQ(changes[0].first, x);
+	EXPECT_EQ(changes[0].second, nullptr);
+	EXPECT_EQ(changes[1].first, z);
+	EXPECT_EQ(*changes[1].second, 3);
+
+	changes.clear();
+	a.for_each_changed_since(a.version(), [&](carl::Variable v, const int* value) { changes.emplace_back(v, value); });
+	EXPECT_TRUE(changes.empty());
+
+	carl::DenseAssignment<int> b = a;
+	EXPECT_NE(a.uid(), b.uid());
+	std::size_t uid = a.uid();
+	a.clear();
+	EXPECT_NE(a.uid(), uid);
+}
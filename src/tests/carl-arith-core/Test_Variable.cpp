@@ -27,3 +27,11 @@ TEST(Variable, Comparison)
 	list.push_back(v1);
 	list.push_back(v0);
 }
+
+TEST(Variable, DenseIndex)
+{
+	carl::Variable v1 = carl::fresh_real_variable("di1");
+	carl::Variable v2 = carl::fresh_integer_variable("di2");
+	EXPECT_NE(v1.dense_index(), v2.dense_index());
+	EXPECT_EQ(v1.id() * static_cast<std::size_t>(carl::VariableType::TYPE_SIZE) + static_cast<std::size_t>(carl::VariableType::VT_REAL), v1.dense_index());
+}
@@ -5,6 +5,7 @@
 #include <carl-arith/poly/umvpoly/CoCoAAdaptor.h>
 #include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
 #include <carl-arith/poly/umvpoly/functions/CoprimePart.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
 #include <carl-arith/poly/umvpoly/functions/SquareFreePart.h>
 #include <carl-common/debug/Timer.h>
 
@@ -131,6 +132,32 @@ TEST(CoCoA, SquareFreePart) {
 	}
 }
 
+TEST(CoCoA, AdaptorContext) {
+	using Poly = carl::MultivariatePolynomial<mpq_class>;
+	carl::Variable x = carl::fresh_real_variable("x");
+	carl::Variable y = carl::fresh_real_variable("y");
+
+	Poly p1 = (x * x) - mpq_class(1);
+	Poly p2 = (x + mpq_class(1)) * (y - mpq_class(2)) * mpq_class(1, 3);
+	auto& context = carl::CoCoAAdaptorContext<Poly>::get();
+	std::size_t size = context.size();
+	auto c = context.adaptor(p1, p2);
+	EXPECT_EQ(x + mpq_class(1), c->gcd(p1, p2));
+	EXPECT_EQ(p2, c->convert(c->convert(p2)));
+	EXPECT_EQ(Poly(), c->convert(c->convert(Poly())));
+	// The ring is reused for the same set of variables.
+	EXPECT_EQ(c, context.adaptor(p2, p1));
+	EXPECT_EQ(size + 1, context.size());
+	EXPECT_EQ(x + mpq_class(1), carl::gcd(p1, p2));
+	EXPECT_EQ(size + 1, context.size());
+	// The adaptor stays usable after it was dropped from the context.
+	for (std::size_t i = 0; i < 64; ++i) {
+		context.adaptor(Poly(carl::fresh_real_variable()));
+	}
+	EXPECT_NE(c, context.adaptor(p1, p2));
+	EXPECT_EQ(x + mpq_class(1), c->gcd(p1, p2));
+}
+
 TEST(CoCoA, SquareFreeBase)
 {
 	using Poly = carl::MultivariatePolynomial<mpq_class>;
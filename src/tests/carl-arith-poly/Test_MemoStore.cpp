@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/memo/Memoization.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/Factorization.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+
+namespace {
+
+std::string temporary_file() {
+	char filename[] = "/tmp/carl_memoXXXXXX";
+	int fd = mkstemp(filename);
+	close(fd);
+	return filename;
+}
+
+}
+
+TEST(MemoStore, Codec)
+{
+	Variable x = fresh_real_variable("memo_x");
+	Variable y = fresh_real_variable("memo_y");
+	Poly p = Poly(Rational(3, 5)) * x * x * y - Poly(y) + Poly(Rational(7));
+	memo::Codec<Poly> codec(p);
+	EXPECT_TRUE(codec.valid());
+
+	// Variables with the same names, as they would be created in another run.
+	Variable x2 = fresh_real_variable("memo_x");
+	Variable y2 = fresh_real_variable("memo_y");
+	Poly p2 = Poly(Rational(7)) - Poly(y2) + Poly(Rational(3, 5)) * y2 * x2 * x2;
+	memo::Codec<Poly> codec2(p2);
+	EXPECT_EQ(codec.key(0, p), codec2.key(0, p2));
+	EXPECT_NE(codec.key(0, p), codec.key(1, p));
+
+	std::string buffer;
+	EXPECT_TRUE(codec.write(buffer, p));
+	std::map<std::size_t, Variable> noVariables;
+	trace::Decoder d(buffer.data(), buffer.data() + buffer.size(), noVariables);
+	Poly res;
+	codec2.read(d, res);
+	EXPECT_EQ(p2, res);
+	EXPECT_TRUE(d.empty());
+
+	// Results depend on the variable ordering, which is part of the key.
+	Variable y3 = fresh_real_variable("memo_y");
+	Variable x3 = fresh_real_variable("memo_x");
+	Poly p3 = Poly(Rational(7)) - Poly(y3) + Poly(Rational(3, 5)) * y3 * x3 * x3;
+	EXPECT_NE(codec.key(0, p), memo::Codec<Poly>(p3).key(0, p3));
+
+	// Results may only contain variables of the operands.
+	EXPECT_FALSE(codec.write(buffer, p2));
+	EXPECT_FALSE(memo::Codec<Poly>(p, p2).valid());
+}
+
+TEST(MemoStore, Persistence)
+{
+	std::string filename = temporary_file();
+	auto& store = memo::MemoStore::getInstance();
+	ASSERT_TRUE(store.open(filename));
+	Variable x = fresh_real_variable("memo_px");
+	Variable y = fresh_real_variable("memo_py");
+	Poly a = (Poly(x) + Poly(y)) * (Poly(x) - Poly(Rational(2)));
+	Poly b = (Poly(x) + Poly(y)) * (Poly(y) + Poly(Rational(3)));
+	Poly g = carl::gcd(a, b);
+	EXPECT_EQ(1u, store.size());
+	std::size_t hits = store.hits();
+	EXPECT_EQ(g, carl::gcd(a, b));
+	EXPECT_EQ(hits + 1, store.hits());
+	auto factors = carl::factorization(a * b);
+	EXPECT_EQ(factors, carl::factorization(a * b));
+	EXPECT_EQ(carl::irreducible_factors(a), carl::irreducible_factors(a));
+	EXPECT_EQ(3u, store.size());
+	store.close();
+	EXPECT_FALSE(store.active());
+
+	// An incomplete record at the end is discarded.
+	std::ofstream(filename, std::ios::binary | std::ios::app).write("\x03\x40", 2);
+	ASSERT_TRUE(store.open(filename));
+	EXPECT_EQ(3u, store.size());
+	Variable x2 = fresh_real_variable("memo_px");
+	Variable y2 = fresh_real_variable("memo_py");
+	Poly a2 = (Poly(x2) + Poly(y2)) * (Poly(x2) - Poly(Rational(2)));
+	Poly b2 = (Poly(x2) + Poly(y2)) * (Poly(y2) + Poly(Rational(3)));
+	hits = store.hits();
+	Poly g2 = carl::gcd(a2, b2);
+	EXPECT_EQ(hits + 1, store.hits());
+	EXPECT_EQ(Poly(x2) + Poly(y2), g2);
+	EXPECT_EQ(carl::gcd(a * Rational(2), b), g);
+	EXPECT_EQ(4u, store.size());
+	store.close();
+
+	ASSERT_TRUE(store.open(filename));
+	EXPECT_EQ(4u, store.size());
+	store.close();
+	std::remove(filename.c_str());
+}
+
+TEST(MemoStore, Errors)
+{
+	std::string filename = temporary_file();
+	std::ofstream(filename, std::ios::binary) << "NOTAMEMOSTORE";
+	auto& store = memo::MemoStore::getInstance();
+	EXPECT_FALSE(store.open(filename));
+	EXPECT_FALSE(store.active());
+	std::remove(filename.c_str());
+	EXPECT_FALSE(store.open("/nonexistent/directory/memo"));
+
+	// Short files are only initialized if they are empty or start with an incomplete header.
+	filename = temporary_file();
+	std::ofstream(filename, std::ios::binary) << "abc";
+	EXPECT_FALSE(store.open(filename));
+	std::string content;
+	std::getline(std::ifstream(filename, std::ios::binary), content);
+	EXPECT_EQ("abc", content);
+	std::ofstream(filename, std::ios::binary) << "CARL";
+	EXPECT_TRUE(store.open(filename));
+	EXPECT_EQ(0u, store.size());
+	store.close();
+	std::remove(filename.c_str());
+
+	// A record with a corrupt size is discarded.
+	filename = temporary_file();
+	ASSERT_TRUE(store.open(filename));
+	store.close();
+	std::ofstream(filename, std::ios::binary | std::ios::app).write("\x01\xff\xff\xff\xff\xff\xff\xff\xff\x7f", 10);
+	EXPECT_TRUE(store.open(filename));
+	EXPECT_EQ(0u, store.size());
+	store.close();
+	EXPECT_EQ(8u, std::filesystem::file_size(filename));
+	std::remove(filename.c_str());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+using IntPoly = MultivariatePolynomial<mpz_class>;
+
+namespace {
+
+/// The gcd has a positive leading coefficient with respect to the monomial ordering.
+template<typename P>
+P normalized(const P& p) {
+	return carl::is_negative(p.lcoeff()) ? P(-p) : p;
+}
+
+}
+
+TEST(ModularGCD, Rational)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	Poly g = Poly(x) * y + Poly(z) * z * Rational(3) + Rational(1);
+	Poly a = g * (Poly(x) * x - Poly(y) * z);
+	Poly b = g * (Poly(y) * y * z + Poly(x) + Rational(2));
+	EXPECT_EQ(normalized(g), brown::gcd(a, b));
+	// The result has coprime integer coefficients and a positive leading coefficient.
+	EXPECT_EQ(normalized(g), brown::gcd(a * Rational(-2, 3), b * Rational(5, 7)));
+	EXPECT_EQ(Poly(1), brown::gcd(Poly(x) * x + y, Poly(y) * z + Rational(1)));
+}
+
+TEST(ModularGCD, Integer)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	IntPoly g = IntPoly(x) * mpz_class(2) - IntPoly(y) * mpz_class(3);
+	IntPoly a = g * (IntPoly(x) * y + mpz_class(1)) * mpz_class(6);
+	IntPoly b = g * (IntPoly(x) + mpz_class(5)) * mpz_class(-4);
+	// The integer content of the gcd is the gcd of the integer contents.
+	EXPECT_EQ(normalized(g * mpz_class(2)), brown::gcd(a, b));
+	EXPECT_EQ(IntPoly(mpz_class(2)), brown::gcd(a, IntPoly(y) * mpz_class(4) + mpz_class(2)));
+}
+
+TEST(ModularGCD, UnluckyEvaluations)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	Variable w = fresh_real_variable("w");
+	// All images at y = 0 share the factor x.
+	EXPECT_EQ(Poly(1), brown::gcd(Poly(x) + y, Poly(x) - y));
+	Poly g = Poly(x) * w + Poly(y) * z;
+	Poly a = g * (Poly(x) + Poly(y) * w);
+	Poly b = g * (Poly(x) - Poly(z) * w * w);
+	EXPECT_EQ(normalized(g), brown::gcd(a, b));
+	EXPECT_EQ(normalized(g), carl::gcd(a * g, b));
+}
+
+TEST(ModularGCD, DifferentVariables)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	Poly g = Poly(x) * x + Rational(1);
+	EXPECT_EQ(normalized(g), brown::gcd(g * y, g * (Poly(z) + Rational(2))));
+	EXPECT_EQ(Poly(x), brown::gcd(Poly(x) * y, Poly(x) * z));
+}
+
+TEST(ModularGCD, Large)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	// Dense operands of high degree, such that the images are computed in parallel on machines with several cores.
+	auto dense = [&](int offset) {
+		Poly res;
+		for (carl::uint i = 0; i <= 6; ++i) {
+			for (carl::uint j = 0; j + i <= 6; ++j) {
+				for (carl::uint l = 0; l + j + i <= 6; ++l) {
+					res += Poly(Rational(static_cast<int>(i + 2 * j + 3 * l) % 7 + offset)) * carl::pow(Poly(x), i) * carl::pow(Poly(y), j) * carl::pow(Poly(z), l);
+				}
+			}
+		}
+		return res;
+	};
+	Poly g = dense(1);
+	EXPECT_EQ(normalized(g), brown::gcd(g * dense(2), g * dense(3)));
+}
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 
 #include <carl-arith/poly/umvpoly/MonomialPool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-common/memory/Epochs.h>
 
 using namespace carl;
 
@@ -13,4 +15,87 @@ TEST(MonomialPool, singleton)
 	
 	auto m = createMonomial(x, 3);
 	EXPECT_EQ(pool2.size(), pool1.size());
-}
\ No newline at end of file
+}
+
+TEST(MonomialPool, memory_usage)
+{
+	MonomialPool& pool = MonomialPool::getInstance();
+	Variable x = fresh_real_variable("x");
+	MemoryUsage before = pool.memory_usage();
+	{
+		std::vector<Monomial::Arg> monomials;
+		for (exponent e = 1; e <= 100; ++e) monomials.push_back(createMonomial(x, e));
+		MemoryUsage usage = pool.memory_usage();
+		EXPECT_EQ(before.objects + 100, usage.objects);
+		EXPECT_GT(usage.object_bytes, before.object_bytes);
+		EXPECT_GE(usage.id_range, usage.objects);
+		EXPECT_GE(usage.peak_bytes, usage.total_bytes());
+	}
+	MemoryUsage after = pool.memory_usage();
+	EXPECT_EQ(before.objects, after.objects);
+	EXPECT_EQ(before.object_bytes, after.object_bytes);
+	EXPECT_GT(after.peak_bytes, after.total_bytes());
+}
+
+TEST(MonomialPool, compact)
+{
+	MonomialPool& pool = MonomialPool::getInstance();
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	auto mx = createMonomial(x, 1);
+	{
+		// Temporary monomials leave gaps in the ids.
+		std::vector<Monomial::Arg> monomials;
+		for (exponent e = 2; e <= 200; ++e) monomials.push_back(createMonomial(x, e));
+	}
+	auto my = createMonomial(y, 1);
+	auto mxy = mx * my;
+	std::size_t old_id = my->id();
+	std::size_t old_largest = pool.largestID();
+
+	std::size_t notified = 0;
+	auto handle = pool.compaction_listeners().add([&](const IDRemapping& r){ notified = r.new_range(); });
+	IDRemapping remapping = pool.compact();
+	pool.compaction_listeners().remove(handle);
+
+	EXPECT_EQ(pool.size() + 1, remapping.new_range());
+	EXPECT_EQ(remapping.new_range(), notified);
+	EXPECT_EQ(pool.largestID() + 1, remapping.new_range());
+	EXPECT_LT(pool.largestID(), old_largest);
+	EXPECT_EQ(my->id(), remapping(old_id));
+	EXPECT_LT(mx->id(), my->id());
+	EXPECT_EQ(mxy, mx * my);
+	std::size_t next_id = pool.largestID() + 1;
+	EXPECT_EQ(next_id, createMonomial(x, 201)->id());
+
+	// Polynomial arithmetic still works with the shrunk id maps.
+	using Pol = MultivariatePolynomial<mpq_class>;
+	Pol p = Pol(x) + Pol(y);
+	EXPECT_EQ(Pol(x) * x + Pol(2) * x * y + Pol(y) * y, p * p);
+}
+
+TEST(MonomialPool, epochs)
+{
+	MonomialPool& pool = MonomialPool::getInstance();
+	Variable x = fresh_real_variable("x");
+	std::size_t size = pool.size();
+	Monomial::Arg kept;
+	{
+		EpochScope<MonomialPool> outer;
+		pool.push_epoch();
+		for (exponent e = 1; e <= 10; ++e) {
+			auto m = createMonomial(x, e);
+			if (e == 5) kept = m;
+		}
+		// The monomials are kept alive by the epoch.
+		EXPECT_EQ(size + 10, pool.size());
+		EXPECT_EQ(2, pool.epoch_depth());
+		EXPECT_EQ(9, pool.pop_epoch());
+		EXPECT_EQ(size + 1, pool.size());
+		EXPECT_EQ(kept, createMonomial(x, 5));
+	}
+	EXPECT_EQ(0, pool.epoch_depth());
+	EXPECT_EQ(size + 1, pool.size());
+	kept.reset();
+	EXPECT_EQ(size, pool.size());
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/Factorization_multivariate.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+using IntPoly = MultivariatePolynomial<mpz_class>;
+
+namespace {
+
+Poly product(const Factors<Poly>& factors) {
+	Poly res(1);
+	for (const auto& [f, e]: factors) res *= carl::pow(f, e);
+	return res;
+}
+
+/// Factors are returned with positive leading coefficient with respect to the monomial ordering.
+template<typename P>
+P normalized(const P& p) {
+	return carl::is_negative(p.lcoeff()) ? P(-p) : p;
+}
+
+std::size_t nonconstant_factors(const Factors<Poly>& factors) {
+	std::size_t res = 0;
+	for (const auto& [f, e]: factors) {
+		if (!f.is_constant()) res += e;
+	}
+	return res;
+}
+
+}
+
+TEST(NativeFactorization, Zassenhaus)
+{
+	using namespace carl::zassenhaus;
+	// x^4 + 4 = (x^2 - 2x + 2) * (x^2 + 2x + 2)
+	auto factors = factor_squarefree(Dense({4, 0, 0, 0, 1}));
+	std::sort(factors.begin(), factors.end());
+	EXPECT_EQ(std::vector<Dense>({ {2, -2, 1}, {2, 2, 1} }), factors);
+	// x^4 + 1 is irreducible, but splits modulo every prime.
+	EXPECT_EQ(std::vector<Dense>({ {1, 0, 0, 0, 1} }), factor_squarefree(Dense({1, 0, 0, 0, 1})));
+	// Non-monic factors whose product needs a large modulus.
+	Dense f = mul(mul(Dense({-1, 23}), Dense({-25, 3})), Dense({75, 2, 45}));
+	factors = factor_squarefree(f);
+	std::sort(factors.begin(), factors.end());
+	EXPECT_EQ(std::vector<Dense>({ {-25, 3}, {-1, 23}, {75, 2, 45} }), factors);
+}
+
+TEST(NativeFactorization, Multivariate)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	Variable w = fresh_real_variable("w");
+	Poly a = Poly(x) * x * z + y;
+	Poly b = Poly(y) * y * z + x;
+	Poly c = Poly(z) * z * x + y + w;
+	auto factors = eez::factorization(a * b * c);
+	EXPECT_EQ(a * b * c, product(factors));
+	EXPECT_EQ(3u, factors.size());
+	EXPECT_EQ(1u, factors.count(a));
+
+	Poly d = carl::pow(Poly(x), 4) + Rational(4) * carl::pow(Poly(y), 4);
+	factors = eez::factorization(d);
+	EXPECT_EQ(d, product(factors));
+	EXPECT_EQ(2u, nonconstant_factors(factors));
+
+	Poly irreducible = Poly(x) * x + Poly(x) * y + Poly(y) * y + Rational(1);
+	factors = eez::factorization(irreducible);
+	EXPECT_EQ(Factors<Poly>({ {irreducible, 1} }), factors);
+}
+
+TEST(NativeFactorization, RepeatedFactors)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	Poly p = carl::pow(Poly(x) + y, 2) * carl::pow(Poly(x) - y, 3) * (Poly(z) + Rational(1));
+	auto factors = eez::factorization(p);
+	EXPECT_EQ(p, product(factors));
+	EXPECT_EQ(2u, factors[normalized(Poly(x) + y)]);
+	EXPECT_EQ(3u, factors[normalized(Poly(x) - y)]);
+
+	Poly q = carl::pow(Poly(x) * y * z + Rational(2), 3) * Poly(x) * x * y;
+	factors = eez::factorization(q);
+	EXPECT_EQ(q, product(factors));
+	EXPECT_EQ(3u, factors[Poly(x) * y * z + Rational(2)]);
+	EXPECT_EQ(2u, factors[Poly(x)]);
+	EXPECT_EQ(1u, factors[Poly(y)]);
+}
+
+TEST(NativeFactorization, Constants)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Poly p = Rational(-3, 2) * (Poly(x) * y - Rational(1)) * (Rational(2) * x + Rational(1));
+	auto factors = eez::factorization(p);
+	EXPECT_EQ(p, product(factors));
+	EXPECT_EQ(1u, factors.count(Poly(Rational(-3, 2))));
+	EXPECT_EQ(1u, factors.count(normalized(Rational(2) * x + Rational(1))));
+
+	factors = eez::factorization(p, false);
+	EXPECT_EQ(2u, factors.size());
+	EXPECT_EQ(0u, factors.count(Poly(Rational(-3, 2))));
+}
+
+TEST(NativeFactorization, IntegerCoefficients)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	IntPoly a = IntPoly(x) * x - IntPoly(y) * y * mpz_class(4);
+	IntPoly p = a * mpz_class(6);
+	IntPoly b = normalized(IntPoly(x) - IntPoly(y) * mpz_class(2));
+	IntPoly c = normalized(IntPoly(x) + IntPoly(y) * mpz_class(2));
+	auto factors = eez::factorization(p);
+	EXPECT_EQ(Factors<IntPoly>({ {IntPoly(p.lcoeff() / (b.lcoeff() * c.lcoeff())), 1}, {b, 1}, {c, 1} }), factors);
+}
+
+TEST(NativeFactorization, RationalCoefficients)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Poly p = carl::pow(Poly(x) + Rational(1), 2) * Rational(1, 2);
+	auto factors = eez::factorization(p);
+	EXPECT_EQ(Factors<Poly>({ {Poly(Rational(1, 2)), 1}, {Poly(x) + Rational(1), 2} }), factors);
+
+	Poly q = carl::pow(Poly(x) + y, 2) * Rational(1, 2);
+	factors = eez::factorization(q);
+	EXPECT_EQ(q, product(factors));
+	EXPECT_EQ(2u, factors[normalized(Poly(x) + y)]);
+
+	Poly r = (Poly(x) * Rational(1, 3) + Rational(1, 2)) * (Poly(x) * y - Rational(2, 5));
+	factors = eez::factorization(r);
+	EXPECT_EQ(r, product(factors));
+	EXPECT_EQ(2u, nonconstant_factors(factors));
+}
+
+TEST(NativeFactorization, UnivariateRepeatedFactors)
+{
+	Variable x = fresh_real_variable("x");
+	Poly p = carl::pow(Poly(x) - Rational(1), 3) * carl::pow(Poly(x) * x + Rational(1), 2) * (Poly(x) + Rational(2));
+	auto factors = eez::factorization(p);
+	EXPECT_EQ(p, product(factors));
+	EXPECT_EQ(3u, factors[normalized(Poly(x) - Rational(1))]);
+	EXPECT_EQ(2u, factors[Poly(x) * x + Rational(1)]);
+	EXPECT_EQ(1u, factors[Poly(x) + Rational(2)]);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/trace/Recorder.h>
+#include <carl-arith/trace/TraceReader.h>
+
+#include <cstdio>
+
+#include "../Common.h"
+
+using namespace carl;
+
+TEST(Trace, Encoding)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	using Poly = MultivariatePolynomial<Rational>;
+	Poly p = Poly(Rational("-12345678901234567890123/7")) * x * x * y + Poly(y) - Poly(3);
+	UnivariatePolynomial<Poly> up(x, {Poly(y), Poly(0), Poly(y) * y - Poly(1)});
+	UnivariatePolynomial<Rational> uq(x, {Rational(-2), Rational(0), Rational(1, 3)});
+
+	std::string buffer;
+	std::vector<Variable> vars;
+	trace::Encoder e(buffer, vars);
+	e.write(p);
+	e.write(up);
+	e.write(uq);
+	e.write(mpz_class(-300));
+
+	std::map<std::size_t, Variable> map = { { trace::key(x), x }, { trace::key(y), y } };
+	trace::Decoder d(buffer.data(), buffer.data() + buffer.size(), map);
+	EXPECT_EQ(p, trace::read_polynomial<Poly>(d));
+	EXPECT_EQ(up, trace::read_univariate<Poly>(d));
+	EXPECT_EQ(uq, trace::read_univariate<Rational>(d));
+	EXPECT_EQ(mpz_class(-300), d.integer());
+	EXPECT_TRUE(d.empty());
+	EXPECT_THROW(d.byte(), std::runtime_error);
+}
+
+TEST(Trace, RecordAndRead)
+{
+	Variable x = fresh_real_variable("x");
+	using Poly = MultivariatePolynomial<Rational>;
+	Poly p = Poly(x) * x - Poly(2);
+	Poly q = Poly(x) + Poly(Rational(1, 2));
+
+	std::string filename = "carl_test_trace.bin";
+	ASSERT_TRUE(trace::Recorder::getInstance().start(filename));
+	{
+		trace::RecordScope outer(trace::Operation::Multiply, p, q);
+		// Nested operations are not recorded.
+		trace::RecordScope inner(trace::Operation::GCD, p, q);
+	}
+	{
+		trace::RecordScope s(trace::Operation::Factorization, p);
+	}
+	{
+		// Operands that can not be written are ignored.
+		trace::RecordScope s(trace::Operation::Factorization, MultivariatePolynomial<double>(x));
+	}
+	trace::Recorder::getInstance().stop();
+
+	trace::TraceReader reader(filename);
+	auto r1 = reader.next();
+	ASSERT_TRUE(r1);
+	EXPECT_EQ(trace::Operation::Multiply, r1->operation);
+	auto p1 = trace::read_polynomial<Poly>(r1->operands);
+	auto q1 = trace::read_polynomial<Poly>(r1->operands);
+	EXPECT_TRUE(r1->operands.empty());
+	// The variables are created anew for the replay.
+	auto vars = carl::variables(p1).as_vector();
+	ASSERT_EQ(1, vars.size());
+	Variable x1 = vars.front();
+	EXPECT_EQ("x", x1.name());
+	EXPECT_EQ(Poly(x1) * x1 - Poly(2), p1);
+	EXPECT_EQ(Poly(x1) + Poly(Rational(1, 2)), q1);
+
+	auto r2 = reader.next();
+	ASSERT_TRUE(r2);
+	EXPECT_EQ(trace::Operation::Factorization, r2->operation);
+	EXPECT_EQ(Poly(x1) * x1 - Poly(2), trace::read_polynomial<Poly>(r2->operands));
+
+	EXPECT_FALSE(reader.next());
+	std::remove(filename.c_str());
+}
+
+TEST(Trace, MixedTypes)
+{
+	// Variable ids are only unique per type, create an integer and a real variable with the same id.
+	Variable i = fresh_integer_variable("i");
+	Variable x = fresh_real_variable("x");
+	while (i.id() != x.id()) {
+		if (i.id() < x.id()) i = fresh_integer_variable("i");
+		else x = fresh_real_variable("x");
+	}
+	using Poly = MultivariatePolynomial<Rational>;
+	Poly p = Poly(x) * i + Poly(x);
+
+	std::string filename = "carl_test_trace_types.bin";
+	ASSERT_TRUE(trace::Recorder::getInstance().start(filename));
+	{
+		trace::RecordScope s(trace::Operation::Factorization, p);
+	}
+	trace::Recorder::getInstance().stop();
+
+	trace::TraceReader reader(filename);
+	auto r = reader.next();
+	ASSERT_TRUE(r);
+	auto vars = carl::variables(trace::read_polynomial<Poly>(r->operands)).as_vector();
+	ASSERT_EQ(2, vars.size());
+	EXPECT_NE(vars[0].type(), vars[1].type());
+	std::remove(filename.c_str());
+}
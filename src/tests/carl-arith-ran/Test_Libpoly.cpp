@@ -4,6 +4,11 @@
 #include <gtest/gtest.h>
 
 #include <random>
+#include <sstream>
+#include <string>
+#ifdef THREAD_SAFE
+#include <thread>
+#endif
 
 #include "../Common.h"
 #include <carl-arith/core/VariablePool.h>
@@ -94,4 +99,38 @@ TEST(LIBPOLY, convertRan) {
     }
 }
 
+#ifdef THREAD_SAFE
+TEST(LIBPOLY, concurrentRealRoots) {
+    Variable x = fresh_real_variable("x");
+    Variable y = fresh_real_variable("y");
+
+    std::vector<std::size_t> num_roots(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_roots.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            LPContext context({x, y});
+            LPPolynomial px(context, x);
+            LPPolynomial py(context, y);
+            LPPolynomial p = px * px - py * py;
+            Variable other = (p.main_var() == x) ? y : x;
+            for (long i = 1; i <= 50; ++i) {
+                // Creating variables reallocates the variable database while other threads print.
+                LPContext extended({x, y, fresh_real_variable("z" + std::to_string(t))});
+                std::stringstream ss;
+                ss << p;
+                EXPECT_FALSE(ss.str().empty());
+                Assignment<LPRealAlgebraicNumber> m;
+                m.emplace(other, LPRealAlgebraicNumber(mpq_class(i)));
+                auto res = real_roots(p, m);
+                if (res.is_univariate() && res.roots().size() == 2) ++num_roots[t];
+            }
+        });
+    }
+    for (auto& t: threads) t.join();
+    for (auto n: num_roots) {
+        EXPECT_EQ(n, 50);
+    }
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -99,6 +99,89 @@ TEST(RealAlgebraicNumber, EvalBug2)
 	EXPECT_TRUE((bool) res);
 }
 
+TEST(RealAlgebraicNumber, EvalDenseAssignment)
+{
+	Variable x0 = fresh_real_variable("x0");
+	Variable x1 = fresh_real_variable("x1");
+	Variable x2 = fresh_real_variable("x2");
+	MultivariatePolynomial<Rational> poly(Rational(2)*MultivariatePolynomial<Rational>(x1) + Rational(3)*MultivariatePolynomial<Rational>(x2));
+
+	Variable h = fresh_real_variable("h");
+	UnivariatePolynomial<Rational> py(h, std::initializer_list<Rational>{-2, 0, 1});
+	IntRepRealAlgebraicNumber<Rational> sqrt2 = IntRepRealAlgebraicNumber<Rational>::create_safe(py, Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
 
+	carl::DenseAssignment<IntRepRealAlgebraicNumber<Rational>> eval;
+	eval.assign(x0, IntRepRealAlgebraicNumber<Rational>(Rational(-8)));
+	eval.assign(x1, IntRepRealAlgebraicNumber<Rational>(Rational(-3)));
+	eval.assign(x2, sqrt2);
+
+	auto res = carl::evaluate(poly, eval);
+	ASSERT_TRUE((bool) res);
+	EXPECT_TRUE(*res > Rational(-2) && *res < Rational(-1));
+	EXPECT_TRUE(carl::evaluate(BasicConstraint<MultivariatePolynomial<Rational>>(poly, Relation::LESS), eval));
+
+	eval.assign(x1, IntRepRealAlgebraicNumber<Rational>(Rational(-2)));
+	EXPECT_FALSE(carl::evaluate(BasicConstraint<MultivariatePolynomial<Rational>>(poly, Relation::LESS), eval));
+}
 
 
+
+
+
+TEST(RealAlgebraicNumber, SortBatched)
+{
+	using RAN = IntRepRealAlgebraicNumber<Rational>;
+	Variable x = fresh_real_variable("x");
+	RAN sqrt2 = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-2, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN sqrt3 = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-3, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN sqrt2b = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-2, 0, 1}) * UnivariatePolynomial<Rational>(x, {-3, 0, 1}), Interval<Rational>(Rational(13)/10, BoundType::STRICT, Rational(3)/2, BoundType::STRICT));
+	RAN msqrt2 = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-2, 0, 1}), Interval<Rational>(-2, BoundType::STRICT, -1, BoundType::STRICT));
+
+	std::vector<RAN> rans({sqrt3, RAN(Rational(3)/2), sqrt2, msqrt2, sqrt2b, RAN(Rational(0))});
+	sort_batched(rans);
+	ASSERT_EQ(rans.size(), 6);
+	EXPECT_EQ(rans[0], msqrt2);
+	EXPECT_EQ(rans[1], Rational(0));
+	EXPECT_EQ(rans[2], sqrt2);
+	EXPECT_EQ(rans[3], sqrt2b);
+	EXPECT_EQ(rans[4], Rational(Rational(3)/2));
+	EXPECT_EQ(rans[5], sqrt3);
+	EXPECT_TRUE(std::is_sorted(rans.begin(), rans.end()));
+
+	// Numbers with disjoint intervals are compared without the cache.
+	RAN a = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-2, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN b = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-3, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	std::size_t hits = ran::interval::ComparisonCache::getInstance().hits();
+	EXPECT_TRUE(a < b);
+	EXPECT_TRUE(b > a);
+	EXPECT_FALSE(a == b);
+	EXPECT_EQ(ran::interval::ComparisonCache::getInstance().hits(), hits);
+	// Repeated comparisons of numbers whose intervals still overlap are answered by the cache.
+	RAN c = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-6, -2, 3, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	EXPECT_TRUE(a == c);
+	EXPECT_TRUE(c == a);
+	EXPECT_FALSE(a < c);
+	EXPECT_EQ(ran::interval::ComparisonCache::getInstance().hits(), hits + 2);
+}
+
+TEST(RealAlgebraicNumber, RefineToPrecision)
+{
+	using RAN = IntRepRealAlgebraicNumber<Rational>;
+	Variable x = fresh_real_variable("x");
+	RAN sqrt2 = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-2, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN cbrt3 = RAN::create_safe(UnivariatePolynomial<Rational>(x, {-3, 0, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+
+	sqrt2.refine_to_precision(256);
+	ASSERT_FALSE(sqrt2.is_numeric());
+	EXPECT_TRUE(sqrt2.interval().diameter() <= Rational(1) / carl::pow(Rational(2), 256));
+	EXPECT_TRUE(sqrt2.interval().lower() * sqrt2.interval().lower() < Rational(2));
+	EXPECT_TRUE(sqrt2.interval().upper() * sqrt2.interval().upper() > Rational(2));
+
+	cbrt3.refine_to_precision(100);
+	ASSERT_FALSE(cbrt3.is_numeric());
+	EXPECT_TRUE(cbrt3.interval().diameter() <= Rational(1) / carl::pow(Rational(2), 100));
+	EXPECT_TRUE(carl::pow(cbrt3.interval().lower(), 3) < Rational(3));
+	EXPECT_TRUE(carl::pow(cbrt3.interval().upper(), 3) > Rational(3));
+	EXPECT_EQ(carl::floor(cbrt3), Rational(1));
+	EXPECT_EQ(carl::ceil(cbrt3), Rational(2));
+}
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include <carl-common/memory/Cache.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Item {
+	/// Atomic, as the value of a cached item is changed before it is rehashed.
+	std::atomic<int> value;
+	mutable std::size_t mHash;
+	explicit Item(int v): value(v), mHash(std::hash<int>()(v)) {}
+	std::size_t hash() const { return mHash; }
+	void rehash() const { mHash = std::hash<int>()(value); }
+	bool operator==(const Item& rhs) const { return value == rhs.value; }
+};
+
+using ItemCache = carl::Cache<Item>;
+
+}
+
+TEST(Cache, Basic)
+{
+	ItemCache cache;
+	auto a = cache.cacheAndReg(new Item(1));
+	EXPECT_TRUE(a.second);
+	EXPECT_NE(ItemCache::NO_REF, a.first);
+	auto b = cache.cache(new Item(2));
+	EXPECT_TRUE(b.second);
+	cache.reg(b.first);
+	Item* duplicate = new Item(1);
+	auto c = cache.cacheAndReg(duplicate);
+	EXPECT_FALSE(c.second);
+	delete duplicate;
+	EXPECT_EQ(a.first, c.first);
+	EXPECT_EQ(2u, cache.size());
+	EXPECT_EQ(1, cache.get(a.first).value.load());
+	EXPECT_EQ(2, cache.get(b.first).value.load());
+	cache.strengthenActivity(b.first);
+	cache.dereg(a.first);
+	cache.dereg(b.first);
+	cache.dereg(c.first);
+	EXPECT_EQ(2u, cache.memory_usage().objects);
+}
+
+TEST(Cache, Eviction)
+{
+	ItemCache cache(64, 0.2, 0.98, 4);
+	std::vector<ItemCache::Ref> used;
+	for (int i = 0; i < 100; ++i) {
+		used.push_back(cache.cacheAndReg(new Item(i)).first);
+	}
+	// Used entries are never evicted.
+	EXPECT_EQ(100u, cache.size());
+	for (int i = 1000; i < 2000; ++i) {
+		cache.cache(new Item(i));
+		EXPECT_LE(cache.size(), 100u + 64u);
+	}
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(i, cache.get(used[static_cast<std::size_t>(i)]).value.load());
+		cache.dereg(used[static_cast<std::size_t>(i)]);
+	}
+	// Freed references are reused.
+	EXPECT_LE(cache.memory_usage().id_range, 300u);
+}
+
+TEST(Cache, Rehash)
+{
+	ItemCache cache;
+	auto a = cache.cacheAndReg(new Item(1));
+	Item* item = new Item(2);
+	auto b = cache.cacheAndReg(item);
+	cache.reg(b.first);
+	item->value = 1;
+	cache.rehash(b.first);
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ(&cache.get(a.first), &cache.get(b.first));
+	cache.dereg(a.first);
+	cache.dereg(b.first);
+	cache.dereg(b.first);
+}
+
+TEST(Cache, RehashReclaim)
+{
+	ItemCache cache;
+	auto a = cache.cacheAndReg(new Item(0));
+	std::vector<ItemCache::Ref> refs;
+	for (int i = 1; i <= 100; ++i) {
+		Item* item = new Item(i);
+		refs.push_back(cache.cacheAndReg(item).first);
+		item->value = 0;
+		cache.rehash(refs.back());
+	}
+	EXPECT_EQ(1u, cache.size());
+	// The merged entries are kept while they are used.
+	std::size_t bytes = cache.memory_usage().object_bytes;
+	for (auto ref: refs) {
+		EXPECT_EQ(0, cache.get(ref).value.load());
+		cache.dereg(ref);
+	}
+	cache.dereg(a.first);
+	EXPECT_LT(cache.memory_usage().object_bytes, bytes);
+}
+
+TEST(Cache, ConcurrentRehash)
+{
+	ItemCache cache(64, 0.2, 0.98, 8);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&cache, t]() {
+			for (int i = 0; i < 2000; ++i) {
+				Item* item = new Item(10000 * (static_cast<int>(t) + 1) + i);
+				auto ret = cache.cacheAndReg(item);
+				ASSERT_TRUE(ret.second);
+				item->value = i % 50;
+				cache.rehash(ret.first);
+				EXPECT_EQ(i % 50, cache.get(ret.first).value.load());
+				cache.dereg(ret.first);
+			}
+		});
+	}
+	for (auto& t: threads) t.join();
+	EXPECT_EQ(cache.size(), cache.memory_usage().objects);
+}
+
+TEST(Cache, Concurrent)
+{
+	ItemCache cache(64, 0.2, 0.98, 8);
+	std::vector<std::thread> threads;
+	std::vector<int> failures(8, 0);
+	for (std::size_t t = 0; t < 8; ++t) {
+		threads.emplace_back([&cache, &failures, t]() {
+			for (int i = 0; i < 5000; ++i) {
+				int value = (i * 7 + static_cast<int>(t)) % 300;
+				Item* item = new Item(value);
+				auto ret = cache.cacheAndReg(item);
+				if (!ret.second) delete item;
+				cache.strengthenActivity(ret.first);
+				if (cache.get(ret.first).value.load() != value) ++failures[t];
+				cache.reg(ret.first);
+				cache.dereg(ret.first);
+				cache.dereg(ret.first);
+			}
+		});
+	}
+	for (auto& t: threads) t.join();
+	for (int f: failures) EXPECT_EQ(0, f);
+	EXPECT_LE(cache.size(), 300u);
+	EXPECT_EQ(cache.size(), cache.memory_usage().objects);
+}
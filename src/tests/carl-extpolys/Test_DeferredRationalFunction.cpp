@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include <carl-extpolys/DeferredRationalFunction.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-io/StringParser.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef DeferredRationalFunction<Pol> DRFunc;
+typedef RationalFunction<Pol, true> RFunc;
+typedef FactorPool<Pol> PoolT;
+
+TEST(DeferredRationalFunction, Construction)
+{
+	carl::io::StringParser sp;
+	sp.setVariables({"x", "y"});
+	auto pool = std::make_shared<PoolT>();
+	Pol p1 = sp.parseMultivariatePolynomial<Rational>("6*x*y + 2*x");
+	Pol p2 = sp.parseMultivariatePolynomial<Rational>("5*y + 3*x");
+
+	DRFunc r1(p1, p2, pool);
+	EXPECT_FALSE(r1.is_zero());
+	EXPECT_FALSE(r1.is_constant());
+	EXPECT_EQ(Rational(2), r1.coefficient());
+	EXPECT_EQ(p1, r1.nominator());
+	EXPECT_EQ(p2, r1.denominator());
+
+	DRFunc r2(p1, p1 * Rational(3), pool);
+	EXPECT_TRUE(r2.is_constant());
+	EXPECT_EQ(DRFunc(Rational(1, 3)), r2);
+
+	DRFunc r3(Pol(Rational(0)), p2, pool);
+	EXPECT_TRUE(r3.is_zero());
+	EXPECT_EQ(3u, pool->size());
+}
+
+TEST(DeferredRationalFunction, Arithmetic)
+{
+	carl::io::StringParser sp;
+	sp.setVariables({"x", "y"});
+	Variable x = sp.variables().at("x");
+	Variable y = sp.variables().at("y");
+	auto pool = std::make_shared<PoolT>();
+	Pol a = sp.parseMultivariatePolynomial<Rational>("x + 1");
+	Pol b = sp.parseMultivariatePolynomial<Rational>("x + (-1)");
+	Pol c = sp.parseMultivariatePolynomial<Rational>("x*y + 2");
+	Pol d = sp.parseMultivariatePolynomial<Rational>("y^2 + (-3)");
+
+	DRFunc ra(a, b, pool);
+	DRFunc rb(c, d, pool);
+	RFunc fa(a, b);
+	RFunc fb(c, d);
+
+	std::vector<std::pair<DRFunc, RFunc>> results = {
+		{ ra + rb, fa + fb },
+		{ ra - rb, fa - fb },
+		{ ra * rb, fa * fb },
+		{ ra / rb, fa / fb },
+		{ ra * Rational(3, 4) + Rational(2), fa * Rational(3, 4) + Rational(2) },
+		{ -ra, -fa },
+		{ ra.inverse(), RFunc(b, a) },
+	};
+	std::map<Variable, Rational> values = { { x, Rational(3) }, { y, Rational(-5, 2) } };
+	for (const auto& [deferred, reference]: results) {
+		EXPECT_EQ(reference, deferred.normal_form<true>());
+		EXPECT_EQ(reference.evaluate(values), deferred.evaluate(values));
+	}
+
+	DRFunc zero = ra - ra;
+	EXPECT_TRUE(zero.is_zero());
+	DRFunc one = ra / ra;
+	EXPECT_TRUE(one.is_constant());
+	EXPECT_EQ(DRFunc(Rational(1)), one);
+}
+
+TEST(DeferredRationalFunction, DeferredCancellation)
+{
+	carl::io::StringParser sp;
+	sp.setVariables({"x", "y"});
+	auto pool = std::make_shared<PoolT>();
+	Pol a = sp.parseMultivariatePolynomial<Rational>("x + 1");
+	Pol b = sp.parseMultivariatePolynomial<Rational>("x + (-1)");
+	Pol c = sp.parseMultivariatePolynomial<Rational>("y + 2");
+
+	// (x+1)/(x^2-1) * (y+2)/(x+1) only cancels the identical factor (x+1).
+	DRFunc r = DRFunc(a, a * b, pool) * DRFunc(c, a, pool);
+	EXPECT_EQ(0u, pool->gcd_lookups());
+	EXPECT_EQ(1u, r.nominatorFactors().size());
+	EXPECT_EQ(1u, r.denominatorFactors().size());
+	EXPECT_EQ(c, r.nominator());
+	EXPECT_EQ(a * b, r.denominator());
+
+	// The gcd of (x+1) and (x^2-1) is only computed on request.
+	DRFunc s(a, a * b, pool);
+	EXPECT_EQ(a * b, s.denominator());
+	s.simplify();
+	EXPECT_EQ(Pol(Rational(1)), s.nominator());
+	EXPECT_EQ(b, s.denominator());
+	EXPECT_EQ(1u, pool->gcd_computations());
+
+	// The same pair of factors is not computed again.
+	DRFunc t(a * Rational(2), a * b, pool);
+	t.simplify();
+	EXPECT_EQ(Pol(Rational(2)), t.nominator());
+	EXPECT_EQ(b, t.denominator());
+	EXPECT_EQ(1u, pool->gcd_computations());
+	EXPECT_EQ(2u, pool->gcd_lookups());
+}
+
+TEST(DeferredRationalFunction, Thresholds)
+{
+	carl::io::StringParser sp;
+	sp.setVariables({"x"});
+	DeferredSimplificationSettings settings;
+	settings.max_factors = 2;
+	auto pool = std::make_shared<PoolT>(settings);
+	Pol a = sp.parseMultivariatePolynomial<Rational>("x + 1");
+	Pol b = sp.parseMultivariatePolynomial<Rational>("x + (-1)");
+	Pol c = sp.parseMultivariatePolynomial<Rational>("x + 2");
+
+	// Three distinct factors exceed the threshold and trigger the cancellation of (x+1).
+	DRFunc r = DRFunc(a, c, pool) * DRFunc(Pol(Rational(1)), a * b, pool);
+	EXPECT_EQ(1u, pool->gcd_computations());
+	EXPECT_EQ(Pol(Rational(1)), r.nominator());
+	EXPECT_EQ(b * c, r.denominator());
+
+	// Repeated sums with the same denominators stay small.
+	DRFunc sum(Rational(0));
+	for (int i = 1; i <= 20; ++i) {
+		sum += DRFunc(Pol(Rational(i)), b, pool);
+	}
+	EXPECT_EQ(DRFunc(Pol(Rational(210)), b, pool), sum);
+	EXPECT_EQ(1u, sum.denominatorFactors().size());
+}
@@ -404,3 +404,83 @@ TEST(Formula, Uniqueness)
 	FormulaT f2 = FormulaT(vc);
 	EXPECT_EQ(f1, f2);
 }
+
+TEST(Formula, Compaction)
+{
+    Variable a = fresh_boolean_variable("a");
+    Variable b = fresh_boolean_variable("b");
+    FormulaT fa(a);
+    FormulaT fb(b);
+    {
+        // Temporary formulas leave gaps in the ids.
+        std::vector<FormulaT> tmp;
+        Variable x = fresh_real_variable("x");
+        for (std::size_t i = 0; i < 50; ++i) tmp.emplace_back(Pol(x) - Pol(Rational(i)), Relation::LEQ);
+    }
+    FormulaT f(FormulaType::AND, fa, fb.negated());
+    std::size_t fid = f.id();
+    std::size_t faid = fa.id();
+
+    std::size_t notified = 0;
+    auto& pool = FormulaPool<Pol>::getInstance();
+    auto handle = pool.compaction_listeners().add([&](const IDRemapping& r){ notified = r.new_range(); });
+    IDRemapping remapping = pool.compact();
+    pool.compaction_listeners().remove(handle);
+
+    EXPECT_EQ(remapping.new_range(), notified);
+    EXPECT_LT(f.id(), fid);
+    EXPECT_EQ(f.id(), remapping(fid));
+    EXPECT_EQ(fa.id(), remapping(faid));
+    EXPECT_LT(fa.id(), fb.id());
+    EXPECT_LT(fb.id(), f.id());
+    EXPECT_EQ(fa.id() + 1, fa.negated().id());
+    EXPECT_EQ(1, FormulaT(FormulaType::TRUE).id());
+    EXPECT_EQ(f, FormulaT(FormulaType::AND, fa, fb.negated()));
+    EXPECT_EQ(f.id() + 2, FormulaT(fresh_boolean_variable()).id());
+}
+
+TEST(Formula, Epochs)
+{
+    Variable x = fresh_real_variable("x");
+    auto& pool = FormulaPool<Pol>::getInstance();
+    auto& constraints = ConstraintPool<Pol>::getInstance();
+    std::size_t size = pool.size();
+    std::size_t constraintsSize = constraints.size();
+    FormulaT kept;
+    pool.push_epoch();
+    constraints.push_epoch();
+    for (std::size_t i = 0; i < 10; ++i) {
+        FormulaT f(Pol(x) - Pol(Rational(i)), Relation::LEQ);
+        if (i == 3) kept = f;
+    }
+    // Every formula also creates the negated constraint for its negation.
+    EXPECT_EQ(size + 10, pool.size());
+    EXPECT_EQ(constraintsSize + 20, constraints.size());
+    EXPECT_EQ(9, pool.pop_epoch());
+    EXPECT_EQ(18, constraints.pop_epoch());
+    EXPECT_EQ(size + 1, pool.size());
+    EXPECT_EQ(constraintsSize + 2, constraints.size());
+    EXPECT_EQ(kept, FormulaT(Pol(x) - Pol(Rational(3)), Relation::LEQ));
+    kept = FormulaT();
+    EXPECT_EQ(size, pool.size());
+    EXPECT_EQ(constraintsSize, constraints.size());
+}
+
+TEST(Formula, CreateBatch)
+{
+    Variable a = fresh_boolean_variable("a");
+    Variable b = fresh_boolean_variable("b");
+    Variable c = fresh_boolean_variable("c");
+    std::vector<Formulas<Pol>> batch = {
+        { FormulaT(a), FormulaT(b) },
+        { FormulaT(b).negated(), FormulaT(c) },
+        { FormulaT(c) },
+        { FormulaT(a), FormulaT(a).negated() },
+    };
+    auto formulas = FormulaPool<Pol>::getInstance().create_batch(FormulaType::OR, std::move(batch));
+    ASSERT_EQ(4, formulas.size());
+    EXPECT_EQ(FormulaT(FormulaType::OR, FormulaT(a), FormulaT(b)), formulas[0]);
+    EXPECT_EQ(FormulaT(FormulaType::OR, FormulaT(b).negated(), FormulaT(c)), formulas[1]);
+    EXPECT_EQ(FormulaT(c), formulas[2]);
+    EXPECT_TRUE(formulas[3].is_true());
+}
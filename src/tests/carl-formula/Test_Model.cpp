@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-formula/model/DenseModelMap.h>
 #include <carl-formula/model/Model.h>
 
 #include "../Common.h"
@@ -43,3 +44,42 @@ TYPED_TEST(Model, ModelSubstitution)
 	EXPECT_TRUE(m.at(x).asRational() == TypeParam(3));
 	EXPECT_TRUE(m.at(y).isSubstitution());
 }
+
+TYPED_TEST(Model, DenseModelMap)
+{
+	using Poly = carl::MultivariatePolynomial<TypeParam>;
+	using Value = carl::ModelValue<TypeParam,Poly>;
+
+	carl::Variable x = carl::fresh_real_variable("x");
+	carl::Variable b = carl::fresh_boolean_variable("b");
+	carl::Variable y = carl::fresh_integer_variable("y");
+	carl::Variable u = carl::fresh_uninterpreted_variable("u");
+	carl::DenseModelMap<Value> m;
+	EXPECT_TRUE(m.empty());
+	EXPECT_TRUE(m.emplace(y, TypeParam(2)).second);
+	EXPECT_TRUE(m.emplace(u, true).second);
+	EXPECT_TRUE(m.emplace(x, TypeParam(3)).second);
+	EXPECT_FALSE(m.emplace(x, TypeParam(4)).second);
+	EXPECT_EQ(m.size(), 3);
+	EXPECT_TRUE(m.find(b) == m.end());
+	EXPECT_TRUE(m.at(x).asRational() == TypeParam(3));
+	EXPECT_TRUE(m.at(u).asBool());
+
+	// Arithmetic variables are visited in the order of std::map, other variables afterwards.
+	std::vector<carl::ModelVariable> order;
+	for (const auto& a: m) order.push_back(a.first);
+	ASSERT_EQ(order.size(), 3);
+	EXPECT_EQ(order[0], carl::ModelVariable(std::min(x, y)));
+	EXPECT_EQ(order[1], carl::ModelVariable(std::max(x, y)));
+	EXPECT_EQ(order[2], carl::ModelVariable(u));
+
+	m.find(x)->second = TypeParam(5);
+	EXPECT_TRUE(m.at(x).asRational() == TypeParam(5));
+	EXPECT_EQ(m.erase(x), 1);
+	EXPECT_EQ(m.erase(x), 0);
+	EXPECT_EQ(m.erase(u), 1);
+	EXPECT_EQ(m.size(), 1);
+	EXPECT_TRUE(m.begin()->first == carl::ModelVariable(y));
+	m.clear();
+	EXPECT_TRUE(m.begin() == m.end());
+}
@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+
+#include <carl-io/BinaryReader.h>
+#include <carl-io/BinaryWriter.h>
+
+#include "../Common.h"
+
+#include <cstdio>
+
+#include <unistd.h>
+
+using Pol = carl::MultivariatePolynomial<Rational>;
+using FormulaT = carl::Formula<Pol>;
+using RAN = carl::IntRepRealAlgebraicNumber<Rational>;
+
+TEST(Binary, Polynomials)
+{
+	carl::Variable x = carl::fresh_real_variable("bx");
+	carl::Variable y = carl::fresh_integer_variable("by");
+	Pol p1 = Pol(x) * x * y * Rational(-3, 2) + Pol(y) * Rational("123456789012345678901234567890") - Rational(7);
+	Pol p2 = Pol(Rational(0));
+	carl::UnivariatePolynomial<Rational> u1(x, {Rational(-2), Rational(0), Rational(1, 3)});
+	carl::UnivariatePolynomial<Pol> u2(x, {p1, Pol(y), Pol(Rational(1))});
+
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(p1);
+	writer.write(p2);
+	writer.write(u1);
+	writer.write(u2);
+	writer.write(p1);
+
+	// Reuse the variables, as they would be created freshly otherwise.
+	carl::io::BinaryReader<Pol> reader(writer.data());
+	reader.addVariable(x);
+	reader.addVariable(y);
+	EXPECT_EQ(carl::io::binary::ObjectKind::MultivariatePolynomial, reader.peek());
+	EXPECT_EQ(p1, reader.read<Pol>());
+	EXPECT_EQ(p2, reader.read<Pol>());
+	EXPECT_THROW(reader.read<Pol>(), std::runtime_error);
+	EXPECT_EQ(u1, reader.read<carl::UnivariatePolynomial<Rational>>());
+	EXPECT_EQ(u2, reader.read<carl::UnivariatePolynomial<Pol>>());
+	EXPECT_EQ(p1, reader.read<Pol>());
+	EXPECT_FALSE(reader.hasNext());
+	EXPECT_EQ(2u, reader.variables().size());
+
+	// Terms of the input with equal monomials are merged.
+	Pol::TermsType terms = { carl::Term<Rational>(Rational(1), x, 1), carl::Term<Rational>(Rational(2), x, 1) };
+	carl::io::BinaryWriter<Pol> writer2;
+	writer2.write(Pol(std::move(terms), false, true));
+	carl::io::BinaryReader<Pol> reader2(writer2.data());
+	reader2.addVariable(x);
+	EXPECT_EQ(Pol(x) * Rational(3), reader2.read<Pol>());
+}
+
+TEST(Binary, FreshVariables)
+{
+	carl::Variable x = carl::fresh_real_variable("bfx");
+	carl::Variable b = carl::fresh_boolean_variable("bfb");
+	FormulaT f(carl::FormulaType::OR, FormulaT(b), FormulaT(Pol(x) * x - Rational(2), carl::Relation::LESS));
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(f);
+
+	carl::io::BinaryReader<Pol> reader(writer.data());
+	FormulaT g = reader.read<FormulaT>();
+	ASSERT_EQ(2u, reader.variables().size());
+	carl::Variable x2 = reader.variables()[0] == b ? reader.variables()[1] : reader.variables()[0];
+	EXPECT_NE(x, x2);
+	EXPECT_EQ(carl::VariableType::VT_REAL, x2.type());
+	EXPECT_EQ("bfx", x2.name());
+	EXPECT_EQ(carl::FormulaType::OR, g.type());
+
+	// Distinct variables of the same name stay distinct, also if one of them is registered.
+	carl::Variable y1 = carl::fresh_real_variable("bfy");
+	carl::Variable y2 = carl::fresh_real_variable("bfy");
+	carl::io::BinaryWriter<Pol> writer2;
+	writer2.write(Pol(y1) - y2);
+	carl::io::BinaryReader<Pol> reader2(writer2.data());
+	reader2.addVariable(y1);
+	Pol p = reader2.read<Pol>();
+	ASSERT_EQ(2u, reader2.variables().size());
+	EXPECT_NE(reader2.variables()[0], reader2.variables()[1]);
+	EXPECT_EQ(2u, p.nr_terms());
+}
+
+TEST(Binary, Formulas)
+{
+	carl::Variable x = carl::fresh_real_variable("bgx");
+	carl::Variable y = carl::fresh_real_variable("bgy");
+	carl::Variable b = carl::fresh_boolean_variable("bgb");
+	FormulaT c1(Pol(x) * y - Rational(3, 7), carl::Relation::LESS);
+	FormulaT c2(Pol(x) * x + Pol(y) * Rational(-5), carl::Relation::GEQ);
+	FormulaT shared(carl::FormulaType::OR, c1, FormulaT(b));
+	FormulaT f(carl::FormulaType::AND, shared, FormulaT(carl::FormulaType::IMPLIES, c2, shared));
+	FormulaT g(carl::FormulaType::ITE, FormulaT(b), shared.negated(), FormulaT(carl::FormulaType::XOR, c1, c2));
+
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(f);
+	std::size_t size = writer.data().size();
+	writer.write(shared);
+	// Known nodes are only referenced.
+	EXPECT_EQ(size + 2, writer.data().size());
+	writer.write(g);
+	writer.write(FormulaT(carl::FormulaType::TRUE));
+
+	carl::io::BinaryReader<Pol> reader(writer.data());
+	reader.addVariable(x);
+	reader.addVariable(y);
+	reader.addVariable(b);
+	EXPECT_EQ(f, reader.read<FormulaT>());
+	EXPECT_EQ(shared, reader.read<FormulaT>());
+	EXPECT_EQ(g, reader.read<FormulaT>());
+	EXPECT_EQ(FormulaT(carl::FormulaType::TRUE), reader.read<FormulaT>());
+	EXPECT_FALSE(reader.hasNext());
+}
+
+TEST(Binary, Models)
+{
+	carl::Variable x = carl::fresh_real_variable("bmx");
+	carl::Variable y = carl::fresh_real_variable("bmy");
+	carl::Variable b = carl::fresh_boolean_variable("bmb");
+	RAN sqrt2(carl::UnivariatePolynomial<Rational>(x, {Rational(-2), Rational(0), Rational(1)}), carl::Interval<Rational>(Rational(1), carl::BoundType::STRICT, Rational(2), carl::BoundType::STRICT));
+	carl::Model<Rational, Pol> model;
+	model.emplace(x, Rational(-5, 3));
+	model.emplace(y, RAN(sqrt2));
+	model.emplace(b, true);
+
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(sqrt2);
+	writer.write(RAN(Rational(4)));
+	writer.write(model);
+
+	carl::io::BinaryReader<Pol> reader(writer.data());
+	reader.addVariable(x);
+	reader.addVariable(y);
+	reader.addVariable(b);
+	EXPECT_EQ(sqrt2, reader.read<RAN>());
+	EXPECT_EQ(RAN(Rational(4)), reader.read<RAN>());
+	auto m = reader.read<carl::Model<Rational, Pol>>();
+	ASSERT_EQ(3u, m.size());
+	EXPECT_EQ(Rational(-5, 3), m.evaluated(x).asRational());
+	EXPECT_EQ(sqrt2, m.evaluated(y).asRAN());
+	EXPECT_TRUE(m.evaluated(b).asBool());
+
+	// Nothing of a model with unsupported values is written.
+	carl::Model<Rational, Pol> infinite;
+	infinite.emplace(x, Rational(1));
+	infinite.emplace(y, carl::InfinityValue());
+	carl::io::BinaryWriter<Pol> writer2;
+	std::size_t size = writer2.data().size();
+	EXPECT_THROW(writer2.write(infinite), std::invalid_argument);
+	EXPECT_EQ(size, writer2.data().size());
+	writer2.write(Pol(x));
+	carl::io::BinaryReader<Pol> reader2(writer2.data());
+	reader2.addVariable(x);
+	EXPECT_EQ(Pol(x), reader2.read<Pol>());
+	EXPECT_FALSE(reader2.hasNext());
+}
+
+TEST(Binary, Errors)
+{
+	EXPECT_THROW(carl::io::BinaryReader<Pol>(std::string_view("CARL")), std::runtime_error);
+	EXPECT_THROW(carl::io::BinaryReader<Pol>(std::string_view("NOTCARLBIN")), std::runtime_error);
+
+	carl::Variable x = carl::fresh_real_variable("bex");
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(Pol(x) * Rational("98765432109876543210987654321") + Rational(1));
+	std::string data(writer.data());
+	// Every proper prefix is rejected.
+	for (std::size_t i = carl::io::binary::header_size + 1; i < data.size(); ++i) {
+		carl::io::BinaryReader<Pol> reader(std::string_view(data.data(), i));
+		EXPECT_THROW(reader.read<Pol>(), std::runtime_error);
+	}
+	std::string version = data;
+	version[carl::io::binary::magic.size()] = 0;
+	EXPECT_THROW(carl::io::BinaryReader<Pol>(std::string_view(version)), std::runtime_error);
+}
+
+TEST(Binary, File)
+{
+	carl::Variable x = carl::fresh_real_variable("bfix");
+	carl::Variable y = carl::fresh_real_variable("bfiy");
+	Pol p = Pol(x) * y * Rational("-340282366920938463463374607431768211457") + Pol(y) * Rational(1, 3);
+	FormulaT f(carl::FormulaType::AND, FormulaT(p, carl::Relation::GREATER), FormulaT(Pol(x) - Rational(5, 7), carl::Relation::EQ));
+
+	carl::io::BinaryWriter<Pol> writer;
+	writer.write(p);
+	writer.write(f);
+
+	char filename[] = "/tmp/carl_binaryXXXXXX";
+	int fd = mkstemp(filename);
+	ASSERT_LE(0, fd);
+	close(fd);
+	writer.save(filename);
+
+	carl::io::BinaryReader<Pol> reader{std::string(filename)};
+	reader.addVariable(x);
+	reader.addVariable(y);
+	EXPECT_EQ(p, reader.read<Pol>());
+	EXPECT_EQ(f, reader.read<FormulaT>());
+	EXPECT_FALSE(reader.hasNext());
+	std::remove(filename);
+
+	// Unaligned input is read via a copy of the limbs.
+	std::string unaligned = " " + std::string(writer.data());
+	carl::io::BinaryReader<Pol> reader2(std::string_view(unaligned).substr(1));
+	reader2.addVariable(x);
+	reader2.addVariable(y);
+	EXPECT_EQ(p, reader2.read<Pol>());
+	EXPECT_EQ(f, reader2.read<FormulaT>());
+}
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include "../Common.h"
+
+#include <carl-io/DIMACSImporter.h>
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+using Poly = carl::MultivariatePolynomial<mpq_class>;
+using FormulaT = carl::Formula<Poly>;
+
+namespace {
+/// A temporary file that is removed when it goes out of scope.
+class TemporaryFile {
+	std::string mName = "/tmp/carl_dimacsXXXXXX";
+public:
+	explicit TemporaryFile(const std::string& content) {
+		int fd = mkstemp(mName.data());
+		EXPECT_LE(0, fd);
+		EXPECT_EQ(static_cast<ssize_t>(content.size()), write(fd, content.data(), content.size()));
+		close(fd);
+	}
+	~TemporaryFile() {
+		std::remove(mName.c_str());
+	}
+	const std::string& name() const {
+		return mName;
+	}
+};
+}
+
+TEST(DIMACSImporter, Basic)
+{
+	TemporaryFile file(
+		"c A comment\n"
+		"p cnf 3 3\n"
+		"1 -2 0\n"
+		"2 3\n"
+		" -1 0\n"
+		"-3 0\n"
+		"reset\n"
+		"p cnf 2 1\n"
+		"1 2 0\n"
+	);
+	carl::io::DIMACSImporter<Poly> importer(file.name());
+	ASSERT_TRUE(importer.hasNext());
+	FormulaT f = importer.next();
+	ASSERT_EQ(carl::FormulaType::AND, f.type());
+	EXPECT_EQ(3, f.subformulas().size());
+	EXPECT_EQ(3, f.variables().size());
+	ASSERT_TRUE(importer.hasNext());
+	FormulaT g = importer.next();
+	EXPECT_EQ(carl::FormulaType::OR, g.type());
+	EXPECT_FALSE(importer.hasNext());
+
+	// The variables are shared between the formulas.
+	for (const auto& v: g.variables()) {
+		EXPECT_EQ(1, f.variables().count(v));
+	}
+}
+
+TEST(DIMACSImporter, Parallel)
+{
+	std::string content = "p cnf 1000 100000\n";
+	for (int i = 0; i < 100000; ++i) {
+		content += std::to_string(i % 1000 + 1) + " -" + std::to_string((i * 7) % 1000 + 1) + " " + std::to_string((i * 13) % 1000 + 1) + " 0\n";
+	}
+	TemporaryFile file(content);
+	FormulaT sequential = carl::io::DIMACSImporter<Poly>(file.name()).next();
+	FormulaT parallel = carl::io::DIMACSImporter<Poly>(file.name(), 4).next();
+	ASSERT_EQ(carl::FormulaType::AND, sequential.type());
+	EXPECT_EQ(sequential.subformulas().size(), parallel.subformulas().size());
+	EXPECT_EQ(sequential.variables().size(), parallel.variables().size());
+}
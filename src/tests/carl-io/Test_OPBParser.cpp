@@ -9,6 +9,28 @@ using Poly = carl::MultivariatePolynomial<mpq_class>;
 
 TEST(OPBParser, Basic)
 {
+	auto file = io::parseOPBFile(
+		"* A comment\n"
+		"min: +1 x1 -2 x2 ;\n"
+		"+1 x1 +1 x2 >= 1 ;\n"
+		"* Another comment\n"
+		"3 x1 -1 x_3 = -2;\n"
+	);
+	ASSERT_TRUE(file);
+	ASSERT_EQ(2, file->objective.size());
+	EXPECT_EQ(-2, file->objective[1].first);
+	ASSERT_EQ(2, file->constraints.size());
+	EXPECT_EQ(Relation::GEQ, std::get<1>(file->constraints[0]));
+	EXPECT_EQ(1, std::get<2>(file->constraints[0]));
+	EXPECT_EQ(Relation::EQ, std::get<1>(file->constraints[1]));
+	EXPECT_EQ(-2, std::get<2>(file->constraints[1]));
+	// Variables are identified by their name.
+	EXPECT_EQ(file->objective[0].second, std::get<0>(file->constraints[1])[0].second);
+	EXPECT_EQ("x_3", std::get<0>(file->constraints[1])[1].second.name());
+
+	EXPECT_FALSE(io::parseOPBFile("+1 x1 >= 1"));
+	EXPECT_FALSE(io::parseOPBFile("+1 >= 1;"));
+
 	//io::OPBImporter<Poly> importer("../sep6.5.opb");
 	//importer.parse();
 }
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/core/VariablePool.h>
+#include "carl-formula/formula/Formula.h"
+#include <carl-io/SMTLIBWriter.h>
+
+#include "../Common.h"
+
+#include <cstdio>
+
+using Pol = carl::MultivariatePolynomial<Rational>;
+using FormulaT = carl::Formula<Pol>;
+
+/// Writes the formula with SMTLIBWriter into a memory region.
+static std::string write(const FormulaT& f) {
+	std::vector<char> buffer(1024);
+	carl::io::SMTLIBWriter<Pol> writer(buffer.data(), buffer.size());
+	writer.assertFormula(f);
+	return std::string(buffer.data(), writer.written());
+}
+
+/// Writes the formula with SMTLIBStream.
+static std::string stream(const FormulaT& f) {
+	carl::io::SMTLIBStream sls;
+	sls.assertFormula(f);
+	return sls.str();
+}
+
+TEST(SMTLIBWriter, Numbers)
+{
+	carl::Variable x = carl::fresh_real_variable("wx");
+	carl::Variable y = carl::fresh_real_variable("wy");
+	Rational big("123456789012345678901234567890");
+	std::vector<FormulaT> formulas = {
+		FormulaT(Pol(x) * Rational(-3, 2) + Rational(7), carl::Relation::LESS),
+		FormulaT(Pol(y) * Rational(5, 7) - Rational(1, 3), carl::Relation::NEQ),
+		FormulaT(Pol(x) * x * big - Rational(big * big), carl::Relation::EQ),
+		FormulaT(Pol(y) * Rational(-2) + Pol(x) * x * x, carl::Relation::GEQ),
+	};
+	for (const auto& f: formulas) {
+		EXPECT_EQ(stream(f), write(f));
+	}
+}
+
+TEST(SMTLIBWriter, Sharing)
+{
+	carl::Variable a = carl::fresh_boolean_variable("wa");
+	carl::Variable b = carl::fresh_boolean_variable("wb");
+	carl::Variable c = carl::fresh_boolean_variable("wc");
+	FormulaT ab(carl::FormulaType::OR, FormulaT(a), FormulaT(b));
+	FormulaT f1(carl::FormulaType::AND, ab, FormulaT(carl::FormulaType::IMPLIES, FormulaT(c), ab));
+	FormulaT f2(carl::FormulaType::AND, ab.negated(), FormulaT(c));
+
+	std::vector<char> buffer(1024);
+	carl::io::SMTLIBWriter<Pol> writer(buffer.data(), buffer.size());
+	writer.assertFormula(f1);
+	writer.assertFormula(f2);
+	std::string res(buffer.data(), writer.written());
+	EXPECT_EQ(1, writer.definitions());
+	EXPECT_EQ(
+		"(define-fun _f0 () Bool (or wb wa))\n"
+		"(assert (and _f0 (=> wc _f0)))\n"
+		"(assert (and (not _f0) wc))\n",
+		res
+	);
+}
+
+TEST(SMTLIBWriter, MixedTypes)
+{
+	// Variable ids are only unique per type, create a Boolean and a real variable with the same id.
+	carl::Variable b = carl::fresh_boolean_variable();
+	carl::Variable x = carl::fresh_real_variable();
+	while (b.id() != x.id()) {
+		if (b.id() < x.id()) b = carl::fresh_boolean_variable();
+		else x = carl::fresh_real_variable();
+	}
+	FormulaT f(carl::FormulaType::AND, FormulaT(b), FormulaT(Pol(x) - Rational(1), carl::Relation::GREATER));
+	EXPECT_EQ(stream(f), write(f));
+}
+
+TEST(SMTLIBWriter, Overflow)
+{
+	std::vector<char> buffer(16);
+	carl::Variable x = carl::fresh_real_variable("wv");
+	carl::io::SMTLIBWriter<Pol> writer(buffer.data(), buffer.size());
+	EXPECT_THROW(writer.assertFormula(FormulaT(Pol(x) - Rational(1), carl::Relation::EQ)), std::length_error);
+}
+
+TEST(SMTLIBWriter, FileDescriptor)
+{
+	carl::Variable x = carl::fresh_real_variable("wz");
+	auto script = [x](carl::io::SMTLIBWriter<Pol>& writer) {
+		writer.declare(carl::Logic::QF_LRA);
+		writer.declare(x);
+		for (int i = 0; i < 100; ++i) {
+			writer.assertFormula(FormulaT(Pol(x) - Rational(i), carl::Relation::GEQ));
+		}
+		writer.checkSat();
+	};
+	std::vector<char> buffer(1 << 14);
+	carl::io::SMTLIBWriter<Pol> memory(buffer.data(), buffer.size());
+	script(memory);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(nullptr, file);
+	{
+		// Use a small buffer to write through several flushes.
+		carl::io::SMTLIBWriter<Pol> writer(fileno(file), 64);
+		script(writer);
+		EXPECT_EQ(memory.written(), writer.written());
+	}
+	std::rewind(file);
+	std::string res;
+	char tmp[256];
+	for (std::size_t n; (n = std::fread(tmp, 1, sizeof(tmp), file)) > 0;) res.append(tmp, n);
+	std::fclose(file);
+	EXPECT_EQ(std::string(buffer.data(), memory.written()), res);
+	EXPECT_EQ(0, res.find("(set-logic QF_LRA)\n(declare-fun wz () Real)\n"));
+}
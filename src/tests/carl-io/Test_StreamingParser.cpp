@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/core/VariablePool.h>
+#include <carl-io/SMTLIBWriter.h>
+#include <carl-io/parser/StreamingParser.h>
+
+#include "../Common.h"
+
+#include <cstdio>
+#include <sstream>
+
+#include <unistd.h>
+
+using Pol = carl::MultivariatePolynomial<Rational>;
+using FormulaT = carl::Formula<Pol>;
+
+TEST(StreamingParser, Polynomial)
+{
+	carl::io::parser::StreamingParser<Pol> parser;
+	carl::Variable x = carl::fresh_real_variable("spx");
+	carl::Variable y = carl::fresh_real_variable("spy");
+	parser.addVariable(x);
+	parser.addVariable(y);
+
+	EXPECT_EQ(Pol(Rational(1)), parser.polynomial("1"));
+	EXPECT_EQ(Pol(Rational(2)*x), parser.polynomial("2*spx"));
+	EXPECT_EQ(Pol(x*x), parser.polynomial("spx^2"));
+	EXPECT_EQ(Pol(x*y), parser.polynomial("spx * spy"));
+	EXPECT_EQ(Pol(x*x*y), parser.polynomial("spx*spy*spx"));
+	EXPECT_EQ(Pol(-Pol(x) + Rational(1, 2)), parser.polynomial("-spx + 0.5"));
+	EXPECT_EQ(Pol(Rational(3)*x*x*y - (Pol(x) + Rational(1)) * (Pol(x) + Rational(1))), parser.polynomial("3*spx^2*spy - (spx+1)^2"));
+	EXPECT_EQ(Pol(Rational(0)), parser.polynomial("spx - spx"));
+	EXPECT_EQ(Pol(Rational("123456789012345678901234567890")), parser.polynomial("123456789012345678901234567890"));
+	EXPECT_EQ(Pol(Rational(1, 8)), parser.polynomial("0.125"));
+
+	Pol p = Pol(x) * x * Rational(-3, 2) + Pol(y) * Rational(5) - Rational(7);
+	std::stringstream ss;
+	ss << p;
+	EXPECT_EQ(p, parser.polynomial(ss.str()));
+
+	Pol z = parser.polynomial("spz + 1");
+	EXPECT_EQ(1u, carl::variables(z).size());
+	EXPECT_EQ(Pol(Rational(2)) * z, parser.polynomial("2*spz + 2"));
+
+	EXPECT_THROW(parser.polynomial("spx +"), std::runtime_error);
+	EXPECT_THROW(parser.polynomial("(spx"), std::runtime_error);
+}
+
+TEST(StreamingParser, Script)
+{
+	carl::io::parser::StreamingParser<Pol> parser;
+	carl::Variable a = carl::fresh_real_variable("a");
+	carl::Variable b = carl::fresh_real_variable("b");
+	carl::Variable p = carl::fresh_boolean_variable("p");
+	// Declarations reuse known variables of the same type.
+	parser.addVariable(a);
+	parser.addVariable(b);
+	parser.addVariable(p);
+	auto assertions = parser.script(R"(
+		; A comment
+		(set-info :source |multi
+			line|)
+		(set-logic QF_NRA)
+		(declare-fun a () Real)
+		(declare-const b Real)
+		(declare-fun p () Bool)
+		(define-fun sq () Real (* a a))
+		(assert (<= (+ sq (* (- 3) b)) (/ 1 2)))
+		(assert (let ((s (+ a b)) (q p)) (or q (not (= s 0)))))
+		(assert (=> p (> a b 0)))
+		(check-sat)
+		(exit)
+	)");
+	ASSERT_EQ(3u, assertions.size());
+
+	EXPECT_EQ(FormulaT(Pol(a) * a - Pol(b) * Rational(3) - Rational(1, 2), carl::Relation::LEQ), assertions[0]);
+	EXPECT_EQ(FormulaT(carl::FormulaType::OR, FormulaT(p), FormulaT(Pol(a) + b, carl::Relation::EQ).negated()), assertions[1]);
+	EXPECT_EQ(FormulaT(carl::FormulaType::IMPLIES, FormulaT(p), FormulaT(carl::FormulaType::AND, FormulaT(Pol(a) - b, carl::Relation::GREATER), FormulaT(Pol(b), carl::Relation::GREATER))), assertions[2]);
+}
+
+TEST(StreamingParser, Distinct)
+{
+	carl::io::parser::StreamingParser<Pol> parser;
+	carl::Variable a = carl::fresh_real_variable("da");
+	carl::Variable b = carl::fresh_real_variable("db");
+	carl::Variable c = carl::fresh_real_variable("dc");
+	carl::Variable p = carl::fresh_boolean_variable("dp");
+	carl::Variable q = carl::fresh_boolean_variable("dq");
+	carl::Variable r = carl::fresh_boolean_variable("dr");
+	for (auto v: {a, b, c, p, q, r}) parser.addVariable(v);
+	auto assertions = parser.script(R"(
+		(declare-fun da () Real)
+		(declare-fun db () Real)
+		(declare-fun dc () Real)
+		(declare-fun dp () Bool)
+		(declare-fun dq () Bool)
+		(declare-fun dr () Bool)
+		(assert (distinct da db dc))
+		(assert (distinct dp dq))
+		(assert (distinct dp dq dr))
+	)");
+	ASSERT_EQ(3u, assertions.size());
+	// The arguments are pairwise distinct.
+	EXPECT_EQ(FormulaT(carl::FormulaType::AND, {
+		FormulaT(Pol(a) - b, carl::Relation::NEQ),
+		FormulaT(Pol(a) - c, carl::Relation::NEQ),
+		FormulaT(Pol(b) - c, carl::Relation::NEQ)
+	}), assertions[0]);
+	EXPECT_EQ(FormulaT(carl::FormulaType::XOR, FormulaT(p), FormulaT(q)), assertions[1]);
+	EXPECT_EQ(FormulaT(carl::FormulaType::FALSE), assertions[2]);
+}
+
+TEST(StreamingParser, Errors)
+{
+	carl::io::parser::StreamingParser<Pol> parser;
+	try {
+		parser.script("(declare-fun c () Real)\n(assert (<= c d))");
+		FAIL() << "Expected an exception";
+	} catch (const std::runtime_error& e) {
+		EXPECT_EQ(std::string("Parse error at 2:16: undeclared symbol d"), e.what());
+	}
+	EXPECT_THROW(parser.script("(assert (+ c 1))"), std::runtime_error);
+	EXPECT_THROW(parser.script("(assert (<= c 1)"), std::runtime_error);
+	EXPECT_THROW(parser.polynomial("c^99999999999999999999"), std::runtime_error);
+
+	// The bindings of a let whose body fails to parse do not leak into later input.
+	EXPECT_THROW(parser.script("(assert (let ((c true)) (<= c x)))"), std::runtime_error);
+	EXPECT_EQ(1u, parser.script("(assert (<= c 1))").size());
+}
+
+TEST(StreamingParser, RoundTrip)
+{
+	carl::Variable x = carl::fresh_real_variable("rtx");
+	carl::Variable y = carl::fresh_real_variable("rty");
+	carl::Variable b = carl::fresh_boolean_variable("rtb");
+	FormulaT c1(Pol(x) * y - Rational(3, 7), carl::Relation::LESS);
+	FormulaT c2(Pol(x) * x + Pol(y) * Rational(-5), carl::Relation::GEQ);
+	FormulaT shared(carl::FormulaType::OR, c1, FormulaT(b));
+	FormulaT f(carl::FormulaType::AND, shared, FormulaT(carl::FormulaType::IMPLIES, c2, shared));
+
+	char filename[] = "/tmp/carl_streaming_parserXXXXXX";
+	int fd = mkstemp(filename);
+	ASSERT_LE(0, fd);
+	{
+		carl::io::SMTLIBWriter<Pol> writer(fd);
+		writer.initialize(carl::Logic::QF_NRA, carl::carlVariables({x, y, b}));
+		writer.assertFormula(f);
+		writer.assertFormula(shared.negated());
+		writer.checkSat();
+	}
+	close(fd);
+
+	carl::io::parser::StreamingParser<Pol> parser;
+	parser.addVariable(x);
+	parser.addVariable(y);
+	parser.addVariable(b);
+	auto assertions = parser.script_file(filename);
+	std::remove(filename);
+	ASSERT_EQ(2u, assertions.size());
+	EXPECT_EQ(f, assertions[0]);
+	EXPECT_EQ(shared.negated(), assertions[1]);
+}
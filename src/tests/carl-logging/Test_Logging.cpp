@@ -6,7 +6,12 @@
 
 #include "../get_output.h"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 TEST(Logging, LogLevelOutput)
 {
@@ -27,6 +32,114 @@ TEST(Logging, StreamSink)
 	EXPECT_EQ(ss.rdbuf(), sink.log().rdbuf());
 }
 
+TEST(Logging, AsyncSink)
+{
+	std::stringstream ss;
+	{
+		carl::logging::AsyncSink sink(std::make_shared<carl::logging::StreamSink>(ss), 1024, carl::logging::OverflowPolicy::Block);
+		auto formatter = std::make_shared<carl::logging::Formatter>();
+		formatter->printInformation = false;
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < 4; ++t) {
+			threads.emplace_back([&sink,&formatter](){
+				for (std::size_t i = 0; i < 1000; ++i) {
+					sink.push({ carl::logging::LogLevel::LVL_INFO, "carl", "message", {"file", "func", 0}, formatter });
+				}
+				sink.flush();
+			});
+		}
+		for (auto& t: threads) t.join();
+		EXPECT_EQ(sink.dropped(), 0);
+	}
+	std::size_t lines = 0;
+	std::string line;
+	while (std::getline(ss, line)) {
+		EXPECT_EQ(line, "message");
+		++lines;
+	}
+	EXPECT_EQ(lines, 4000);
+}
+
+TEST(Logging, AsyncSinkDrop)
+{
+	std::stringstream ss;
+	carl::logging::AsyncSink sink(std::make_shared<carl::logging::StreamSink>(ss), 2, carl::logging::OverflowPolicy::Drop, std::chrono::milliseconds(100));
+	auto formatter = std::make_shared<carl::logging::Formatter>();
+	for (std::size_t i = 0; i < 100; ++i) {
+		sink.push({ carl::logging::LogLevel::LVL_INFO, "carl", "message", {"file", "func", 0}, formatter });
+	}
+	EXPECT_GT(sink.dropped(), 0);
+}
+
+TEST(Logging, AsyncSinkBlock)
+{
+	std::stringstream ss;
+	{
+		carl::logging::AsyncSink sink(std::make_shared<carl::logging::StreamSink>(ss), 2, carl::logging::OverflowPolicy::Block, std::chrono::milliseconds(1));
+		auto formatter = std::make_shared<carl::logging::Formatter>();
+		formatter->printInformation = false;
+		for (std::size_t i = 0; i < 100; ++i) {
+			sink.push({ carl::logging::LogLevel::LVL_INFO, "carl", "message", {"file", "func", 0}, formatter });
+		}
+		sink.flush();
+		EXPECT_EQ(sink.dropped(), 0);
+	}
+	std::size_t lines = 0;
+	std::string line;
+	while (std::getline(ss, line)) ++lines;
+	EXPECT_EQ(lines, 100);
+}
+
+namespace {
+	/// Stream buffer that blocks all output until it is released.
+	struct BlockingBuffer: std::streambuf {
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool entered = false;
+		bool released = false;
+		int_type overflow(int_type c) override {
+			std::unique_lock<std::mutex> lock(mutex);
+			entered = true;
+			cv.notify_all();
+			cv.wait(lock, [this](){ return released; });
+			return traits_type::not_eof(c);
+		}
+		std::streamsize xsputn(const char*, std::streamsize n) override {
+			overflow(0);
+			return n;
+		}
+	};
+}
+
+TEST(Logging, AsyncSinkBlockStopped)
+{
+	BlockingBuffer buffer;
+	std::ostream os(&buffer);
+	auto* sink = new carl::logging::AsyncSink(std::make_shared<carl::logging::StreamSink>(os), 2, carl::logging::OverflowPolicy::Block, std::chrono::milliseconds(1));
+	auto formatter = std::make_shared<carl::logging::Formatter>();
+	std::size_t dropped = 0;
+	std::thread producer([&](){
+		for (std::size_t i = 0; i < 100; ++i) {
+			if (!sink->push({ carl::logging::LogLevel::LVL_INFO, "carl", "message", {"file", "func", 0}, formatter })) ++dropped;
+		}
+	});
+	{
+		std::unique_lock<std::mutex> lock(buffer.mutex);
+		buffer.cv.wait(lock, [&buffer](){ return buffer.entered; });
+	}
+	// The writer is stuck and the producer waits for room, until the sink is stopped.
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	std::thread destroyer([sink](){ delete sink; });
+	producer.join();
+	EXPECT_GT(dropped, 0);
+	{
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+		buffer.released = true;
+	}
+	buffer.cv.notify_all();
+	destroyer.join();
+}
+
 TEST(Logging, Filter)
 {
 	carl::logging::Filter filter;
@@ -54,3 +167,53 @@ TEST(LoggingHelper, basename)
 {
 	EXPECT_EQ("abc.de", carl::basename("/foo/bar/abc.de"));
 }
+
+TEST(Logging, ChannelLevels)
+{
+	std::size_t id = __CARL_LOG_CHANNEL("carl.test.channel");
+	EXPECT_EQ(id, carl::logging::register_channel("carl.test.channel"));
+	EXPECT_NE(id, carl::logging::register_channel("carl.test"));
+
+	std::stringstream ss;
+	carl::logging::logger().configure("channeltest", ss);
+	carl::logging::logger().filter("channeltest")
+		("carl.test", carl::logging::LogLevel::LVL_INFO)
+	;
+	EXPECT_FALSE(carl::logging::visible(carl::logging::LogLevel::LVL_DEBUG, id));
+	EXPECT_TRUE(carl::logging::visible(carl::logging::LogLevel::LVL_INFO, id));
+	__CARL_LOG_DEBUG("carl.test.channel", "hidden");
+	__CARL_LOG_INFO("carl.test.channel", "shown");
+	EXPECT_EQ(ss.str().find("hidden"), std::string::npos);
+	EXPECT_NE(ss.str().find("shown"), std::string::npos);
+
+	carl::logging::logger().filter("channeltest")
+		("carl.test.channel", carl::logging::LogLevel::LVL_DEBUG)
+	;
+	EXPECT_TRUE(carl::logging::visible(carl::logging::LogLevel::LVL_DEBUG, id));
+	EXPECT_EQ(carl::logging::visible(carl::logging::LogLevel::LVL_DEBUG, id), carl::logging::logger().visible(carl::logging::LogLevel::LVL_DEBUG, "carl.test.channel"));
+}
+
+TEST(Logging, ConcurrentConfiguration)
+{
+	std::stringstream ss;
+	carl::logging::logger().configure("concurrenttest", std::make_shared<carl::logging::AsyncSink>(std::make_shared<carl::logging::StreamSink>(ss)));
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < 4; ++t) {
+		threads.emplace_back([](){
+			for (std::size_t i = 0; i < 1000; ++i) {
+				__CARL_LOG_INFO("concurrenttest.channel", "message");
+			}
+		});
+	}
+	for (std::size_t i = 0; i < 100; ++i) {
+		carl::logging::logger().filter("concurrenttest")
+			("concurrenttest.channel", i % 2 == 0 ? carl::logging::LogLevel::LVL_INFO : carl::logging::LogLevel::LVL_WARN)
+		;
+		if (i % 10 == 0) carl::logging::logger().formatter("concurrenttest", std::make_shared<carl::logging::Formatter>());
+		carl::logging::logger().formatter("concurrenttest")->printInformation = i % 2 == 0;
+		carl::logging::logger().resetFormatter();
+	}
+	for (auto& t: threads) t.join();
+	carl::logging::logger().configure("concurrenttest", std::make_shared<carl::logging::StreamSink>(ss));
+	carl::logging::logger().filter("concurrenttest")("", carl::logging::LogLevel::LVL_OFF);
+}
@@ -1,10 +1,16 @@
 #include "../get_output.h"
 
+#include <carl-statistics/Profiler.h>
 #include <carl-statistics/Statistics.h>
+#include <carl-statistics/StatisticsPrinter.h>
+#include <carl-statistics/StatisticsSnapshotter.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <sstream>
 #include <thread>
+#include <vector>
 
 TEST(Statistics, Timer)
 {
@@ -14,3 +20,223 @@ TEST(Statistics, Timer)
 	timer.finish(start);
 	ASSERT_EQ(timer.count(), 1);
 }
+
+TEST(Statistics, TimerNanoseconds)
+{
+	carl::statistics::Timer timer;
+	{
+		carl::statistics::ScopeTimer scope(timer);
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	EXPECT_EQ(timer.count(), 1);
+	EXPECT_GE(timer.overall_ns(), 100000);
+}
+
+TEST(Statistics, Histogram)
+{
+	carl::statistics::Histogram h;
+	for (std::uint64_t i = 1; i <= 10000; ++i) {
+		h.add(i);
+	}
+	EXPECT_EQ(h.count(), 10000);
+	EXPECT_EQ(h.min(), 1);
+	EXPECT_EQ(h.max(), 10000);
+	for (double p: {0.1, 0.5, 0.9, 0.99}) {
+		double expected = p * 10000;
+		EXPECT_NEAR(static_cast<double>(h.percentile(p)), expected, expected / 32);
+	}
+	EXPECT_EQ(h.percentile(1), 10000);
+
+	carl::statistics::Histogram h2;
+	h2.add(100000);
+	h.merge(h2);
+	EXPECT_EQ(h.count(), 10001);
+	EXPECT_EQ(h.max(), 100000);
+
+	carl::statistics::Histogram h3;
+	for (std::uint64_t i = 1; i <= 3; ++i) {
+		h3.add(i);
+	}
+	EXPECT_EQ(h3.percentile(0), 1);
+	EXPECT_EQ(h3.percentile(0.3), 1);
+	EXPECT_EQ(h3.percentile(0.5), 2);
+	EXPECT_EQ(h3.percentile(0.9), 3);
+	EXPECT_EQ(h3.percentile(1), 3);
+}
+
+TEST(Statistics, Sharded)
+{
+	carl::statistics::Sharded<carl::statistics::Histogram> h;
+	std::vector<std::thread> threads;
+	for (std::uint64_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&h,t](){
+			for (std::uint64_t i = 0; i < 1000; ++i) {
+				h.add(t * 1000 + i);
+			}
+		});
+	}
+	for (auto& t: threads) t.join();
+	auto merged = h.merged();
+	EXPECT_EQ(merged.count(), 4000);
+	EXPECT_EQ(merged.min(), 0);
+	EXPECT_EQ(merged.max(), 3999);
+
+	std::map<std::string, carl::statistics::Value> data;
+	h.collect(data, "h");
+	EXPECT_EQ(data["h.count"], carl::statistics::Value(std::size_t(4000)));
+	EXPECT_TRUE(data.find("h.p99") != data.end());
+
+	// Ids of destroyed objects are reused, a new object does not see the shards of an old one.
+	std::size_t largest = carl::statistics::detail::shard_ids().pool.largestID();
+	for (std::uint64_t i = 0; i < 1000; ++i) {
+		carl::statistics::Sharded<carl::statistics::Histogram> tmp;
+		EXPECT_EQ(tmp.merged().count(), 0);
+		tmp.add(i);
+		EXPECT_EQ(tmp.merged().count(), 1);
+	}
+	EXPECT_LE(carl::statistics::detail::shard_ids().pool.largestID(), largest + 1);
+}
+
+class ExportStatistics : public carl::statistics::Statistics {
+public:
+	std::size_t calls = 0;
+	double ratio = 0.5;
+	carl::statistics::Series sizes;
+	void collect() override {
+		addKeyValuePair("calls", calls);
+		addKeyValuePair("ratio", ratio);
+		addKeyValuePair("mode", std::string("fast"));
+		addKeyValuePair("sizes", sizes);
+	}
+};
+
+TEST(Statistics, Export)
+{
+	auto& stats = carl::statistics::get<ExportStatistics>("export");
+	stats.calls = 3;
+	stats.sizes.add(4);
+	carl::statistics::StatisticsCollector::getInstance().collect();
+
+	std::stringstream json;
+	json << carl::statistics::statistics_as_json();
+	EXPECT_NE(json.str().find("\"export\": {"), std::string::npos);
+	EXPECT_NE(json.str().find("\"calls\": 3"), std::string::npos);
+	EXPECT_NE(json.str().find("\"ratio\": 0.5"), std::string::npos);
+	EXPECT_NE(json.str().find("\"mode\": \"fast\""), std::string::npos);
+	EXPECT_NE(json.str().find("\"sizes.max\": 4"), std::string::npos);
+
+	std::stringstream csv;
+	csv << carl::statistics::statistics_as_csv();
+	EXPECT_NE(csv.str().find("export,calls,3\n"), std::string::npos);
+	EXPECT_NE(csv.str().find("export,mode,fast\n"), std::string::npos);
+
+	stats.sizes.add(5);
+	carl::statistics::StatisticsCollector::getInstance().collect();
+	auto collected = stats.collected();
+	EXPECT_EQ("3", collected["calls"]);
+	EXPECT_EQ("fast", collected["mode"]);
+	EXPECT_EQ("4.5", collected["sizes.avg"]);
+	EXPECT_EQ(4.5, std::get<double>(stats.collected_values().at("sizes.avg").value()));
+}
+
+TEST(Statistics, Snapshotter)
+{
+	auto& stats = carl::statistics::get<ExportStatistics>("snapshot");
+	std::stringstream ss;
+	{
+		carl::statistics::StatisticsSnapshotter snapshotter(ss, std::chrono::hours(1));
+		stats.calls = 5;
+		snapshotter.snapshot();
+		stats.calls = 7;
+	}
+	std::string first, last;
+	std::getline(ss, first);
+	std::getline(ss, last);
+	EXPECT_NE(first.find("\"snapshot\": {\"calls\": 5"), std::string::npos);
+	EXPECT_NE(last.find("\"snapshot\": {\"calls\": 2}"), std::string::npos);
+}
+
+class ConcurrentStatistics : public carl::statistics::Statistics {
+public:
+	carl::statistics::Sharded<carl::statistics::Histogram> times;
+	bool collect_concurrently() const override {
+		return true;
+	}
+	void collect() override {
+		addKeyValuePair("times", times);
+	}
+};
+
+TEST(Statistics, BackgroundSnapshots)
+{
+	auto& stats = carl::statistics::get<ConcurrentStatistics>("background");
+	auto& plain = carl::statistics::get<ExportStatistics>("plain");
+	std::stringstream ss;
+	{
+		carl::statistics::StatisticsSnapshotter snapshotter(ss, std::chrono::milliseconds(1));
+		std::thread worker([&stats](){
+			for (std::uint64_t i = 0; i < 20000; ++i) stats.times.add(i);
+		});
+		worker.join();
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		plain.calls = 1;
+	}
+	// Only the last snapshot upon destruction collects statistics that can not be collected concurrently.
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(ss, line);) lines.push_back(line);
+	ASSERT_LE(2u, lines.size());
+	for (std::size_t i = 0; i + 1 < lines.size(); ++i) {
+		EXPECT_EQ(lines[i].find("\"plain\""), std::string::npos);
+	}
+	EXPECT_NE(lines.front().find("\"background\": {"), std::string::npos);
+	EXPECT_NE(lines.back().find("\"plain\": {\"calls\": 1"), std::string::npos);
+	EXPECT_TRUE(stats.collected().empty());
+}
+
+class ProfiledStatistics : public carl::statistics::Statistics {
+public:
+	void collect() override {
+		carl::statistics::ProfilerScope scope(carl::statistics::Profiler::getInstance().zone("test.collect"));
+		addKeyValuePair("collected", true);
+	}
+};
+
+TEST(Statistics, ProfilerInCollect)
+{
+	// The profiler registers its statistics during static initialization, not when code within collect() is profiled.
+	const auto& statistics = carl::statistics::StatisticsCollector::getInstance().statistics();
+	EXPECT_TRUE(std::any_of(statistics.begin(), statistics.end(), [](const auto& s){ return s->name() == "profiler"; }));
+	auto& stats = carl::statistics::get<ProfiledStatistics>("profiled");
+	carl::statistics::StatisticsCollector::getInstance().collect();
+	EXPECT_EQ("1", stats.collected()["collected"]);
+}
+
+TEST(Statistics, Profiler)
+{
+	auto& profiler = carl::statistics::Profiler::getInstance();
+	auto& zone = profiler.zone("test.zone");
+	EXPECT_EQ(&zone, &profiler.zone("test.zone"));
+	{
+		carl::statistics::ProfilerScope scope(zone);
+	}
+	EXPECT_EQ(zone.times.merged().count(), 1);
+
+	profiler.set_tracing(true);
+	{
+		carl::statistics::ProfilerScope scope(zone);
+	}
+	profiler.set_tracing(false);
+	EXPECT_EQ(zone.times.merged().count(), 2);
+
+	std::stringstream ss;
+	profiler.write_trace(ss);
+	EXPECT_EQ(ss.str().find("{\"traceEvents\": ["), 0);
+	EXPECT_NE(ss.str().find("\"name\": \"test.zone\""), std::string::npos);
+	EXPECT_NE(ss.str().find("\"ph\": \"X\""), std::string::npos);
+
+	carl::statistics::StatisticsCollector::getInstance().collect();
+	std::stringstream json;
+	json << carl::statistics::statistics_as_json();
+	EXPECT_NE(json.str().find("\"test.zone.count\": 2"), std::string::npos);
+}
+
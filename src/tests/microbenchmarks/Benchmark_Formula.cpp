@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/functions/CNF.h>
+#include <carl-io/parser/Parser.h>
+#include <carl-io/parser/StreamingParser.h>
+
+#include <sstream>
+
+using namespace benchmark_generators;
+using Formula = carl::Formula<MVP>;
+
+/// A random formula of the given depth over the given number of Boolean variables, using AND, OR, IFF and XOR.
+static Formula random_formula(std::mt19937_64& rng, std::size_t depth, const std::vector<carl::Variable>& vars) {
+	if (depth == 0) {
+		std::uniform_int_distribution<std::size_t> var(0, vars.size() - 1);
+		Formula res(vars[var(rng)]);
+		return rng() % 2 ? res : res.negated();
+	}
+	static const carl::FormulaType types[] = { carl::FormulaType::AND, carl::FormulaType::OR, carl::FormulaType::IFF, carl::FormulaType::XOR };
+	auto type = types[rng() % 4];
+	return Formula(type, random_formula(rng, depth - 1, vars), random_formula(rng, depth - 1, vars));
+}
+
+static std::vector<carl::Variable> bool_variables(std::size_t n) {
+	static std::vector<carl::Variable> vars;
+	while (vars.size() < n) {
+		vars.push_back(carl::fresh_boolean_variable("bb" + std::to_string(vars.size())));
+	}
+	return std::vector<carl::Variable>(vars.begin(), vars.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+static void Formula_ToCNF(benchmark::State& state) {
+	std::mt19937_64 rng(0);
+	auto f = random_formula(rng, state.range(0), bool_variables(state.range(1)));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::to_cnf(f));
+	}
+}
+BENCHMARK(Formula_ToCNF)->ArgNames({"depth", "vars"})->ArgsProduct({{3, 4, 5}, {4, 16}});
+
+static void Parser_Polynomial(benchmark::State& state) {
+	Generator g;
+	std::stringstream ss;
+	ss << g.polynomial(state.range(0), state.range(1), state.range(2));
+	std::string input = ss.str();
+	carl::io::parser::Parser<MVP> parser;
+	for (auto v: variables(state.range(1))) parser.addVariable(v);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parser.polynomial(input));
+	}
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(Parser_Polynomial)->ArgNames({"degree", "vars", "bits"})->ArgsProduct({{2, 4}, {1, 3, 6}, {8, 64}});
+
+static void Parser_PolynomialStreaming(benchmark::State& state) {
+	Generator g;
+	std::stringstream ss;
+	ss << g.polynomial(state.range(0), state.range(1), state.range(2));
+	std::string input = ss.str();
+	carl::io::parser::StreamingParser<MVP> parser;
+	for (auto v: variables(state.range(1))) parser.addVariable(v);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parser.polynomial(input));
+	}
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(Parser_PolynomialStreaming)->ArgNames({"degree", "vars", "bits"})->ArgsProduct({{2, 4}, {1, 3, 6}, {8, 64}});
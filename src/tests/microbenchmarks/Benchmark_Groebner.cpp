@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-arith/groebner/GBProcedure.h>
+#include <carl-arith/groebner/groebner.h>
+
+using namespace benchmark_generators;
+
+/// The cyclic-n system, a classical benchmark for Gröbner bases.
+static std::vector<MVP> cyclic(std::size_t n) {
+	auto vars = variables(n);
+	std::vector<MVP> res;
+	for (std::size_t len = 1; len < n; ++len) {
+		MVP sum;
+		for (std::size_t start = 0; start < n; ++start) {
+			MVP prod(1);
+			for (std::size_t i = 0; i < len; ++i) {
+				prod *= vars[(start + i) % n];
+			}
+			sum += prod;
+		}
+		res.push_back(sum);
+	}
+	MVP prod(1);
+	for (auto v: vars) prod *= v;
+	res.push_back(prod - MVP(1));
+	return res;
+}
+
+static void GB_Cyclic(benchmark::State& state) {
+	auto system = cyclic(state.range(0));
+	for (auto _ : state) {
+		carl::GBProcedure<MVP, carl::Buchberger, carl::StdAdding> gb;
+		for (const auto& p: system) gb.addPolynomial(p);
+		gb.reduceInput();
+		gb.calculate();
+		benchmark::DoNotOptimize(gb.getIdeal().nrGenerators());
+	}
+}
+BENCHMARK(GB_Cyclic)->ArgName("n")->DenseRange(2, 4);
+
+static void GB_Random(benchmark::State& state) {
+	Generator g;
+	std::vector<MVP> system;
+	for (std::int64_t i = 0; i < state.range(1); ++i) {
+		system.push_back(g.polynomial(state.range(0), state.range(1), 8));
+	}
+	for (auto _ : state) {
+		carl::GBProcedure<MVP, carl::Buchberger, carl::StdAdding> gb;
+		for (const auto& p: system) gb.addPolynomial(p);
+		gb.reduceInput();
+		gb.calculate();
+		benchmark::DoNotOptimize(gb.getIdeal().nrGenerators());
+	}
+}
+BENCHMARK(GB_Random)->ArgNames({"degree", "vars"})->ArgsProduct({{2}, {2, 3}});
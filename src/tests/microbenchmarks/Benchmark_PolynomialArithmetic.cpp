@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-arith/poly/umvpoly/functions/Division.h>
+#include <carl-arith/poly/umvpoly/functions/Factorization.h>
+#include <carl-arith/poly/umvpoly/functions/Factorization_univariate.h>
+#include <carl-arith/poly/umvpoly/functions/GCD.h>
+
+using namespace benchmark_generators;
+
+/*
+ * The benchmarks in this file are parameterized by
+ * - the total degree,
+ * - the number of variables and
+ * - the number of bits of the coefficients.
+ */
+static void shape_args(benchmark::internal::Benchmark* b) {
+	b->ArgNames({"degree", "vars", "bits"});
+	b->ArgsProduct({{2, 4, 8}, {1, 3, 6}, {8, 64}});
+}
+
+static void MVP_Multiply(benchmark::State& state) {
+	Generator g;
+	auto p = g.polynomial(state.range(0), state.range(1), state.range(2));
+	auto q = g.polynomial(state.range(0), state.range(1), state.range(2));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(p * q);
+	}
+}
+BENCHMARK(MVP_Multiply)->Apply(shape_args);
+
+static void MVP_Divide(benchmark::State& state) {
+	Generator g;
+	auto p = g.polynomial(state.range(0), state.range(1), state.range(2));
+	auto q = g.polynomial(state.range(0), state.range(1), state.range(2));
+	auto pq = p * q;
+	MVP res;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::try_divide(pq, q, res));
+	}
+}
+BENCHMARK(MVP_Divide)->Apply(shape_args);
+
+static void MVP_GCD(benchmark::State& state) {
+	Generator g;
+	auto c = g.polynomial(state.range(0), state.range(1), state.range(2));
+	auto p = g.polynomial(state.range(0), state.range(1), state.range(2)) * c;
+	auto q = g.polynomial(state.range(0), state.range(1), state.range(2)) * c;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::gcd(p, q));
+	}
+}
+BENCHMARK(MVP_GCD)->ArgNames({"degree", "vars", "bits"})->ArgsProduct({{1, 2, 3}, {1, 2, 3}, {8, 64}});
+
+static void MVP_Factorization(benchmark::State& state) {
+	Generator g;
+	MVP p(1);
+	for (std::int64_t i = 0; i < state.range(0); ++i) {
+		p *= g.polynomial(2, state.range(1), state.range(2));
+	}
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::factorization(p));
+	}
+}
+BENCHMARK(MVP_Factorization)->ArgNames({"factors", "vars", "bits"})->ArgsProduct({{2, 3}, {1, 2}, {8, 64}});
+
+static void UP_Factorization(benchmark::State& state) {
+	Generator g;
+	UP p = g.univariate(state.range(0), state.range(1)) * g.univariate(state.range(0), state.range(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::factorization(p));
+	}
+}
+BENCHMARK(UP_Factorization)->ArgNames({"degree", "bits"})->ArgsProduct({{2, 4, 6}, {8, 64}});
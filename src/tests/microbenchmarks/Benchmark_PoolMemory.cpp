@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-arith/poly/umvpoly/MonomialPool.h>
+#include <carl-extpolys/FactorizedPolynomial.h>
+#include <carl-formula/arithmetic/Constraint.h>
+#include <carl-formula/bitvector/BVTerm.h>
+#include <carl-formula/bitvector/BVTermContent.h>
+#include <carl-formula/bitvector/BVTermPool.h>
+#include <carl-formula/formula/Formula.h>
+
+/**
+ * Memory footprint of the pools and caches.
+ *
+ * Every benchmark creates n distinct objects and reports the memory usage of the pool as counters:
+ * the number of live objects, the bytes per object (including the overhead of the pool), the total and peak bytes as well as the id fragmentation.
+ * Running the benchmarks for increasing n yields the growth curve of the pool.
+ * The timings measure the creation of the objects.
+ */
+
+using namespace benchmark_generators;
+
+static void report(benchmark::State& state, const carl::MemoryUsage& usage) {
+	state.counters["objects"] = static_cast<double>(usage.objects);
+	state.counters["bytes_per_object"] = usage.bytes_per_object();
+	state.counters["total_bytes"] = static_cast<double>(usage.total_bytes());
+	state.counters["peak_bytes"] = static_cast<double>(usage.peak_bytes);
+	state.counters["id_fragmentation"] = usage.id_fragmentation();
+}
+
+static std::vector<carl::Variable> bool_variables(std::size_t n) {
+	static std::vector<carl::Variable> vars;
+	while (vars.size() < n) {
+		vars.push_back(carl::fresh_boolean_variable("bm" + std::to_string(vars.size())));
+	}
+	return std::vector<carl::Variable>(vars.begin(), vars.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+/// The i'th monomial in x^a * y^b, enumerated along the diagonals.
+static carl::Monomial::Arg monomial(std::size_t i, carl::Variable x, carl::Variable y) {
+	std::size_t d = 1;
+	while (i >= d + 1) {
+		i -= d + 1;
+		++d;
+	}
+	if (i == 0) return carl::createMonomial(y, d);
+	if (i == d) return carl::createMonomial(x, d);
+	return carl::createMonomial(x, d - i) * carl::createMonomial(y, i);
+}
+
+static void PoolMemory_Monomial(benchmark::State& state) {
+	auto vars = variables(2);
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		std::vector<carl::Monomial::Arg> monomials;
+		monomials.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) monomials.push_back(monomial(i, vars[0], vars[1]));
+		state.PauseTiming();
+		usage = carl::MonomialPool::getInstance().memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_Monomial)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+/// Frees every other monomial and reports how many ids are wasted afterwards.
+static void PoolMemory_MonomialFragmentation(benchmark::State& state) {
+	auto vars = variables(2);
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		std::vector<carl::Monomial::Arg> monomials;
+		for (std::size_t i = 0; i < n; ++i) monomials.push_back(monomial(i, vars[0], vars[1]));
+		for (std::size_t i = 0; i < n; i += 2) monomials[i].reset();
+		state.PauseTiming();
+		usage = carl::MonomialPool::getInstance().memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_MonomialFragmentation)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+static void PoolMemory_Formula(benchmark::State& state) {
+	using Formula = carl::Formula<MVP>;
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	auto vars = bool_variables(n + 1);
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		std::vector<Formula> formulas;
+		formulas.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) formulas.emplace_back(carl::FormulaType::OR, Formula(vars[i]), Formula(vars[i + 1]).negated());
+		state.PauseTiming();
+		usage = carl::FormulaPool<MVP>::getInstance().memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_Formula)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+static void PoolMemory_Constraint(benchmark::State& state) {
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	auto vars = variables(2);
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		std::vector<carl::Constraint<MVP>> constraints;
+		constraints.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) constraints.emplace_back(MVP(vars[0]) * vars[1] - MVP(Rational(static_cast<long>(i))), carl::Relation::LEQ);
+		state.PauseTiming();
+		usage = carl::ConstraintPool<MVP>::getInstance().memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_Constraint)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+/// Bitvector terms are never removed from their pool, hence the pool only grows over all iterations and runs.
+static void PoolMemory_BVTerm(benchmark::State& state) {
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < n; ++i) benchmark::DoNotOptimize(carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(32, static_cast<unsigned>(i))));
+		state.PauseTiming();
+		usage = carl::BVTermPool::getInstance().memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_BVTerm)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 12)->Iterations(1);
+
+static void PoolMemory_FactorizationCache(benchmark::State& state) {
+	using FPol = carl::FactorizedPolynomial<MVP>;
+	using CachePol = carl::Cache<carl::PolynomialFactorizationPair<MVP>>;
+	std::size_t n = static_cast<std::size_t>(state.range(0));
+	auto vars = variables(2);
+	carl::MemoryUsage usage;
+	for (auto _ : state) {
+		auto cache = std::make_shared<CachePol>();
+		std::vector<FPol> polys;
+		polys.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) polys.emplace_back(MVP(vars[0]) * vars[1] + MVP(Rational(static_cast<long>(i + 1))), cache);
+		state.PauseTiming();
+		usage = cache->memory_usage();
+		state.ResumeTiming();
+	}
+	report(state, usage);
+}
+BENCHMARK(PoolMemory_FactorizationCache)->ArgName("n")->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
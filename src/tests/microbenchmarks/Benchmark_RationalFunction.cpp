@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-extpolys/DeferredRationalFunction.h>
+#include <carl-extpolys/RationalFunction.h>
+
+using namespace benchmark_generators;
+
+/*
+ * The benchmarks in this file mimic the state elimination of a parametric Markov chain:
+ * a chain of the given length is folded with the rational functions p/(p+q) and q/(q+1).
+ */
+
+static void RationalFunction_Chain(benchmark::State& state) {
+	using RF = carl::RationalFunction<MVP, true>;
+	auto vars = variables(2);
+	MVP p(vars[0]);
+	MVP q(vars[1]);
+	RF stay(p, p + q);
+	RF leave(q, q + Rational(1));
+	for (auto _ : state) {
+		RF res(Rational(1));
+		for (std::int64_t i = 0; i < state.range(0); ++i) {
+			res = res * stay + leave;
+		}
+		benchmark::DoNotOptimize(res);
+	}
+}
+BENCHMARK(RationalFunction_Chain)->ArgName("length")->Arg(4)->Arg(8);
+
+static void DeferredRationalFunction_Chain(benchmark::State& state) {
+	using RF = carl::DeferredRationalFunction<MVP>;
+	auto vars = variables(2);
+	MVP p(vars[0]);
+	MVP q(vars[1]);
+	auto pool = std::make_shared<carl::FactorPool<MVP>>();
+	RF stay(p, p + q, pool);
+	RF leave(q, q + Rational(1), pool);
+	for (auto _ : state) {
+		RF res(Rational(1));
+		for (std::int64_t i = 0; i < state.range(0); ++i) {
+			res = res * stay + leave;
+		}
+		res.simplify();
+		benchmark::DoNotOptimize(res);
+	}
+}
+BENCHMARK(DeferredRationalFunction_Chain)->ArgName("length")->Arg(4)->Arg(8);
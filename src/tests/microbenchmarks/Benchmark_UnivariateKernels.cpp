@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include "Generators.h"
+
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/Resultant.h>
+#include <carl-arith/poly/umvpoly/functions/SturmSequence.h>
+#include <carl-arith/poly/umvpoly/functions/to_univariate_polynomial.h>
+#include <carl-arith/ran/ran.h>
+
+using namespace benchmark_generators;
+
+static void UP_Resultant(benchmark::State& state) {
+	Generator g;
+	auto vars = variables(state.range(1) + 1);
+	auto p = carl::to_univariate_polynomial(g.polynomial(state.range(0), state.range(1) + 1, state.range(2)), vars.front());
+	auto q = carl::to_univariate_polynomial(g.polynomial(state.range(0), state.range(1) + 1, state.range(2)), vars.front());
+	// Random polynomials may not contain the main variable.
+	while (carl::is_constant(p)) {
+		p = carl::to_univariate_polynomial(g.polynomial(state.range(0), state.range(1) + 1, state.range(2)), vars.front());
+	}
+	while (carl::is_constant(q)) {
+		q = carl::to_univariate_polynomial(g.polynomial(state.range(0), state.range(1) + 1, state.range(2)), vars.front());
+	}
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::resultant(p, q));
+	}
+}
+BENCHMARK(UP_Resultant)->ArgNames({"degree", "params", "bits"})->ArgsProduct({{2, 4, 6}, {0, 1, 2}, {8, 64}});
+
+static void UP_SturmSequence(benchmark::State& state) {
+	Generator g;
+	auto p = g.univariate(state.range(0), state.range(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::sturm_sequence(p));
+	}
+}
+BENCHMARK(UP_SturmSequence)->ArgNames({"degree", "bits"})->ArgsProduct({{4, 8, 16}, {8, 64}});
+
+static void UP_RootIsolation(benchmark::State& state) {
+	Generator g;
+	auto p = g.with_roots(state.range(0), state.range(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::real_roots(p));
+	}
+}
+BENCHMARK(UP_RootIsolation)->ArgNames({"degree", "bits"})->ArgsProduct({{2, 4, 8, 16}, {8, 64}});
+
+static void UP_RootIsolationRandom(benchmark::State& state) {
+	Generator g;
+	auto p = g.univariate(state.range(0), state.range(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::real_roots(p));
+	}
+}
+BENCHMARK(UP_RootIsolationRandom)->ArgNames({"degree", "bits"})->ArgsProduct({{4, 8, 16}, {8, 64}});
+
+static void MVP_IntervalEvaluation(benchmark::State& state) {
+	Generator g;
+	auto p = g.polynomial(state.range(0), state.range(1), state.range(2));
+	std::map<carl::Variable, carl::Interval<Rational>> map;
+	for (auto v: variables(state.range(1))) {
+		auto lower = g.rational(state.range(2));
+		map.emplace(v, carl::Interval<Rational>(lower, lower + Rational(1)));
+	}
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(carl::evaluate(p, map));
+	}
+}
+BENCHMARK(MVP_IntervalEvaluation)->ArgNames({"degree", "vars", "bits"})->ArgsProduct({{2, 4, 8}, {1, 3, 6}, {8, 64}});
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/numbers/numbers.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+
+#include <random>
+#include <vector>
+
+/**
+ * Deterministic generators for the inputs of the microbenchmarks.
+ *
+ * All generators take the shape of the input as parameters: the degree, the number of variables and the size of the coefficients in bits.
+ * The same parameters always yield the same input, such that results of different runs are comparable.
+ */
+namespace benchmark_generators {
+
+using Rational = mpq_class;
+using Integer = mpz_class;
+using MVP = carl::MultivariatePolynomial<Rational>;
+using UP = carl::UnivariatePolynomial<Rational>;
+
+/// Returns the first n benchmark variables. The variables are created once and reused for all benchmarks.
+inline std::vector<carl::Variable> variables(std::size_t n) {
+	static std::vector<carl::Variable> vars;
+	while (vars.size() < n) {
+		vars.push_back(carl::fresh_real_variable("bx" + std::to_string(vars.size())));
+	}
+	return std::vector<carl::Variable>(vars.begin(), vars.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+class Generator {
+	std::mt19937_64 mRNG;
+public:
+	explicit Generator(std::size_t seed = 0): mRNG(seed) {}
+
+	/// A random nonzero integer with (at most) the given number of bits.
+	Integer integer(std::size_t bits) {
+		Integer res = 0;
+		std::uniform_int_distribution<unsigned> bit(0, 1);
+		for (std::size_t i = 0; i < bits; ++i) {
+			res = res * 2 + bit(mRNG);
+		}
+		if (res == 0) res = 1;
+		return bit(mRNG) ? res : Integer(-res);
+	}
+	Rational rational(std::size_t bits) {
+		return Rational(integer(bits));
+	}
+
+	/// A random monomial over the given variables with the given total degree.
+	carl::Monomial::Arg monomial(const std::vector<carl::Variable>& vars, std::size_t degree) {
+		carl::Monomial::Content content;
+		std::vector<std::size_t> exponents(vars.size(), 0);
+		std::uniform_int_distribution<std::size_t> var(0, vars.size() - 1);
+		for (std::size_t i = 0; i < degree; ++i) {
+			++exponents[var(mRNG)];
+		}
+		for (std::size_t i = 0; i < vars.size(); ++i) {
+			if (exponents[i] > 0) content.emplace_back(vars[i], exponents[i]);
+		}
+		if (content.empty()) return nullptr;
+		return carl::createMonomial(std::move(content), degree);
+	}
+
+	/**
+	 * A random polynomial with the given total degree in the given number of variables.
+	 * It has 2*degree+1 terms of random degrees and a term of full degree.
+	 */
+	MVP polynomial(std::size_t degree, std::size_t vars, std::size_t bits) {
+		auto vs = variables(vars);
+		std::uniform_int_distribution<std::size_t> deg(0, degree);
+		MVP res(carl::Term<Rational>(rational(bits), monomial(vs, degree)));
+		for (std::size_t i = 0; i < 2 * degree; ++i) {
+			res += carl::Term<Rational>(rational(bits), monomial(vs, deg(mRNG)));
+		}
+		return res;
+	}
+
+	/// A dense random univariate polynomial of the given degree.
+	UP univariate(std::size_t degree, std::size_t bits) {
+		std::vector<Rational> coeffs;
+		for (std::size_t i = 0; i <= degree; ++i) {
+			coeffs.push_back(rational(bits));
+		}
+		return UP(variables(1).front(), coeffs);
+	}
+
+	/// A univariate polynomial with the given number of distinct integral roots of the given size.
+	UP with_roots(std::size_t degree, std::size_t bits) {
+		carl::Variable x = variables(1).front();
+		UP res(x, Rational(1));
+		Rational root = rational(bits);
+		for (std::size_t i = 0; i < degree; ++i) {
+			res *= UP(x, {-root, Rational(1)});
+			root += Rational(1 + i);
+		}
+		return res;
+	}
+};
+
+}
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Compares two result files of the microbenchmarks as written by
+    runMicroBenchmarks --benchmark_out=<file> --benchmark_out_format=json
+
+Prints the relative change of every benchmark that is present in both files and
+exits with a nonzero status if any benchmark got slower than the threshold.
+Benchmarks whose runtime is below the noise floor in the baseline are reported
+but never flagged, as their measurements are dominated by noise.
+
+Timings are only comparable on the same machine, hence the comparison is refused
+(exit status 2) if the files were recorded on different hosts, unless
+--allow-different-host is given.
+
+Usage: compare.py [--threshold 0.1] [--min-time 100] baseline.json current.json
+"""
+
+import argparse
+import json
+import os
+import sys
+
+UNITS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+# Entries of the benchmark context that identify the machine.
+HOST_KEYS = ["host_name", "num_cpus", "mhz_per_cpu", "caches"]
+
+
+def load(filename, metric):
+    """Returns the host description and a dict mapping benchmark names to their time in nanoseconds."""
+    with open(filename) as f:
+        data = json.load(f)
+    context = data.get("context", {})
+    host = {key: context.get(key) for key in HOST_KEYS}
+    res = {}
+    for b in data["benchmarks"]:
+        if b.get("run_type", "iteration") != "iteration" or b.get("error_occurred"):
+            continue
+        res[b["name"]] = b[metric] * UNITS[b.get("time_unit", "ns")]
+    return host, res
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.1, help="relative slowdown that is considered a regression (default: 0.1)")
+    parser.add_argument("--min-time", type=float, default=100, help="noise floor in nanoseconds (default: 100)")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time")
+    parser.add_argument("--allow-different-host", action="store_true", help="compare files recorded on different hosts")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print(f"{args.baseline} does not exist, record a baseline on this host first (target microbenchmarks-baseline).")
+        return 2
+    baseline_host, baseline = load(args.baseline, args.metric)
+    current_host, current = load(args.current, args.metric)
+    if baseline_host != current_host:
+        for key in HOST_KEYS:
+            if baseline_host[key] != current_host[key]:
+                print(f"{key} differs: {baseline_host[key]} in {args.baseline}, {current_host[key]} in {args.current}")
+        if not args.allow_different_host:
+            print("The results were recorded on different hosts, record a baseline on this host first (target microbenchmarks-baseline).")
+            return 2
+
+    regressions = []
+    width = max((len(n) for n in baseline), default=0)
+    for name in sorted(set(baseline) & set(current)):
+        old, new = baseline[name], current[name]
+        change = (new - old) / old if old > 0 else 0
+        flag = ""
+        if change > args.threshold and old >= args.min_time:
+            flag = "REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "improved"
+        print(f"{name:<{width}} {old:>14.0f} ns {new:>14.0f} ns {change:>+8.1%} {flag}")
+
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name:<{width}} missing in {args.current}")
+    for name in sorted(set(current) - set(baseline)):
+        print(f"{name:<{width}} not in baseline")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:.0%}:")
+        for name in regressions:
+            print(f"  {name}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())